@@ -1957,6 +1957,98 @@ void G_TimeDemo (char* name)
 	::g->gameaction = ga_playdemo; 
 } 
 
+//
+// doomDemoBenchmark
+// Plays a demo lump straight through G_Ticker and R_RenderPlayerView,
+//  bypassing the platform video layer, and reports think and
+//  refresh phase times along with a checksum of every frame.
+//
+CONSOLE_COMMAND( doomDemoBenchmark, "plays a classic DOOM demo headless, timing think and refresh phases and checksumming the frames [demo] [maxtics] [verbose]", 0 ) {
+	static char			demoname[9];
+	rendertimings_t		timings;
+	idList<unsigned int>	checksums;
+	uint64				start;
+	uint64				thinkTime = 0;
+	uint64				thinkMax = 0;
+	uint64				frameTime = 0;
+	uint64				frameMax = 0;
+	uint64				elapsed;
+	uint64				ticTime;
+	int					maxtics;
+	int					tics = 0;
+	bool				verbose;
+
+	if ( ::g == NULL || ( common->GetCurrentGame() != DOOM_CLASSIC && common->GetCurrentGame() != DOOM2_CLASSIC ) ) {
+		I_Printf( "doomDemoBenchmark: classic DOOM is not running\n" );
+		return;
+	}
+
+	idStr::Copynz( demoname, args.Argc() > 1 ? args.Argv( 1 ) : "demo1", sizeof( demoname ) );
+	if ( W_CheckNumForName( demoname ) == -1 ) {
+		I_Printf( "doomDemoBenchmark: no demo lump %s\n", demoname );
+		return;
+	}
+	maxtics = args.Argc() > 2 ? atoi( args.Argv( 2 ) ) : 0;
+	verbose = args.Argc() > 3 && idStr::Icmp( args.Argv( 3 ), "verbose" ) == 0;
+
+	memset( &timings, 0, sizeof( timings ) );
+
+	G_DeferedPlayDemo( demoname );
+
+	for ( ;; ) {
+		// D_Display normally owns the wipe, there is none here.
+		::g->wipe = false;
+
+		start = Sys_Microseconds();
+		G_Ticker();
+		::g->gametic++;
+		ticTime = Sys_Microseconds() - start;
+		thinkTime += ticTime;
+		thinkMax = Max( thinkMax, ticTime );
+
+		if ( !::g->demoplayback ) {
+			break;
+		}
+		tics++;
+
+		if ( ::g->gamestate == GS_LEVEL && ::g->players[::g->displayplayer].mo != NULL ) {
+			if ( ::g->setsizeneeded ) {
+				R_ExecuteSetViewSize();
+			}
+
+			r_timings = &timings;
+			start = Sys_Microseconds();
+			R_RenderPlayerView( &::g->players[::g->displayplayer] );
+			elapsed = Sys_Microseconds() - start;
+			r_timings = NULL;
+
+			frameTime += elapsed;
+			frameMax = Max( frameMax, elapsed );
+
+			checksums.Append( MD5_BlockChecksum( ::g->screens[0], SCREENWIDTH * SCREENHEIGHT ) );
+			if ( verbose ) {
+				I_Printf( "tic %5i: think %6i usec, refresh %6i usec, checksum %08x\n", tics, (int)ticTime, (int)elapsed, checksums[checksums.Num() - 1] );
+			}
+		}
+
+		if ( maxtics > 0 && tics >= maxtics ) {
+			G_CheckDemoStatus();
+			break;
+		}
+	}
+
+	const int frames = Max( checksums.Num(), 1 );
+	I_Printf( "doomDemoBenchmark: %s, %i tics, %i frames\n", demoname, tics, checksums.Num() );
+	I_Printf( "  think   : %8.1f msec total, %6i usec/tic, %6i usec max\n", thinkTime / 1000.0f, (int)( thinkTime / Max( tics, 1 ) ), (int)thinkMax );
+	I_Printf( "  refresh : %8.1f msec total, %6i usec/frame, %6i usec max\n", frameTime / 1000.0f, (int)( frameTime / frames ), (int)frameMax );
+	I_Printf( "    setup : %6i usec/frame\n", (int)( timings.setup / frames ) );
+	I_Printf( "    bsp   : %6i usec/frame\n", (int)( timings.bsp / frames ) );
+	I_Printf( "    planes: %6i usec/frame\n", (int)( timings.planes / frames ) );
+	I_Printf( "    masked: %6i usec/frame\n", (int)( timings.masked / frames ) );
+	I_Printf( "    strips: %6i usec/frame\n", (int)( timings.flush / frames ) );
+	I_Printf( "  checksum: %08x\n", checksums.Num() ? MD5_BlockChecksum( checksums.Ptr(), checksums.Num() * sizeof( unsigned int ) ) : 0 );
+}
+
 
 /* 
 =================== 
@@ -323,11 +323,16 @@ R_GetColumn
     ofs = ::g->s_texturecolumnofs[tex][col];
     
     if (lump > 0)
-	return (byte *)W_CacheLumpNum(lump,PU_CACHE_SHARED)+ofs;
+    {
+	byte* data = (byte *)W_CacheLumpNum(lump,PU_CACHE_SHARED);
+	R_PinDrawSource (data);
+	return data+ofs;
+    }
 
     if (!::g->s_texturecomposite[tex])
 	R_GenerateComposite (tex);
 
+    R_PinDrawSource (::g->s_texturecomposite[tex]);
     return ::g->s_texturecomposite[tex] + ofs;
 }
 
@@ -52,7 +52,7 @@ If you have questions concerning this license or the applicable additional terms
 #define SIL_TOP			2
 #define SIL_BOTH		3
 
-#define MAXDRAWSEGS		1280
+#define MAXDRAWSEGS		4096
 
 
 
@@ -657,6 +657,375 @@ void R_DrawSpanLow ( fixed_t xfrac,
 	} while (count--); 
 }
 
+
+//
+// Deferred drawing.
+// With r_doomStripJobs set, the refresh records every column
+//  and span instead of writing the frame buffer, and
+//  R_FlushDeferredDrawing rasterizes the list in vertical
+//  strips over the job threads. The BSP walk and all the
+//  clipping stay serial, so each strip replays the commands
+//  in their original order and the result is identical to
+//  drawing them directly.
+// The textures, patches and flats the commands read from are
+//  purgable zone blocks, R_PinDrawSource keeps them static
+//  until the flush so later cache misses can't reuse them.
+//
+idCVar r_doomStripJobs( "r_doomStripJobs", "0", CVAR_INTEGER, "number of vertical strips the classic DOOM view is rasterized in over the job threads, 0 draws directly", 0, MAX_DRAW_STRIPS );
+
+typedef enum
+{
+	DC_COLUMN,
+	DC_FUZZCOLUMN,
+	DC_TRANSCOLUMN,
+	DC_SPAN
+} drawcmdtype_t;
+
+typedef struct
+{
+	int				type;
+	int				x1;			// dc_x, or ds_x1 for spans
+	int				x2;			// ds_x2 for spans
+	int				y1;			// dc_yl, or ds_y for spans
+	int				y2;			// dc_yh
+	fixed_t			xfrac;		// frac at dc_yl for columns
+	fixed_t			xstep;		// dc_iscale for columns
+	fixed_t			yfrac;
+	fixed_t			ystep;
+	int				fuzzpos;
+	lighttable_t*	colormap;
+	byte*			source;
+	byte*			translation;
+} drawcmd_t;
+
+typedef struct
+{
+	const drawcmd_t*	cmds;
+	int					numcmds;
+	int					x1;			// first column of the strip
+	int					x2;			// one past the last column
+	byte**				ylookup;
+	int*				columnofs;
+	lighttable_t*		colormaps;
+	int*				fuzzoffset;
+} drawstripparms_t;
+
+typedef struct
+{
+	void*			block;
+	int				tag;		// tag to restore after the flush
+} pinnedsource_t;
+
+static drawcmd_t*		drawcmds;
+static int				numdrawcmds;
+static int				maxdrawcmds;
+
+static qboolean			deferring;
+static pinnedsource_t*	pinnedsources;
+static int				numpinnedsources;
+static int				maxpinnedsources;
+
+static idParallelJobList*	stripJobs;
+
+static void (*savedcolfunc) ( lighttable_t * dc_colormap, byte * dc_source );
+static void (*savedbasecolfunc) ( lighttable_t * dc_colormap, byte * dc_source );
+static void (*savedfuzzcolfunc) ( lighttable_t * dc_colormap, byte * dc_source );
+static void (*savedtranscolfunc) ( lighttable_t * dc_colormap, byte * dc_source );
+static void (*savedspanfunc) ( fixed_t xfrac, fixed_t yfrac, fixed_t ds_y, int ds_x1, int ds_x2,
+							   fixed_t ds_xstep, fixed_t ds_ystep, lighttable_t * ds_colormap, byte * ds_source );
+
+static drawcmd_t* R_AllocDrawCmd( void )
+{
+	if ( numdrawcmds == maxdrawcmds )
+	{
+		maxdrawcmds = maxdrawcmds ? maxdrawcmds * 2 : 16384;
+		drawcmds = (drawcmd_t*)realloc( drawcmds, maxdrawcmds * sizeof( *drawcmds ) );
+		if ( !drawcmds )
+			I_Error( "R_AllocDrawCmd: couldn't grow to %i commands", maxdrawcmds );
+	}
+	return &drawcmds[numdrawcmds++];
+}
+
+static void R_RecordColumnCmd( int type, lighttable_t * dc_colormap, byte * dc_source )
+{
+	drawcmd_t*	cmd;
+
+	if ( ::g->dc_yh < ::g->dc_yl )
+		return;
+
+	cmd = R_AllocDrawCmd();
+	cmd->type = type;
+	cmd->x1 = ::g->dc_x;
+	cmd->y1 = ::g->dc_yl;
+	cmd->y2 = ::g->dc_yh;
+	cmd->xstep = ::g->dc_iscale;
+	cmd->xfrac = ::g->dc_texturemid + (::g->dc_yl-::g->centery)*::g->dc_iscale;
+	cmd->colormap = dc_colormap;
+	cmd->source = dc_source;
+	cmd->translation = ::g->dc_translation;
+	cmd->fuzzpos = ::g->fuzzpos;
+}
+
+void R_RecordColumn ( lighttable_t * dc_colormap,
+					  byte * dc_source )
+{
+	R_RecordColumnCmd( DC_COLUMN, dc_colormap, dc_source );
+}
+
+void R_RecordFuzzColumn ( lighttable_t * dc_colormap,
+						  byte * dc_source )
+{
+	// Same border adjustment as R_DrawFuzzColumn.
+	if (!::g->dc_yl) 
+		::g->dc_yl = 1;
+	if (::g->dc_yh == ::g->viewheight-1) 
+		::g->dc_yh = ::g->viewheight - 2; 
+
+	if ( ::g->dc_yh < ::g->dc_yl )
+		return;
+
+	R_RecordColumnCmd( DC_FUZZCOLUMN, dc_colormap, dc_source );
+
+	// Advance the fuzz table exactly as drawing would have,
+	//  so the next column starts from the same position.
+	::g->fuzzpos = (::g->fuzzpos + ::g->dc_yh - ::g->dc_yl + 1) % FUZZTABLE;
+}
+
+void R_RecordTranslatedColumn ( lighttable_t * dc_colormap,
+								byte * dc_source )
+{
+	R_RecordColumnCmd( DC_TRANSCOLUMN, dc_colormap, dc_source );
+}
+
+void R_RecordSpan ( fixed_t xfrac,
+					fixed_t yfrac,
+					fixed_t ds_y,
+					int ds_x1,
+					int ds_x2,
+					fixed_t ds_xstep,
+					fixed_t ds_ystep,
+					lighttable_t * ds_colormap,
+					byte * ds_source )
+{
+	drawcmd_t*	cmd;
+
+	if ( ds_x2 < ds_x1 )
+		return;
+
+	cmd = R_AllocDrawCmd();
+	cmd->type = DC_SPAN;
+	cmd->x1 = ds_x1;
+	cmd->x2 = ds_x2;
+	cmd->y1 = ds_y;
+	cmd->xfrac = xfrac;
+	cmd->yfrac = yfrac;
+	cmd->xstep = ds_xstep;
+	cmd->ystep = ds_ystep;
+	cmd->colormap = ds_colormap;
+	cmd->source = ds_source;
+}
+
+//
+// R_DrawStripJob
+// Replays the recorded commands, clipped to one vertical strip.
+// The inner loops match R_DrawColumn, R_DrawFuzzColumn,
+//  R_DrawTranslatedColumn and R_DrawSpan.
+//
+static void R_DrawStripJob( drawstripparms_t * parms )
+{
+	const drawcmd_t*	cmd;
+	const drawcmd_t*	end;
+	byte*		dest;
+	int			count;
+	int			spot;
+	int			x1;
+	int			x2;
+	fixed_t		frac;
+	fixed_t		yfrac;
+	int			fuzzpos;
+
+	end = parms->cmds + parms->numcmds;
+	for ( cmd = parms->cmds ; cmd < end ; cmd++ )
+	{
+		if ( cmd->type == DC_SPAN )
+		{
+			x1 = cmd->x1 > parms->x1 ? cmd->x1 : parms->x1;
+			x2 = cmd->x2 < parms->x2 - 1 ? cmd->x2 : parms->x2 - 1;
+			if ( x1 > x2 )
+				continue;
+
+			// Step in unsigned so skipping ahead wraps the same
+			//  way as the accumulated additions do.
+			frac = (fixed_t)( (unsigned)cmd->xfrac + (unsigned)( x1 - cmd->x1 ) * (unsigned)cmd->xstep );
+			yfrac = (fixed_t)( (unsigned)cmd->yfrac + (unsigned)( x1 - cmd->x1 ) * (unsigned)cmd->ystep );
+
+			dest = parms->ylookup[cmd->y1] + parms->columnofs[x1];
+			count = x2 - x1;
+			do 
+			{
+				spot = ((yfrac>>(16-6))&(63*64)) + ((frac>>16)&63);
+				*dest++ = cmd->colormap[cmd->source[spot]];
+				frac += cmd->xstep; 
+				yfrac += cmd->ystep;
+			} while (count--); 
+			continue;
+		}
+
+		if ( cmd->x1 < parms->x1 || cmd->x1 >= parms->x2 )
+			continue;
+
+		dest = parms->ylookup[cmd->y1] + parms->columnofs[cmd->x1];
+		frac = cmd->xfrac;
+		count = cmd->y2 - cmd->y1;
+
+		switch ( cmd->type )
+		{
+		case DC_COLUMN:
+			do 
+			{
+				*dest = cmd->colormap[cmd->source[(frac >> FRACBITS) & 127]];
+				frac += cmd->xstep;
+				dest += SCREENWIDTH; 
+			} while (count--);
+			break;
+
+		case DC_FUZZCOLUMN:
+			// Fuzz only reads the pixels above and below,
+			//  which are always in the same strip.
+			fuzzpos = cmd->fuzzpos;
+			do 
+			{
+				*dest = parms->colormaps[6*256+dest[parms->fuzzoffset[fuzzpos]]]; 
+				if (++fuzzpos == FUZZTABLE) 
+					fuzzpos = 0;
+				dest += SCREENWIDTH;
+			} while (count--); 
+			break;
+
+		case DC_TRANSCOLUMN:
+			do 
+			{
+				*dest = cmd->colormap[cmd->translation[cmd->source[frac>>FRACBITS]]];
+				frac += cmd->xstep; 
+				dest += SCREENWIDTH;
+			} while (count--); 
+			break;
+		}
+	}
+}
+REGISTER_PARALLEL_JOB( R_DrawStripJob, "R_DrawStripJob" );
+
+//
+// R_PinDrawSource
+// Called with the zone block a column, patch or flat is
+//  read from. While drawing is deferred the block is made
+//  static until R_FlushDeferredDrawing has replayed it.
+//
+void R_PinDrawSource (void* block)
+{
+	memblock_t*		mb;
+	pinnedsource_t*	pin;
+
+	if ( !deferring )
+		return;
+
+	mb = (memblock_t *) ( (byte *)block - sizeof(memblock_t));
+	if ( mb->tag < PU_PURGELEVEL )
+		return;
+
+	if ( numpinnedsources == maxpinnedsources )
+	{
+		maxpinnedsources = maxpinnedsources ? maxpinnedsources * 2 : 256;
+		pinnedsources = (pinnedsource_t*)realloc( pinnedsources, maxpinnedsources * sizeof( *pinnedsources ) );
+		if ( !pinnedsources )
+			I_Error( "R_PinDrawSource: couldn't grow to %i blocks", maxpinnedsources );
+	}
+	pin = &pinnedsources[numpinnedsources++];
+	pin->block = block;
+	pin->tag = mb->tag;
+	Z_ChangeTag2( &block, PU_STATIC );
+}
+
+//
+// R_BeginDeferredDrawing
+// Points the drawing functions at the recorders.
+// Low detail mode always draws directly.
+//
+qboolean R_BeginDeferredDrawing (void)
+{
+	if ( r_doomStripJobs.GetInteger() <= 0 || ::g->detailshift )
+		return false;
+
+	savedcolfunc = colfunc;
+	savedbasecolfunc = basecolfunc;
+	savedfuzzcolfunc = fuzzcolfunc;
+	savedtranscolfunc = transcolfunc;
+	savedspanfunc = spanfunc;
+
+	colfunc = basecolfunc = R_RecordColumn;
+	fuzzcolfunc = R_RecordFuzzColumn;
+	transcolfunc = R_RecordTranslatedColumn;
+	spanfunc = R_RecordSpan;
+
+	numdrawcmds = 0;
+	numpinnedsources = 0;
+	deferring = true;
+	return true;
+}
+
+//
+// R_FlushDeferredDrawing
+// Rasterizes the recorded commands and restores
+//  the drawing functions.
+//
+void R_FlushDeferredDrawing (void)
+{
+	drawstripparms_t	parms[MAX_DRAW_STRIPS];
+	int					numstrips;
+	int					i;
+
+	colfunc = savedcolfunc;
+	basecolfunc = savedbasecolfunc;
+	fuzzcolfunc = savedfuzzcolfunc;
+	transcolfunc = savedtranscolfunc;
+	spanfunc = savedspanfunc;
+	deferring = false;
+
+	numstrips = r_doomStripJobs.GetInteger();
+	if ( numstrips > MAX_DRAW_STRIPS )
+		numstrips = MAX_DRAW_STRIPS;
+	if ( numstrips > ::g->viewwidth )
+		numstrips = ::g->viewwidth;
+	if ( numstrips < 1 )
+		numstrips = 1;
+
+	if ( !stripJobs )
+		stripJobs = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, MAX_DRAW_STRIPS, 0, NULL );
+
+	for ( i = 0 ; i < numstrips ; i++ )
+	{
+		parms[i].cmds = drawcmds;
+		parms[i].numcmds = numdrawcmds;
+		parms[i].x1 = ::g->viewwidth * i / numstrips;
+		parms[i].x2 = ::g->viewwidth * (i+1) / numstrips;
+		parms[i].ylookup = ::g->ylookup;
+		parms[i].columnofs = ::g->columnofs;
+		parms[i].colormaps = ::g->colormaps;
+		parms[i].fuzzoffset = ::g->fuzzoffset;
+		stripJobs->AddJob( (jobRun_t)R_DrawStripJob, &parms[i] );
+	}
+
+	stripJobs->Submit();
+	stripJobs->Wait();
+
+	numdrawcmds = 0;
+
+	// the sources may be purged again
+	for ( i = 0 ; i < numpinnedsources ; i++ )
+		Z_ChangeTag2( &pinnedsources[i].block, pinnedsources[i].tag );
+	numpinnedsources = 0;
+}
+
 //
 // R_InitBuffer 
 // Creats lookup tables that avoid
@@ -129,6 +129,15 @@ void	R_InitTranslationTables (void);
 
 
 
+// Deferred drawing, rasterized in vertical strips
+//  over the job threads.
+#define MAX_DRAW_STRIPS		16
+
+qboolean R_BeginDeferredDrawing (void);
+void	R_FlushDeferredDrawing (void);
+void	R_PinDrawSource (void* block);
+
+
 // Rendering function.
 void R_FillBackScreen (void);
 
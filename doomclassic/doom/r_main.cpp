@@ -858,17 +858,41 @@ void R_SetupFrame (player_t* player)
 
 
 
+//
+// R_TimePhase
+// Adds the time since start to a phase, returns the new start.
+//
+rendertimings_t*	r_timings;
+
+static uint64 R_TimePhase (uint64* phase, uint64 start)
+{
+	uint64	now;
+
+	now = Sys_Microseconds();
+	*phase += now - start;
+	return now;
+}
+
 //
 // R_RenderView
 //
 void R_RenderPlayerView (player_t* player)
 {
+	qboolean	deferred;
+	uint64		start = 0;
+
 	if ( player->mo == NULL ) {
 		return;
 	}
 
+	if ( r_timings ) {
+		start = Sys_Microseconds();
+	}
+
 	R_SetupFrame (player);
 
+	deferred = R_BeginDeferredDrawing ();
+
 	// Clear buffers.
 	R_ClearClipSegs ();
 	R_ClearDrawSegs ();
@@ -878,19 +902,43 @@ void R_RenderPlayerView (player_t* player)
 	// check for new console commands.
 	NetUpdate ( NULL );
 
+	if ( r_timings ) {
+		start = R_TimePhase( &r_timings->setup, start );
+	}
+
 	// The head node is the last node output.
 	R_RenderBSPNode (::g->numnodes-1);
 
 	// Check for new console commands.
 	NetUpdate ( NULL );
 
+	if ( r_timings ) {
+		start = R_TimePhase( &r_timings->bsp, start );
+	}
+
 	R_DrawPlanes ();
 
 	// Check for new console commands.
 	NetUpdate ( NULL );
 
+	if ( r_timings ) {
+		start = R_TimePhase( &r_timings->planes, start );
+	}
+
 	R_DrawMasked ();
 
+	if ( r_timings ) {
+		start = R_TimePhase( &r_timings->masked, start );
+	}
+
+	if ( deferred ) {
+		R_FlushDeferredDrawing ();
+
+		if ( r_timings ) {
+			start = R_TimePhase( &r_timings->flush, start );
+		}
+	}
+
 	// Check for new console commands.
 	NetUpdate ( NULL );				
 }
@@ -109,6 +109,8 @@ extern void		(*basecolfunc) ( lighttable_t * ds_colormap,
 						byte * ds_source );
 extern void		(*fuzzcolfunc) ( lighttable_t * ds_colormap,
 						byte * ds_source );
+extern void		(*transcolfunc) ( lighttable_t * ds_colormap,
+						byte * ds_source );
 // No shadow effects on floors.
 extern void		(*spanfunc) (
 	fixed_t xfrac,
@@ -176,6 +178,19 @@ R_AddPointToBox
 // Called by G_Drawer.
 void R_RenderPlayerView (player_t *player);
 
+// Accumulated refresh phase times in microseconds,
+//  filled in by R_RenderPlayerView while r_timings is set.
+typedef struct
+{
+	uint64	setup;
+	uint64	bsp;
+	uint64	planes;
+	uint64	masked;
+	uint64	flush;
+} rendertimings_t;
+
+extern rendertimings_t*	r_timings;
+
 // Called by startup code.
 void R_Init (void);
 
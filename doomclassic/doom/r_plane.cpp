@@ -408,6 +408,7 @@ void R_DrawPlanes (void)
 	::g->ds_source = (byte*)W_CacheLumpNum(::g->firstflat +
 				   ::g->flattranslation[pl->picnum],
 				   PU_CACHE_SHARED);
+	R_PinDrawSource (::g->ds_source);
 	
 	::g->planeheight = abs(pl->height-::g->viewz);
 	light = (pl->lightlevel >> LIGHTSEGSHIFT)+::g->extralight;
@@ -381,6 +381,7 @@ R_DrawVisSprite
 	
 	
     patch = (patch_t*)W_CacheLumpNum (vis->patch+::g->firstspritelump, PU_CACHE_SHARED);
+    R_PinDrawSource (patch);
 
     ::g->dc_colormap = vis->colormap;
     
@@ -391,7 +392,7 @@ R_DrawVisSprite
     }
     else if (vis->mobjflags & MF_TRANSLATION)
     {
-	colfunc = R_DrawTranslatedColumn;
+	colfunc = transcolfunc;
 	::g->dc_translation = ::g->translationtables - 256 +
 	    ( (vis->mobjflags & MF_TRANSLATION) >> (MF_TRANSSHIFT-8) );
     }
@@ -34,7 +34,7 @@ If you have questions concerning this license or the applicable additional terms
 #pragma interface
 #endif
 
-#define MAXVISSPRITES  	128
+#define MAXVISSPRITES  	1024
 
 extern vissprite_t	vissprites[MAXVISSPRITES];
 extern vissprite_t*	vissprite_p;
@@ -59,8 +59,67 @@ lumpinfo_t*	lumpinfo = NULL;
 int			numlumps;
 void**		lumpcache;
 
+//
+// Hashed lump directory.
+// Every chain is kept in descending lump order, so the first
+//  match is the last loaded lump, same as the backwards scan.
+//
+#define LUMPHASHSIZE	4096
+
+static int	lumphashfirst[LUMPHASHSIZE];
+static int*	lumphashnext = NULL;
+static int	lumphashcount = 0;		// lumps linked into the hash
 
 
+
+//
+// W_LumpNameHash
+//
+static int W_LumpNameHash (int v1, int v2)
+{
+	unsigned int h = (unsigned int)v1 * 0x9E3779B1u ^ (unsigned int)v2 * 0x85EBCA77u;
+	h ^= h >> 15;
+	return h & (LUMPHASHSIZE-1);
+}
+
+//
+// W_HashLumps
+// Links the lumps added since the last call into the hash.
+//
+static void W_HashLumps (void)
+{
+	int		i;
+	int		h;
+
+	if (lumphashcount == 0)
+	{
+		for (i=0 ; i<LUMPHASHSIZE ; i++)
+			lumphashfirst[i] = -1;
+	}
+
+	lumphashnext = (int*)realloc( lumphashnext, numlumps*sizeof(int) );
+	if (!lumphashnext)
+		I_Error ("Couldn't realloc lump hash");
+
+	for (i=lumphashcount ; i<numlumps ; i++)
+	{
+		h = W_LumpNameHash( *(int *)lumpinfo[i].name, *(int *)&lumpinfo[i].name[4] );
+		lumphashnext[i] = lumphashfirst[h];
+		lumphashfirst[h] = i;
+	}
+	lumphashcount = numlumps;
+}
+
+//
+// W_FreeLumpHash
+//
+static void W_FreeLumpHash (void)
+{
+	free( lumphashnext );
+	lumphashnext = NULL;
+	lumphashcount = 0;
+}
+
 int filelength (FILE* handle) 
 { 
 	// DHM - not used :: development tool (loading single lump not in a WAD file)
@@ -198,6 +257,8 @@ void W_AddFile ( const char *filename)
 		lump_p->size = LONG(filelumpPointer->size);
 		strncpy (lump_p->name, filelumpPointer->name, 8);
 	}
+
+	W_HashLumps ();
 }
 
 
@@ -234,6 +295,8 @@ void W_FreeLumps() {
 		lumpinfo = NULL;
 		numlumps = 0;
 	}
+
+	W_FreeLumpHash ();
 }
 
 //
@@ -279,6 +342,8 @@ void W_InitMultipleFiles (const char** filenames)
 		// will be realloced as lumps are added
 		lumpinfo = NULL;
 
+		int startTime = Sys_Milliseconds();
+
 		for ( ; *filenames ; filenames++)
 		{
 			W_AddFile (*filenames);
@@ -287,6 +352,8 @@ void W_InitMultipleFiles (const char** filenames)
 		if (!numlumps)
 			I_Error ("W_InitMultipleFiles: no files found");
 
+		I_Printf (" %d lumps in %d msec\n", numlumps, Sys_Milliseconds() - startTime);
+
 		// set up caching
 		size = numlumps * sizeof(*lumpcache);
 		lumpcache = (void**)DoomLib::Z_Malloc(size, PU_STATIC_SHARED, 0 );
@@ -336,11 +403,10 @@ int W_NumLumps (void)
 
 
 //
-// W_CheckNumForName
-// Returns -1 if name not found.
+// W_LumpName8
+// Makes the name into two integers for easy compares.
 //
-
-int W_CheckNumForName (const char* name)
+static void W_LumpName8 (const char* name, int* v1, int* v2)
 {
 	const int NameLength = 9;
 
@@ -349,12 +415,7 @@ int W_CheckNumForName (const char* name)
 		int	x[2];
 	
     } name8;
-    
-    int		v1;
-    int		v2;
-    lumpinfo_t*	lump_p;
 
-    // make the name into two integers for easy compares
     strncpy (name8.s,name, NameLength - 1);
 
     // in case the name was a fill 8 chars
@@ -365,9 +426,21 @@ int W_CheckNumForName (const char* name)
 		name8.s[i] = toupper( name8.s[i] );		
 	}
 
-    v1 = name8.x[0];
-    v2 = name8.x[1];
+    *v1 = name8.x[0];
+    *v2 = name8.x[1];
+}
 
+//
+// W_CheckNumForNameLinear
+// The original backwards scan, kept to verify the hash.
+//
+static int W_CheckNumForNameLinear (const char* name)
+{
+    int		v1;
+    int		v2;
+    lumpinfo_t*	lump_p;
+
+    W_LumpName8 (name, &v1, &v2);
 
     // scan backwards so patch lump files take precedence
     lump_p = lumpinfo + numlumps;
@@ -385,6 +458,89 @@ int W_CheckNumForName (const char* name)
     return -1;
 }
 
+//
+// W_CheckNumForName
+// Returns -1 if name not found.
+//
+int W_CheckNumForName (const char* name)
+{
+    int		v1;
+    int		v2;
+    int		i;
+
+    if (lumphashcount != numlumps)
+		return W_CheckNumForNameLinear (name);
+
+    W_LumpName8 (name, &v1, &v2);
+
+    // the chains are in descending order so patch lump files take precedence
+    for (i = lumphashfirst[W_LumpNameHash (v1, v2)] ; i != -1 ; i = lumphashnext[i])
+    {
+		if ( *(int *)lumpinfo[i].name == v1
+			&& *(int *)&lumpinfo[i].name[4] == v2)
+		{
+			return i;
+		}
+    }
+
+    // TFB. Not found.
+    return -1;
+}
+
+//
+// doomWadBenchmark
+// Times looking up every lump name through the hash and the linear scan.
+//
+CONSOLE_COMMAND( doomWadBenchmark, "times classic DOOM lump lookups through the hash against a linear scan", 0 ) {
+	if ( ::g == NULL || lumpinfo == NULL || numlumps == 0 ) {
+		idLib::Printf( "usage: doomWadBenchmark [iterations], classic DOOM must be running with its wad files loaded\n" );
+		return;
+	}
+
+	int iterations = ( args.Argc() > 1 ) ? atoi( args.Argv( 1 ) ) : 10;
+	if ( iterations < 1 ) {
+		iterations = 1;
+	}
+
+	idList< idStrStatic< 16 > > names;
+	names.SetNum( numlumps );
+	for ( int i = 0; i < numlumps; i++ ) {
+		char name[9];
+		memcpy( name, lumpinfo[i].name, 8 );
+		name[8] = 0;
+		names[i] = name;
+	}
+
+	int mismatches = 0;
+	for ( int i = 0; i < numlumps; i++ ) {
+		if ( W_CheckNumForName( names[i] ) != W_CheckNumForNameLinear( names[i] ) ) {
+			mismatches++;
+		}
+	}
+
+	int found = 0;
+	uint64 start = Sys_Microseconds();
+	for ( int j = 0; j < iterations; j++ ) {
+		for ( int i = 0; i < numlumps; i++ ) {
+			found += ( W_CheckNumForName( names[i] ) != -1 );
+		}
+	}
+	const uint64 hashTime = Sys_Microseconds() - start;
+
+	start = Sys_Microseconds();
+	for ( int j = 0; j < iterations; j++ ) {
+		for ( int i = 0; i < numlumps; i++ ) {
+			found += ( W_CheckNumForNameLinear( names[i] ) != -1 );
+		}
+	}
+	const uint64 linearTime = Sys_Microseconds() - start;
+
+	const int numLookups = numlumps * iterations;
+	idLib::Printf( "%d lumps in %d files, %d lookups, %d mismatches\n", numlumps, ::g->numWadFiles, numLookups, mismatches );
+	idLib::Printf( "hash:   %5d usec (%.3f usec per lookup)\n", (int)hashTime, (float)hashTime / numLookups );
+	idLib::Printf( "linear: %5d usec (%.3f usec per lookup)\n", (int)linearTime, (float)linearTime / numLookups );
+}
+
 
 
 
@@ -123,6 +123,10 @@ public:
 	virtual void			Rotation( trace_t *results, const idVec3 &start, const idRotation &rotation,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
 								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) = 0;
+	// Translates a batch of points and reports the first collision of each. The traces walk the
+	// model together and large batches are distributed over the job threads.
+	virtual void			TracePoints( trace_t *results, const idVec3 *starts, const idVec3 *ends, const int numTraces, int contentMask,
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) = 0;
 	// Returns the contents touched by the trace model or 0 if the trace model is in free space.
 	virtual int				Contents( const idVec3 &start,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
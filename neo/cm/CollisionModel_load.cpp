@@ -174,9 +174,21 @@ Free map
 ===============================================================================
 */
 
+/*
+================
+idCollisionModelManagerLocal::idCollisionModelManagerLocal
+================
+*/
+idCollisionModelManagerLocal::idCollisionModelManagerLocal() {
+	traceJobList = NULL;
+	Clear();
+}
+
 /*
 ================
 idCollisionModelManagerLocal::Clear
+
+FreeMap releases the trace job list before the state is cleared.
 ================
 */
 void idCollisionModelManagerLocal::Clear() {
@@ -196,6 +208,7 @@ void idCollisionModelManagerLocal::Clear() {
 	contacts = NULL;
 	maxContacts = 0;
 	numContacts = 0;
+	traceJobList = NULL;
 }
 
 /*
@@ -411,6 +424,11 @@ idCollisionModelManagerLocal::FreeMap
 void idCollisionModelManagerLocal::FreeMap() {
 	int i;
 
+	if ( traceJobList != NULL ) {
+		parallelJobManager->FreeJobList( traceJobList );
+		traceJobList = NULL;
+	}
+
 	if ( !loaded ) {
 		Clear();
 		return;
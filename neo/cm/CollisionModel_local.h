@@ -299,6 +299,8 @@ typedef struct cm_procNode_s {
 
 class idCollisionModelManagerLocal : public idCollisionModelManager {
 public:
+					idCollisionModelManagerLocal();
+
 	// load collision models from a map file
 	void			LoadMap( const idMapFile *mapFile );
 	// frees all the collision models
@@ -337,6 +339,9 @@ public:
 	int				Contents( const idVec3 &start,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
 								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis );
+	// translates a batch of points and reports the first collision of each
+	void			TracePoints( trace_t *results, const idVec3 *starts, const idVec3 *ends, const int numTraces, int contentMask,
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis );
 	// stores all contact points of the trm with the model, returns the number of contacts
 	int				Contacts( contactInfo_t *contacts, const int maxContacts, const idVec3 &start, const idVec6 &dir, const float depth,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
@@ -533,6 +538,8 @@ private:			// collision map data
 	contactInfo_t *	contacts;
 	int				maxContacts;
 	int				numContacts;
+					// for distributing batched traces over the job threads
+	idParallelJobList *	traceJobList;
 };
 
 // for debugging
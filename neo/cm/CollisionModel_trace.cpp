@@ -255,3 +255,294 @@ void idCollisionModelManagerLocal::TraceThroughModel( cm_traceWork_t *tw ) {
 		idCollisionModelManagerLocal::TraceThroughAxialBSPTree_r( tw, tw->model->node, 0, 1, start, tw->end );
 	}
 }
+
+/*
+===============================================================================
+
+Batched point traces
+
+All traces in a batch walk the axial BSP tree together, so the nodes shared
+by the traces are only visited once. The traces only read the collision
+model, which allows a batch to be split over the job threads.
+
+===============================================================================
+*/
+
+idCVar cm_parallelTracePoints( "cm_parallelTracePoints", "1", CVAR_GAME | CVAR_BOOL, "distribute batched point traces over the job threads" );
+
+#define CM_MAX_TRACE_PACKET			64		// number of traces that walk the tree together
+#define CM_MIN_TRACES_PER_JOB		64
+#define CM_MAX_TRACE_JOBS			32
+
+float CM_TranslationPlaneFraction( const idPlane &plane, const idVec3 &start, const idVec3 &end );
+
+typedef struct cm_pointTrace_s {
+	idVec3					start;				// start in model space
+	idVec3					end;				// end in model space
+	idVec3					dir;
+	idBounds				bounds;				// trace bounds, decreased when something is hit
+	idPluecker				pl;					// pluecker coordinate for the trace ray
+	trace_t					trace;
+} cm_pointTrace_t;
+
+typedef struct cm_pointTraceParms_s {
+	const cm_model_t *		model;
+	int						contentMask;
+	cm_pointTrace_t *		traces;
+	int						numTraces;
+} cm_pointTraceParms_t;
+
+/*
+================
+CM_TracePointThroughPolygon
+
+  same as TranslatePointThroughPolygon but without writing to the collision model
+================
+*/
+static void CM_TracePointThroughPolygon( const cm_model_t *model, cm_pointTrace_t &pt, const cm_polygon_t *poly ) {
+
+	// if the the trace bounds do not intersect the polygon bounds
+	if ( !pt.bounds.IntersectsBounds( poly->bounds ) ) {
+		return;
+	}
+
+	// only collide with the polygon if approaching at the front
+	if ( ( poly->plane.Normal() * pt.dir ) > 0.0f ) {
+		return;
+	}
+
+	float f = CM_TranslationPlaneFraction( poly->plane, pt.start, pt.end );
+	if ( f >= pt.trace.fraction ) {
+		return;
+	}
+
+	for ( int i = 0; i < poly->numEdges; i++ ) {
+		const int edgeNum = poly->edges[i];
+		const cm_edge_t *edge = model->edges + abs( edgeNum );
+		idPluecker pl;
+		pl.FromLine( model->vertices[edge->vertexNum[0]].p, model->vertices[edge->vertexNum[1]].p );
+		const int side = ( pt.pl.PermutedInnerProduct( pl ) < 0.0f );
+		// if the point passes the edge at the wrong side
+		if ( INT32_SIGNBITSET( edgeNum ) ^ side ) {
+			return;
+		}
+	}
+	if ( f < 0.0f ) {
+		f = 0.0f;
+	}
+	pt.trace.fraction = f;
+	// collision plane is the polygon plane
+	pt.trace.c.normal = poly->plane.Normal();
+	pt.trace.c.dist = poly->plane.Dist();
+	pt.trace.c.contents = poly->contents;
+	pt.trace.c.material = poly->material;
+	pt.trace.c.type = CONTACT_TRMVERTEX;
+	pt.trace.c.modelFeature = *reinterpret_cast<const int *>(&poly);
+	pt.trace.c.trmFeature = 0;
+	pt.trace.c.point = pt.start + f * pt.dir;
+
+	// decrease bounds
+	const idVec3 endp = pt.trace.c.point;
+	for ( int i = 0; i < 3; i++ ) {
+		if ( pt.start[i] < endp[i] ) {
+			pt.bounds[0][i] = pt.start[i] - CM_BOX_EPSILON;
+			pt.bounds[1][i] = endp[i] + CM_BOX_EPSILON;
+		} else {
+			pt.bounds[0][i] = endp[i] - CM_BOX_EPSILON;
+			pt.bounds[1][i] = pt.start[i] + CM_BOX_EPSILON;
+		}
+	}
+}
+
+/*
+================
+CM_TracePointsThroughAxialBSPTree_r
+
+  the traces only move on into the children they touch up to their current fraction
+================
+*/
+static void CM_TracePointsThroughAxialBSPTree_r( const cm_model_t *model, const cm_node_t *node, int contentMask,
+												cm_pointTrace_t *traces, const int *indices, const int numIndices ) {
+	int front[CM_MAX_TRACE_PACKET];
+	int back[CM_MAX_TRACE_PACKET];
+	int numFront, numBack;
+
+	if ( !node ) {
+		return;
+	}
+
+	// trace through the polygons in this node
+	for ( const cm_polygonRef_t *pref = node->polygons; pref; pref = pref->next ) {
+		const cm_polygon_t *p = pref->p;
+		if ( !( p->contents & contentMask ) ) {
+			continue;
+		}
+		for ( int i = 0; i < numIndices; i++ ) {
+			CM_TracePointThroughPolygon( model, traces[indices[i]], p );
+		}
+	}
+
+	// if this is a leaf node
+	if ( node->planeType == -1 ) {
+		return;
+	}
+
+	numFront = numBack = 0;
+	for ( int i = 0; i < numIndices; i++ ) {
+		const cm_pointTrace_t &pt = traces[indices[i]];
+		if ( pt.trace.fraction == 0.0f ) {
+			continue;
+		}
+		const float t1 = pt.start[node->planeType] - node->planeDist;
+		const float t2 = pt.start[node->planeType] + pt.trace.fraction * pt.dir[node->planeType] - node->planeDist;
+		if ( t1 >= -CM_BOX_EPSILON || t2 >= -CM_BOX_EPSILON ) {
+			front[numFront++] = indices[i];
+		}
+		if ( t1 < CM_BOX_EPSILON || t2 < CM_BOX_EPSILON ) {
+			back[numBack++] = indices[i];
+		}
+	}
+
+	if ( numFront > 0 ) {
+		CM_TracePointsThroughAxialBSPTree_r( model, node->children[0], contentMask, traces, front, numFront );
+	}
+	if ( numBack > 0 ) {
+		CM_TracePointsThroughAxialBSPTree_r( model, node->children[1], contentMask, traces, back, numBack );
+	}
+}
+
+/*
+================
+CM_TracePointsJob
+================
+*/
+static void CM_TracePointsJob( const cm_pointTraceParms_t *parms ) {
+	int indices[CM_MAX_TRACE_PACKET];
+
+	for ( int first = 0; first < parms->numTraces; first += CM_MAX_TRACE_PACKET ) {
+		const int num = Min( parms->numTraces - first, CM_MAX_TRACE_PACKET );
+		for ( int i = 0; i < num; i++ ) {
+			indices[i] = first + i;
+		}
+		CM_TracePointsThroughAxialBSPTree_r( parms->model, parms->model->node, parms->contentMask, parms->traces, indices, num );
+	}
+}
+
+REGISTER_PARALLEL_JOB( CM_TracePointsJob, "CM_TracePointsJob" );
+
+/*
+================
+idCollisionModelManagerLocal::TracePoints
+================
+*/
+void idCollisionModelManagerLocal::TracePoints( trace_t *results, const idVec3 *starts, const idVec3 *ends, const int numTraces, int contentMask,
+												cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) {
+	if ( numTraces <= 0 ) {
+		return;
+	}
+
+	if ( model < 0 || model > MAX_SUBMODELS || model > idCollisionModelManagerLocal::maxModels ) {
+		common->Printf( "idCollisionModelManagerLocal::TracePoints: invalid model handle\n" );
+		memset( results, 0, numTraces * sizeof( results[0] ) );
+		return;
+	}
+	if ( !idCollisionModelManagerLocal::models[model] ) {
+		common->Printf( "idCollisionModelManagerLocal::TracePoints: invalid model\n" );
+		memset( results, 0, numTraces * sizeof( results[0] ) );
+		return;
+	}
+
+	const bool model_rotated = modelAxis.IsRotated();
+	const idMat3 invModelAxis = modelAxis.Transpose();
+
+	cm_pointTrace_t *traces = (cm_pointTrace_t *)Mem_Alloc( numTraces * sizeof( cm_pointTrace_t ), TAG_COLLISION );
+	int *traceNums = (int *)Mem_Alloc( numTraces * sizeof( int ), TAG_COLLISION );
+	int numPointTraces = 0;
+
+	// position tests are handled by the regular path
+	for ( int i = 0; i < numTraces; i++ ) {
+		if ( starts[i] == ends[i] ) {
+			idCollisionModelManagerLocal::Translation( &results[i], starts[i], ends[i], NULL, mat3_identity, contentMask, model, modelOrigin, modelAxis );
+			continue;
+		}
+
+		cm_pointTrace_t &pt = traces[numPointTraces];
+		traceNums[numPointTraces++] = i;
+
+		pt.start = starts[i] - modelOrigin;
+		pt.end = ends[i] - modelOrigin;
+		if ( model_rotated ) {
+			// rotate trace instead of model
+			pt.start *= invModelAxis;
+			pt.end *= invModelAxis;
+		}
+		pt.dir = pt.end - pt.start;
+		for ( int j = 0; j < 3; j++ ) {
+			if ( pt.start[j] < pt.end[j] ) {
+				pt.bounds[0][j] = pt.start[j] - CM_BOX_EPSILON;
+				pt.bounds[1][j] = pt.end[j] + CM_BOX_EPSILON;
+			} else {
+				pt.bounds[0][j] = pt.end[j] - CM_BOX_EPSILON;
+				pt.bounds[1][j] = pt.start[j] + CM_BOX_EPSILON;
+			}
+		}
+		pt.pl.FromRay( pt.start, pt.dir );
+		memset( &pt.trace, 0, sizeof( pt.trace ) );
+		pt.trace.fraction = 1.0f;
+		pt.trace.c.type = CONTACT_NONE;
+	}
+
+	if ( numPointTraces > 0 ) {
+		const cm_model_t *cmodel = idCollisionModelManagerLocal::models[model];
+		// the job list is shared, only the main thread spreads traces over the job threads
+		const int numJobs = ( cm_parallelTracePoints.GetBool() && idLib::IsMainThread() ) ? Min( numPointTraces / CM_MIN_TRACES_PER_JOB, CM_MAX_TRACE_JOBS ) : 0;
+
+		if ( numJobs > 1 ) {
+			if ( traceJobList == NULL ) {
+				traceJobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, CM_MAX_TRACE_JOBS, 0, NULL );
+			}
+			cm_pointTraceParms_t parms[CM_MAX_TRACE_JOBS];
+			const int tracesPerJob = ( numPointTraces + numJobs - 1 ) / numJobs;
+			for ( int i = 0; i < numJobs; i++ ) {
+				const int first = i * tracesPerJob;
+				parms[i].model = cmodel;
+				parms[i].contentMask = contentMask;
+				parms[i].traces = traces + first;
+				parms[i].numTraces = Min( tracesPerJob, numPointTraces - first );
+				traceJobList->AddJob( (jobRun_t)CM_TracePointsJob, &parms[i] );
+			}
+			traceJobList->Submit();
+			traceJobList->Wait();
+		} else {
+			cm_pointTraceParms_t parms;
+			parms.model = cmodel;
+			parms.contentMask = contentMask;
+			parms.traces = traces;
+			parms.numTraces = numPointTraces;
+			CM_TracePointsJob( &parms );
+		}
+	}
+
+	// store results
+	for ( int i = 0; i < numPointTraces; i++ ) {
+		const int traceNum = traceNums[i];
+		trace_t &result = results[traceNum];
+
+		result = traces[i].trace;
+		result.endpos = starts[traceNum] + result.fraction * ( ends[traceNum] - starts[traceNum] );
+		result.endAxis = mat3_identity;
+
+		if ( result.fraction < 1.0f ) {
+			// rotate trace plane normal if there was a collision with a rotated model
+			if ( model_rotated ) {
+				result.c.normal *= modelAxis;
+				result.c.point *= modelAxis;
+			}
+			result.c.point += modelOrigin;
+			result.c.dist += modelOrigin * result.c.normal;
+		}
+	}
+
+	Mem_Free( traceNums );
+	Mem_Free( traces );
+}
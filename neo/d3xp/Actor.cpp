@@ -2113,8 +2113,8 @@ void idActor::SyncAnimChannels( int channel, int syncToChannel, int blendFrames
 					cycle = animator.CurrentAnim( syncToChannel )->GetCycleCount();
 					starttime = animator.CurrentAnim( syncToChannel )->GetStartTime();
 					headAnimator->PlayAnim( ANIMCHANNEL_ALL, anim, gameLocal.time, blendTime );
-					headAnimator->CurrentAnim( ANIMCHANNEL_ALL )->SetCycleCount( cycle );
-					headAnimator->CurrentAnim( ANIMCHANNEL_ALL )->SetStartTime( starttime );
+					headAnimator->SetCycleCount( ANIMCHANNEL_ALL, cycle );
+					headAnimator->SetStartTime( ANIMCHANNEL_ALL, starttime );
 				} else {
 					headEnt->PlayIdleAnim( blendTime );
 				}
@@ -2134,8 +2134,8 @@ void idActor::SyncAnimChannels( int channel, int syncToChannel, int blendFrames
 					cycle = headAnimator->CurrentAnim( ANIMCHANNEL_ALL )->GetCycleCount();
 					starttime = headAnimator->CurrentAnim( ANIMCHANNEL_ALL )->GetStartTime();
 					animator.PlayAnim( channel, anim, gameLocal.time, blendTime );
-					animator.CurrentAnim( channel )->SetCycleCount( cycle );
-					animator.CurrentAnim( channel )->SetStartTime( starttime );
+					animator.SetCycleCount( channel, cycle );
+					animator.SetStartTime( channel, starttime );
 				}
 			}
 		}
@@ -2981,34 +2981,34 @@ void idActor::Event_SetSyncedAnimWeight( int channel, int anim, float weight ) {
 	switch( channel ) {
 	case ANIMCHANNEL_HEAD :
 		if ( headEnt ) {
-			animator.CurrentAnim( ANIMCHANNEL_ALL )->SetSyncedAnimWeight( anim, weight );
+			animator.SetSyncedAnimWeight( ANIMCHANNEL_ALL, anim, weight );
 		} else {
-			animator.CurrentAnim( ANIMCHANNEL_HEAD )->SetSyncedAnimWeight( anim, weight );
+			animator.SetSyncedAnimWeight( ANIMCHANNEL_HEAD, anim, weight );
 		}
 		if ( torsoAnim.IsIdle() ) {
-			animator.CurrentAnim( ANIMCHANNEL_TORSO )->SetSyncedAnimWeight( anim, weight );
+			animator.SetSyncedAnimWeight( ANIMCHANNEL_TORSO, anim, weight );
 			if ( legsAnim.IsIdle() ) {
-				animator.CurrentAnim( ANIMCHANNEL_LEGS )->SetSyncedAnimWeight( anim, weight );
+				animator.SetSyncedAnimWeight( ANIMCHANNEL_LEGS, anim, weight );
 			}
 		}
 		break;
 
 	case ANIMCHANNEL_TORSO :
-		animator.CurrentAnim( ANIMCHANNEL_TORSO )->SetSyncedAnimWeight( anim, weight );
+		animator.SetSyncedAnimWeight( ANIMCHANNEL_TORSO, anim, weight );
 		if ( legsAnim.IsIdle() ) {
-			animator.CurrentAnim( ANIMCHANNEL_LEGS )->SetSyncedAnimWeight( anim, weight );
+			animator.SetSyncedAnimWeight( ANIMCHANNEL_LEGS, anim, weight );
 		}
 		if ( headEnt && headAnim.IsIdle() ) {
-			animator.CurrentAnim( ANIMCHANNEL_ALL )->SetSyncedAnimWeight( anim, weight );
+			animator.SetSyncedAnimWeight( ANIMCHANNEL_ALL, anim, weight );
 		}
 		break;
 
 	case ANIMCHANNEL_LEGS :
-		animator.CurrentAnim( ANIMCHANNEL_LEGS )->SetSyncedAnimWeight( anim, weight );
+		animator.SetSyncedAnimWeight( ANIMCHANNEL_LEGS, anim, weight );
 		if ( torsoAnim.IsIdle() ) {
-			animator.CurrentAnim( ANIMCHANNEL_TORSO )->SetSyncedAnimWeight( anim, weight );
+			animator.SetSyncedAnimWeight( ANIMCHANNEL_TORSO, anim, weight );
 			if ( headEnt && headAnim.IsIdle() ) {
-				animator.CurrentAnim( ANIMCHANNEL_ALL )->SetSyncedAnimWeight( anim, weight );
+				animator.SetSyncedAnimWeight( ANIMCHANNEL_ALL, anim, weight );
 			}
 		}
 		break;
@@ -3141,72 +3141,44 @@ explosions and melee attacks.
 ============
 */
 bool idEntity::CanDamage( const idVec3 &origin, idVec3 &damagePoint ) const {
-	idVec3 	dest;
-	trace_t	tr;
-	idVec3 	midpoint;
+	// this should probably check in the plane of projection, rather than in world coordinate
+	static const idVec3 offsets[] = {
+		idVec3(  15.0f,  15.0f,   0.0f ),
+		idVec3(  15.0f, -15.0f,   0.0f ),
+		idVec3( -15.0f,  15.0f,   0.0f ),
+		idVec3( -15.0f, -15.0f,   0.0f ),
+		idVec3(   0.0f,   0.0f,  15.0f ),
+		idVec3(   0.0f,   0.0f, -15.0f )
+	};
+	static const int numOffsets = sizeof( offsets ) / sizeof( offsets[0] );
+	clipTrace_t traces[numOffsets];
+	trace_t		results[numOffsets];
+	trace_t		tr;
+	idVec3 		midpoint;
 
 	// use the midpoint of the bounds instead of the origin, because
 	// bmodels may have their origin at 0,0,0
 	midpoint = ( GetPhysics()->GetAbsBounds()[0] + GetPhysics()->GetAbsBounds()[1] ) * 0.5;
 
-	dest = midpoint;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
-	}
-
-	// this should probably check in the plane of projection, rather than in world coordinate
-	dest = midpoint;
-	dest[0] += 15.0;
-	dest[1] += 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
-	}
-
-	dest = midpoint;
-	dest[0] += 15.0;
-	dest[1] -= 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
-	}
-
-	dest = midpoint;
-	dest[0] -= 15.0;
-	dest[1] += 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
+	gameLocal.clip.TracePoint( tr, origin, midpoint, MASK_SOLID, NULL );
 	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
 		damagePoint = tr.endpos;
 		return true;
 	}
 
-	dest = midpoint;
-	dest[0] -= 15.0;
-	dest[1] -= 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
+	// trace to the points around the midpoint all at once
+	for ( int i = 0; i < numOffsets; i++ ) {
+		traces[i].start = origin;
+		traces[i].end = midpoint + offsets[i];
+		traces[i].bounds.Clear();
 	}
+	gameLocal.clip.TraceBatch( results, traces, numOffsets, MASK_SOLID, NULL );
 
-	dest = midpoint;
-	dest[2] += 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
-	}
-
-	dest = midpoint;
-	dest[2] -= 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
+	for ( int i = 0; i < numOffsets; i++ ) {
+		if ( results[i].fraction == 1.0 || ( gameLocal.GetTraceEntity( results[i] ) == this ) ) {
+			damagePoint = results[i].endpos;
+			return true;
+		}
 	}
 
 	return false;
@@ -340,6 +340,9 @@ void idGameLocal::Init() {
 	
 	smokeParticles = new (TAG_PARTICLE) idSmokeParticles;
 
+	animatorFrames.Init();
+	afIslands.Init();
+
 	// set up the aas
 	dict = FindEntityDefDict( "aas_types" );
 	if ( dict == NULL ) {
@@ -398,6 +401,9 @@ void idGameLocal::Shutdown() {
 	delete smokeParticles;
 	smokeParticles = NULL;
 
+	animatorFrames.Shutdown();
+	afIslands.Shutdown();
+
 	idClass::Shutdown();
 
 	// clear list with forces
@@ -2229,6 +2235,92 @@ void idGameLocal::RunTimeGroup2( idUserCmdMgr & userCmdMgr ) {
 	SelectTimeGroup( false );
 }
 
+/*
+================
+idGameLocal::CreateAnimatorFrames
+
+Most animated entities query their joints while thinking and all visible ones get
+their frame created by the render callback, so do that work up front on the job threads.
+================
+*/
+void idGameLocal::CreateAnimatorFrames() {
+	if ( !g_parallelAnimators.GetBool() || g_debugAnim.GetInteger() != -1 ) {
+		// the debug output isn't thread safe
+		return;
+	}
+
+	animatorFrames.Begin( time );
+	for ( idEntity * ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
+		if ( ent->timeGroup != TIME_GROUP1 || ent->IsHidden() ) {
+			continue;
+		}
+		if ( inCinematic && g_cinematic.GetBool() && !ent->cinematic ) {
+			continue;
+		}
+		if ( !InPlayerPVS( ent ) ) {
+			continue;
+		}
+		animatorFrames.AddAnimator( ent->GetAnimator() );
+	}
+	animatorFrames.CreateFrames();
+
+	if ( g_showAnimatorFrames.GetBool() ) {
+		Printf( "%d: %d animator frames in %d usec\n", time, animatorFrames.NumFrames(), animatorFrames.Microseconds() );
+	}
+}
+
+/*
+================
+idGameLocal::EvaluateAFIslands
+
+Ragdolls and other articulated figures are the most expensive physics objects, the
+constraints of each one are solved independently on the job threads and the results
+are picked up when the entity runs its physics during think.
+
+The figures are integrated before anything thinks, so forces, impulses, velocities
+and vehicle controls set during think, and pushers that moved first, only affect the
+figure the next frame. That's why this is off by default.
+================
+*/
+void idGameLocal::EvaluateAFIslands() {
+	if ( !af_parallelIslands.GetBool() || af_showTimings.GetBool() || common->IsClient() ) {
+		// the timings are shared by all figures
+		return;
+	}
+
+	afIslands.Begin( time - previousTime, time );
+	for ( idEntity * ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
+		if ( ent->timeGroup != TIME_GROUP1 || ent->entityNumber < MAX_PLAYERS ) {
+			continue;
+		}
+		if ( inCinematic && g_cinematic.GetBool() && !ent->cinematic ) {
+			continue;
+		}
+		if ( !( ent->thinkFlags & TH_PHYSICS ) || ent->fl.isDormant ) {
+			continue;
+		}
+		// bound figures are moved along with their master
+		if ( ent->GetBindMaster() != NULL || ( ent->GetTeamMaster() != NULL && ent->GetTeamMaster() != ent ) ) {
+			continue;
+		}
+		// RunPhysics saves the master state to revert it when a slave is blocked,
+		// that only works if the master hasn't moved yet
+		if ( ent->GetNextTeamEntity() != NULL ) {
+			continue;
+		}
+		idPhysics *physics = ent->GetPhysics();
+		if ( !physics->IsType( idPhysics_AF::Type ) || physics->IsAtRest() ) {
+			continue;
+		}
+		afIslands.AddEntity( ent );
+	}
+	afIslands.Evaluate();
+
+	if ( af_showIslands.GetBool() ) {
+		Printf( "%d: %d articulated figure islands in %d usec\n", time, afIslands.NumIslands(), afIslands.Microseconds() );
+	}
+}
+
 /*
 ================
 idGameLocal::RunEntityThink
@@ -2350,6 +2442,12 @@ void idGameLocal::RunFrame( idUserCmdMgr & cmdMgr, gameReturn_t & ret ) {
 		// sort the active entity list
 		SortActiveEntityList();
 
+		// create the animation frames of the entities the players can see
+		CreateAnimatorFrames();
+
+		// solve the articulated figures before they think
+		EvaluateAFIslands();
+
 		timer_think.Clear();
 		timer_think.Start();
 
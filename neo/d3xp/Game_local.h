@@ -94,6 +94,7 @@ void gameError( const char *fmt, ... );
 
 #include "physics/Clip.h"
 #include "physics/Push.h"
+#include "physics/AFIslands.h"
 
 #include "Pvs.h"
 #include "Leaderboards.h"
@@ -282,6 +283,8 @@ public:
 	idMultiplayerGame		mpGame;					// handles rules for standard dm
 
 	idSmokeParticles *		smokeParticles;			// global smoke trails
+	idAnimatorFrameBatch	animatorFrames;			// creates the animation frames over the job threads before think
+	idAFIslands				afIslands;				// solves the articulated figures over the job threads before think
 	idEditEntities *		editEntities;			// in game editing
 
 	bool					inCinematic;			// game is playing cinematic (player controls frozen)
@@ -610,6 +613,8 @@ private:
 	void					FreePlayerPVS();
 	void					UpdateGravity();
 	void					SortActiveEntityList();
+	void					CreateAnimatorFrames();
+	void					EvaluateAFIslands();
 	void					ShowTargets();
 	void					RunDebugInfo();
 
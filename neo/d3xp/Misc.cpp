@@ -1166,7 +1166,7 @@ void idAnimated::PlayNextAnim() {
 	}
 
 	animator.CycleAnim( ANIMCHANNEL_ALL, anim, gameLocal.time, FRAME2MS( blendFrames ) );
-	animator.CurrentAnim( ANIMCHANNEL_ALL )->SetCycleCount( cycle );
+	animator.SetCycleCount( ANIMCHANNEL_ALL, cycle );
 
 	len = animator.CurrentAnim( ANIMCHANNEL_ALL )->PlayLength();
 	if ( len >= 0 ) {
@@ -1276,7 +1276,7 @@ void idAnimated::Event_Start() {
 		}
 		spawnArgs.GetInt( "cycle", "1", cycle );
 		animator.CycleAnim( ANIMCHANNEL_ALL, anim, gameLocal.time, FRAME2MS( blendFrames ) );
-		animator.CurrentAnim( ANIMCHANNEL_ALL )->SetCycleCount( cycle );
+		animator.SetCycleCount( ANIMCHANNEL_ALL, cycle );
 
 		len = animator.CurrentAnim( ANIMCHANNEL_ALL )->PlayLength();
 		if ( len >= 0 ) {
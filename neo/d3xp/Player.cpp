@@ -6786,13 +6786,13 @@ void idPlayer::AdjustBodyAngles() {
 		upBlend			= -frac;
 	}
 
-    animator.CurrentAnim( ANIMCHANNEL_TORSO )->SetSyncedAnimWeight( 0, downBlend );
-	animator.CurrentAnim( ANIMCHANNEL_TORSO )->SetSyncedAnimWeight( 1, forwardBlend );
-	animator.CurrentAnim( ANIMCHANNEL_TORSO )->SetSyncedAnimWeight( 2, upBlend );
+    animator.SetSyncedAnimWeight( ANIMCHANNEL_TORSO, 0, downBlend );
+	animator.SetSyncedAnimWeight( ANIMCHANNEL_TORSO, 1, forwardBlend );
+	animator.SetSyncedAnimWeight( ANIMCHANNEL_TORSO, 2, upBlend );
 
-	animator.CurrentAnim( ANIMCHANNEL_LEGS )->SetSyncedAnimWeight( 0, downBlend );
-	animator.CurrentAnim( ANIMCHANNEL_LEGS )->SetSyncedAnimWeight( 1, forwardBlend );
-	animator.CurrentAnim( ANIMCHANNEL_LEGS )->SetSyncedAnimWeight( 2, upBlend );
+	animator.SetSyncedAnimWeight( ANIMCHANNEL_LEGS, 0, downBlend );
+	animator.SetSyncedAnimWeight( ANIMCHANNEL_LEGS, 1, forwardBlend );
+	animator.SetSyncedAnimWeight( ANIMCHANNEL_LEGS, 2, upBlend );
 }
 
 /*
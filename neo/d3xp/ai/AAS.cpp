@@ -56,6 +56,11 @@ idAASLocal::idAASLocal
 */
 idAASLocal::idAASLocal() {
 	file = NULL;
+	precomputedCache = NULL;
+	precomputedTravelTimes = NULL;
+	precomputedReachabilities = NULL;
+	precomputedMemory = 0;
+	precomputedEnabled = true;
 }
 
 /*
@@ -80,6 +80,10 @@ public:
 	virtual bool				Init( const idStr &mapName, unsigned int mapFileCRC ) = 0;
 								// Print AAS stats.
 	virtual void				Stats() const = 0;
+								// Print routing cache hit/miss stats, optionally resetting the counters.
+	virtual void				CacheStats( bool resetCounters ) const = 0;
+								// Compare lazy against precomputed route queries.
+	virtual void				RoutingBenchmark( int numQueries ) = 0;
 								// Test from the given origin.
 	virtual void				Test( const idVec3 &origin ) = 0;
 								// Get the AAS settings.
@@ -38,6 +38,8 @@ class idRoutingCache {
 
 public:
 								idRoutingCache( int size );
+								// cache stored in memory owned by someone else
+								idRoutingCache( int size, unsigned char *reachabilities, unsigned short *travelTimes );
 								~idRoutingCache();
 
 	int							Size() const;
@@ -52,9 +54,11 @@ private:
 	idRoutingCache *			prev;					// previous in list
 	idRoutingCache *			time_next;				// next in time based list
 	idRoutingCache *			time_prev;				// previous in time based list
+	int							queryNum;				// routing query that last used this cache
 	unsigned short				startTravelTime;		// travel time to start with
 	unsigned char *				reachabilities;			// reachabilities used for routing
 	unsigned short *			travelTimes;			// travel time for every area
+	bool						ownsMemory;				// false if the arrays are part of another allocation
 };
 
 
@@ -84,12 +88,16 @@ private:
 
 
 class idAASLocal : public idAAS {
+	friend void AAS_PrecomputeRoutingJob( struct aasPrecomputeRoutingParms_s *parms );
+
 public:
 								idAASLocal();
 	virtual						~idAASLocal();
 	virtual bool				Init( const idStr &mapName, unsigned int mapFileCRC );
 	virtual void				Shutdown();
 	virtual void				Stats() const;
+	virtual void				CacheStats( bool resetCounters ) const;
+	virtual void				RoutingBenchmark( int numQueries );
 	virtual void				Test( const idVec3 &origin );
 	virtual const idAASSettings *GetSettings() const;
 	virtual int					PointAreaNum( const idVec3 &origin ) const;
@@ -136,6 +144,21 @@ private:	// routing data
 	mutable idRoutingCache *	cacheListStart;			// start of list with cache sorted from oldest to newest
 	mutable idRoutingCache *	cacheListEnd;			// end of list with cache sorted from oldest to newest
 	mutable int					totalCacheMemory;		// total cache memory used
+	mutable int					peakCacheMemory;		// highest total cache memory used
+	mutable int					routingQueryNum;		// cache used by the current query is never freed
+	mutable int					areaCacheHits;			// cache statistics
+	mutable int					areaCacheMisses;
+	mutable int					portalCacheHits;
+	mutable int					portalCacheMisses;
+	mutable int					numCacheEvictions;
+	mutable int					numCacheInvalidations;
+	mutable int					precomputedCacheHits;
+	idRoutingCache **			precomputedCache;		// area cache towards every cluster portal for each precomputed travel flag combination
+	unsigned short *			precomputedTravelTimes;	// flat table with the travel times of all precomputed cache
+	unsigned char *				precomputedReachabilities;	// flat table with the reachabilities of all precomputed cache
+	int							precomputedMemory;		// size of the flat tables
+	idList<bool, TAG_AAS>		precomputedClusterValid;// cleared when the routing through a cluster changes
+	bool						precomputedEnabled;		// used to compare against lazy routing
 	idList<idRoutingObstacle *, TAG_AAS>	obstacleList;			// list with obstacles
 
 private:	// routing
@@ -152,9 +175,15 @@ private:	// routing
 	void						LinkCache( idRoutingCache *cache ) const;
 	void						UnlinkCache( idRoutingCache *cache ) const;
 	void						DeleteOldestCache() const;
+	void						FreeCacheMemory( int size ) const;
+	void						ResetCacheStats() const;
 	idReachability *			GetAreaReachability( int areaNum, int reachabilityNum ) const;
 	int							ClusterAreaNum( int clusterNum, int areaNum ) const;
-	void						UpdateAreaRoutingCache( idRoutingCache *areaCache ) const;
+	void						UpdateAreaRoutingCache( idRoutingCache *areaCache, idRoutingUpdate *update ) const;
+	void						PrecomputeRoutingTables();
+	void						FreeRoutingTables();
+	idRoutingCache *			GetPrecomputedRoutingCache( int clusterNum, int areaNum, int travelFlags ) const;
+	void						FlushRoutingCache();
 	idRoutingCache *			GetAreaRoutingCache( int clusterNum, int areaNum, int travelFlags ) const;
 	void						UpdatePortalRoutingCache( idRoutingCache *portalCache ) const;
 	idRoutingCache *			GetPortalRoutingCache( int clusterNum, int areaNum, int travelFlags ) const;
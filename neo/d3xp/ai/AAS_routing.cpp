@@ -36,10 +36,14 @@ If you have questions concerning this license or the applicable additional terms
 #define CACHETYPE_AREA				1
 #define CACHETYPE_PORTAL			2
 
-#define MAX_ROUTING_CACHE_MEMORY	(2*1024*1024)
-
 #define LEDGE_TRAVELTIME_PANALTY	250
 
+// travel flag combinations used by the AI for which the routing can be precomputed
+static const int precomputedTravelFlags[] = { TFL_WALK|TFL_AIR, TFL_WALK|TFL_AIR|TFL_FLY };
+static const int numPrecomputedTravelFlags = sizeof( precomputedTravelFlags ) / sizeof( precomputedTravelFlags[0] );
+
+#define MAX_PRECOMPUTE_ROUTING_JOBS	16
+
 /*
 ============
 idRoutingCache::idRoutingCache
@@ -53,11 +57,33 @@ idRoutingCache::idRoutingCache( int size ) {
 	travelFlags = 0;
 	startTravelTime = 0;
 	type = 0;
+	queryNum = 0;
 	this->size = size;
 	reachabilities = new (TAG_AAS) byte[size];
 	memset( reachabilities, 0, size * sizeof( reachabilities[0] ) );
 	travelTimes = new (TAG_AAS) unsigned short[size];
 	memset( travelTimes, 0, size * sizeof( travelTimes[0] ) );
+	ownsMemory = true;
+}
+
+/*
+============
+idRoutingCache::idRoutingCache
+============
+*/
+idRoutingCache::idRoutingCache( int size, unsigned char *reachabilities, unsigned short *travelTimes ) {
+	areaNum = 0;
+	cluster = 0;
+	next = prev = NULL;
+	time_next = time_prev = NULL;
+	travelFlags = 0;
+	startTravelTime = 0;
+	type = 0;
+	queryNum = 0;
+	this->size = size;
+	this->reachabilities = reachabilities;
+	this->travelTimes = travelTimes;
+	ownsMemory = false;
 }
 
 /*
@@ -66,8 +92,10 @@ idRoutingCache::~idRoutingCache
 ============
 */
 idRoutingCache::~idRoutingCache() {
-	delete [] reachabilities;
-	delete [] travelTimes;
+	if ( ownsMemory ) {
+		delete [] reachabilities;
+		delete [] travelTimes;
+	}
 }
 
 /*
@@ -213,6 +241,8 @@ void idAASLocal::SetupRoutingCache() {
 
 	cacheListStart = cacheListEnd = NULL;
 	totalCacheMemory = 0;
+	routingQueryNum = 0;
+	ResetCacheStats();
 }
 
 /*
@@ -229,6 +259,7 @@ void idAASLocal::DeleteClusterCache( int clusterNum ) {
 			areaCacheIndex[clusterNum][i] = cache->next;
 			UnlinkCache( cache );
 			delete cache;
+			numCacheInvalidations++;
 		}
 	}
 }
@@ -247,6 +278,7 @@ void idAASLocal::DeletePortalCache() {
 			portalCacheIndex[i] = cache->next;
 			UnlinkCache( cache );
 			delete cache;
+			numCacheInvalidations++;
 		}
 	}
 }
@@ -290,6 +322,9 @@ idAASLocal::SetupRouting
 bool idAASLocal::SetupRouting() {
 	CalculateAreaTravelTimes();
 	SetupRoutingCache();
+	if ( aas_precomputeRouting.GetBool() ) {
+		PrecomputeRoutingTables();
+	}
 	return true;
 }
 
@@ -299,6 +334,7 @@ idAASLocal::ShutdownRouting
 ============
 */
 void idAASLocal::ShutdownRouting() {
+	FreeRoutingTables();
 	DeleteAreaTravelTimes();
 	ShutdownRoutingCache();
 }
@@ -331,6 +367,53 @@ void idAASLocal::RoutingStats() const {
 	gameLocal.Printf( "%6d area travel times (%d KB)\n", numAreaTravelTimes, ( numAreaTravelTimes * sizeof( unsigned short ) ) >> 10 );
 	gameLocal.Printf( "%6d area cache entries (%d KB)\n", areaCacheIndexSize, ( areaCacheIndexSize * sizeof( idRoutingCache * ) ) >> 10 );
 	gameLocal.Printf( "%6d portal cache entries (%d KB)\n", portalCacheIndexSize, ( portalCacheIndexSize * sizeof( idRoutingCache * ) ) >> 10 );
+	if ( precomputedCache ) {
+		gameLocal.Printf( "%6d precomputed portal cache (%d KB)\n", numPrecomputedTravelFlags * file->GetNumPortalIndexes(), precomputedMemory >> 10 );
+	}
+}
+
+/*
+============
+idAASLocal::ResetCacheStats
+============
+*/
+void idAASLocal::ResetCacheStats() const {
+	peakCacheMemory = totalCacheMemory;
+	areaCacheHits = areaCacheMisses = 0;
+	portalCacheHits = portalCacheMisses = 0;
+	numCacheEvictions = numCacheInvalidations = 0;
+	precomputedCacheHits = 0;
+}
+
+/*
+============
+idAASLocal::CacheStats
+============
+*/
+void idAASLocal::CacheStats( bool resetCounters ) const {
+	if ( !file ) {
+		return;
+	}
+
+	const int areaLookups = areaCacheHits + areaCacheMisses;
+	const int portalLookups = portalCacheHits + portalCacheMisses;
+
+	gameLocal.Printf( "[%s]\n", file->GetName() );
+	gameLocal.Printf( "%6d KB cache budget\n", aas_routingCacheSize.GetInteger() );
+	gameLocal.Printf( "%6d KB cache used (%d KB peak)\n", totalCacheMemory >> 10, peakCacheMemory >> 10 );
+	gameLocal.Printf( "%6d area cache lookups, %d hits, %d misses (%1.1f%% hits)\n", areaLookups, areaCacheHits, areaCacheMisses,
+						areaLookups ? 100.0f * areaCacheHits / areaLookups : 0.0f );
+	gameLocal.Printf( "%6d portal cache lookups, %d hits, %d misses (%1.1f%% hits)\n", portalLookups, portalCacheHits, portalCacheMisses,
+						portalLookups ? 100.0f * portalCacheHits / portalLookups : 0.0f );
+	if ( precomputedCache ) {
+		gameLocal.Printf( "%6d area cache lookups served from the precomputed tables\n", precomputedCacheHits );
+	}
+	gameLocal.Printf( "%6d cache evicted to stay within the budget\n", numCacheEvictions );
+	gameLocal.Printf( "%6d cache invalidated by area or obstacle changes\n", numCacheInvalidations );
+
+	if ( resetCounters ) {
+		ResetCacheStats();
+	}
 }
 
 /*
@@ -345,11 +428,18 @@ void idAASLocal::RemoveRoutingCacheUsingArea( int areaNum ) {
 	if ( clusterNum > 0 ) {
 		// remove all the cache in the cluster the area is in
 		DeleteClusterCache( clusterNum );
+		if ( precomputedCache ) {
+			precomputedClusterValid[clusterNum] = false;
+		}
 	}
 	else {
 		// if this is a portal remove all cache in both the front and back cluster
 		DeleteClusterCache( file->GetPortal( -clusterNum ).clusters[0] );
 		DeleteClusterCache( file->GetPortal( -clusterNum ).clusters[1] );
+		if ( precomputedCache ) {
+			precomputedClusterValid[file->GetPortal( -clusterNum ).clusters[0]] = false;
+			precomputedClusterValid[file->GetPortal( -clusterNum ).clusters[1]] = false;
+		}
 	}
 	DeletePortalCache();
 }
@@ -603,6 +693,10 @@ void idAASLocal::LinkCache( idRoutingCache *cache ) const {
 	}
 
 	totalCacheMemory += cache->Size();
+	if ( totalCacheMemory > peakCacheMemory ) {
+		peakCacheMemory = totalCacheMemory;
+	}
+	cache->queryNum = routingQueryNum;
 
 	// add cache to the end of the list
 	cache->time_next = NULL;
@@ -668,6 +762,24 @@ void idAASLocal::DeleteOldestCache() const {
 	}
 
 	delete cache;
+
+	numCacheEvictions++;
+}
+
+/*
+============
+idAASLocal::FreeCacheMemory
+
+  frees the least recently used cache until the given number of bytes fits in the budget,
+  cache used by the current routing query is kept
+============
+*/
+void idAASLocal::FreeCacheMemory( int size ) const {
+	const int maxCacheMemory = aas_routingCacheSize.GetInteger() << 10;
+
+	while( totalCacheMemory + size > maxCacheMemory && cacheListStart && cacheListStart->queryNum != routingQueryNum ) {
+		DeleteOldestCache();
+	}
 }
 
 /*
@@ -709,7 +821,7 @@ ID_INLINE int idAASLocal::ClusterAreaNum( int clusterNum, int areaNum ) const {
 idAASLocal::UpdateAreaRoutingCache
 ============
 */
-void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache ) const {
+void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache, idRoutingUpdate *update ) const {
 	int i, nextAreaNum, cluster, badTravelFlags, clusterAreaNum, numReachableAreas;
 	unsigned short t, startAreaTravelTimes[MAX_REACH_PER_AREA];
 	idRoutingUpdate *updateListStart, *updateListEnd, *curUpdate, *nextUpdate;
@@ -730,7 +842,7 @@ void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache ) const {
 	memset( startAreaTravelTimes, 0, sizeof( startAreaTravelTimes ) );
 
 	// initialize first update
-	curUpdate = &areaUpdate[clusterAreaNum];
+	curUpdate = &update[clusterAreaNum];
 	curUpdate->areaNum = areaCache->areaNum;
 	curUpdate->areaTravelTimes = startAreaTravelTimes;
 	curUpdate->tmpTravelTime = areaCache->startTravelTime;
@@ -792,7 +904,7 @@ void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache ) const {
 
 				areaCache->travelTimes[clusterAreaNum] = t;
 				areaCache->reachabilities[clusterAreaNum] = reach->number; // reversed reachability used to get into this area
-				nextUpdate = &areaUpdate[clusterAreaNum];
+				nextUpdate = &update[clusterAreaNum];
 				nextUpdate->areaNum = nextAreaNum;
 				nextUpdate->tmpTravelTime = t;
 				nextUpdate->areaTravelTimes = reach->areaTravelTimes;
@@ -831,6 +943,15 @@ idRoutingCache *idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, in
 	int clusterAreaNum;
 	idRoutingCache *cache, *clusterCache;
 
+	// use the precomputed cache towards the cluster portals if available
+	if ( precomputedCache && precomputedEnabled && precomputedClusterValid[clusterNum] ) {
+		cache = GetPrecomputedRoutingCache( clusterNum, areaNum, travelFlags );
+		if ( cache ) {
+			precomputedCacheHits++;
+			return cache;
+		}
+	}
+
 	// number of the area in the cluster
 	clusterAreaNum = ClusterAreaNum( clusterNum, areaNum );
 	// pointer to the cache for the area in the cluster
@@ -843,6 +964,10 @@ idRoutingCache *idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, in
 	}
 	// if no cache found
 	if ( !cache ) {
+		areaCacheMisses++;
+		FreeCacheMemory( sizeof( idRoutingCache ) + file->GetCluster( clusterNum ).numReachableAreas * ( sizeof( byte ) + sizeof( unsigned short ) ) );
+		// the cache list of the area may have changed
+		clusterCache = areaCacheIndex[clusterNum][clusterAreaNum];
 		cache = new (TAG_AAS) idRoutingCache( file->GetCluster( clusterNum ).numReachableAreas );
 		cache->type = CACHETYPE_AREA;
 		cache->cluster = clusterNum;
@@ -855,7 +980,9 @@ idRoutingCache *idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, in
 			clusterCache->prev = cache;
 		}
 		areaCacheIndex[clusterNum][clusterAreaNum] = cache;
-		UpdateAreaRoutingCache( cache );
+		UpdateAreaRoutingCache( cache, areaUpdate );
+	} else {
+		areaCacheHits++;
 	}
 	LinkCache( cache );
 	return cache;
@@ -969,6 +1096,8 @@ idRoutingCache *idAASLocal::GetPortalRoutingCache( int clusterNum, int areaNum,
 	}
 	// if no cache found
 	if ( !cache ) {
+		portalCacheMisses++;
+		FreeCacheMemory( sizeof( idRoutingCache ) + file->GetNumPortals() * ( sizeof( byte ) + sizeof( unsigned short ) ) );
 		cache = new (TAG_AAS) idRoutingCache( file->GetNumPortals() );
 		cache->type = CACHETYPE_PORTAL;
 		cache->cluster = clusterNum;
@@ -982,6 +1111,8 @@ idRoutingCache *idAASLocal::GetPortalRoutingCache( int clusterNum, int areaNum,
 		}
 		portalCacheIndex[areaNum] = cache;
 		UpdatePortalRoutingCache( cache );
+	} else {
+		portalCacheHits++;
 	}
 	LinkCache( cache );
 	return cache;
@@ -1020,9 +1151,9 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 		return false;
 	}
 
-	while( totalCacheMemory > MAX_ROUTING_CACHE_MEMORY ) {
-		DeleteOldestCache();
-	}
+	// start a new query, any cache used by an earlier query may be freed
+	routingQueryNum++;
+	FreeCacheMemory( 0 );
 
 	clusterNum = file->GetArea( areaNum ).cluster;
 	goalClusterNum = file->GetArea( goalAreaNum ).cluster;
@@ -1348,3 +1479,265 @@ bool idAASLocal::FindNearestGoal( aasGoal_t &goal, int areaNum, const idVec3 ori
 
 	return false;
 }
+
+/*
+===============================================================================
+
+	Precomputed routing tables
+
+	The area routing cache towards every cluster portal is calculated for the
+	travel flags used by the AI when the map is loaded. These are the caches
+	used to route through the portal cache so most routing queries never have
+	to update an area cache at run time.
+
+===============================================================================
+*/
+
+struct aasPrecomputeRoutingParms_s {
+	const idAASLocal *	aas;
+	idRoutingUpdate *	update;			// scratch memory owned by this job
+	int					firstTask;
+	int					taskStride;
+	int					numTasks;
+	int					numClusters;
+};
+
+/*
+============
+AAS_PrecomputeRoutingJob
+============
+*/
+void AAS_PrecomputeRoutingJob( aasPrecomputeRoutingParms_s *parms ) {
+	const idAASLocal *aas = parms->aas;
+	const idAASFile *file = aas->file;
+
+	for ( int task = parms->firstTask; task < parms->numTasks; task += parms->taskStride ) {
+		const int flagsIndex = task / parms->numClusters;
+		const int clusterNum = task % parms->numClusters;
+		if ( clusterNum == 0 ) {
+			continue;
+		}
+		const aasCluster_t &cluster = file->GetCluster( clusterNum );
+		idRoutingCache **cacheList = &aas->precomputedCache[flagsIndex * file->GetNumPortalIndexes() + cluster.firstPortal];
+		for ( int i = 0; i < cluster.numPortals; i++ ) {
+			aas->UpdateAreaRoutingCache( cacheList[i], parms->update );
+		}
+	}
+}
+REGISTER_PARALLEL_JOB( AAS_PrecomputeRoutingJob, "AAS_PrecomputeRoutingJob" );
+
+/*
+============
+idAASLocal::PrecomputeRoutingTables
+============
+*/
+void idAASLocal::PrecomputeRoutingTables() {
+	int i, j, k, numClusters, numPortalIndexes, numCache, offset, numJobs;
+
+	FreeRoutingTables();
+
+	const int startTime = Sys_Milliseconds();
+
+	numClusters = file->GetNumClusters();
+	numPortalIndexes = file->GetNumPortalIndexes();
+	numCache = numPrecomputedTravelFlags * numPortalIndexes;
+	if ( numCache <= 0 ) {
+		return;
+	}
+
+	// calculate the size of the flat tables
+	offset = 0;
+	for ( i = 1; i < numClusters; i++ ) {
+		const aasCluster_t &cluster = file->GetCluster( i );
+		offset += cluster.numPortals * cluster.numReachableAreas;
+	}
+	offset *= numPrecomputedTravelFlags;
+
+	precomputedTravelTimes = (unsigned short *) Mem_ClearedAlloc( offset * sizeof( precomputedTravelTimes[0] ), TAG_AAS );
+	precomputedReachabilities = (unsigned char *) Mem_ClearedAlloc( offset * sizeof( precomputedReachabilities[0] ), TAG_AAS );
+	precomputedCache = (idRoutingCache **) Mem_ClearedAlloc( numCache * sizeof( idRoutingCache * ), TAG_AAS );
+	precomputedMemory = offset * ( sizeof( precomputedTravelTimes[0] ) + sizeof( precomputedReachabilities[0] ) ) + numCache * sizeof( idRoutingCache );
+
+	// setup the cache headers pointing into the flat tables
+	offset = 0;
+	for ( k = 0; k < numPrecomputedTravelFlags; k++ ) {
+		for ( i = 1; i < numClusters; i++ ) {
+			const aasCluster_t &cluster = file->GetCluster( i );
+			for ( j = 0; j < cluster.numPortals; j++ ) {
+				idRoutingCache *cache = new (TAG_AAS) idRoutingCache( cluster.numReachableAreas, precomputedReachabilities + offset, precomputedTravelTimes + offset );
+				cache->type = CACHETYPE_AREA;
+				cache->cluster = i;
+				cache->areaNum = file->GetPortal( file->GetPortalIndex( cluster.firstPortal + j ) ).areaNum;
+				cache->startTravelTime = 1;
+				cache->travelFlags = precomputedTravelFlags[k];
+				precomputedCache[k * numPortalIndexes + cluster.firstPortal + j] = cache;
+				offset += cluster.numReachableAreas;
+			}
+		}
+	}
+
+	precomputedClusterValid.SetNum( numClusters );
+	for ( i = 0; i < numClusters; i++ ) {
+		precomputedClusterValid[i] = true;
+	}
+
+	// calculate the cache on the job threads, each job has its own update memory
+	const int numTasks = numPrecomputedTravelFlags * numClusters;
+	numJobs = Min( numTasks, MAX_PRECOMPUTE_ROUTING_JOBS );
+
+	aasPrecomputeRoutingParms_s parms[MAX_PRECOMPUTE_ROUTING_JOBS];
+	idParallelJobList *jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, numJobs, 0, NULL );
+	for ( i = 0; i < numJobs; i++ ) {
+		parms[i].aas = this;
+		parms[i].update = (idRoutingUpdate *) Mem_ClearedAlloc( file->GetNumAreas() * sizeof( idRoutingUpdate ), TAG_AAS );
+		parms[i].firstTask = i;
+		parms[i].taskStride = numJobs;
+		parms[i].numTasks = numTasks;
+		parms[i].numClusters = numClusters;
+		jobList->AddJob( (jobRun_t)AAS_PrecomputeRoutingJob, &parms[i] );
+	}
+	jobList->Submit();
+	jobList->Wait();
+	parallelJobManager->FreeJobList( jobList );
+
+	for ( i = 0; i < numJobs; i++ ) {
+		Mem_Free( parms[i].update );
+	}
+
+	gameLocal.Printf( "precomputed %d portal routing cache (%d KB) in %d msec\n", numCache, precomputedMemory >> 10, Sys_Milliseconds() - startTime );
+}
+
+/*
+============
+idAASLocal::FreeRoutingTables
+============
+*/
+void idAASLocal::FreeRoutingTables() {
+	if ( precomputedCache ) {
+		const int numCache = numPrecomputedTravelFlags * file->GetNumPortalIndexes();
+		for ( int i = 0; i < numCache; i++ ) {
+			delete precomputedCache[i];
+		}
+		Mem_Free( precomputedCache );
+		precomputedCache = NULL;
+	}
+	Mem_Free( precomputedTravelTimes );
+	precomputedTravelTimes = NULL;
+	Mem_Free( precomputedReachabilities );
+	precomputedReachabilities = NULL;
+	precomputedMemory = 0;
+	precomputedClusterValid.Clear();
+}
+
+/*
+============
+idAASLocal::GetPrecomputedRoutingCache
+============
+*/
+idRoutingCache *idAASLocal::GetPrecomputedRoutingCache( int clusterNum, int areaNum, int travelFlags ) const {
+	int flagsIndex;
+
+	for ( flagsIndex = 0; flagsIndex < numPrecomputedTravelFlags; flagsIndex++ ) {
+		if ( precomputedTravelFlags[flagsIndex] == travelFlags ) {
+			break;
+		}
+	}
+	if ( flagsIndex >= numPrecomputedTravelFlags ) {
+		return NULL;
+	}
+
+	// only the cache towards the portals of the cluster is precomputed
+	if ( file->GetArea( areaNum ).cluster >= 0 ) {
+		return NULL;
+	}
+
+	const aasCluster_t &cluster = file->GetCluster( clusterNum );
+	idRoutingCache **cacheList = &precomputedCache[flagsIndex * file->GetNumPortalIndexes() + cluster.firstPortal];
+	for ( int i = 0; i < cluster.numPortals; i++ ) {
+		if ( cacheList[i]->areaNum == areaNum ) {
+			return cacheList[i];
+		}
+	}
+	return NULL;
+}
+
+/*
+============
+idAASLocal::FlushRoutingCache
+
+Empties the cache without counting it as invalidated by area or obstacle changes.
+============
+*/
+void idAASLocal::FlushRoutingCache() {
+	const int oldInvalidations = numCacheInvalidations;
+	for ( int i = 0; i < file->GetNumClusters(); i++ ) {
+		DeleteClusterCache( i );
+	}
+	DeletePortalCache();
+	numCacheInvalidations = oldInvalidations;
+}
+
+/*
+============
+idAASLocal::RoutingBenchmark
+============
+*/
+void idAASLocal::RoutingBenchmark( int numQueries ) {
+	int i, mode, numModes, travelTime, numRoutes;
+	idReachability *reach;
+
+	if ( !file || numQueries <= 0 ) {
+		return;
+	}
+
+	// collect random pairs of reachable areas
+	idList<int> walkAreas;
+	for ( i = 1; i < file->GetNumAreas(); i++ ) {
+		if ( file->GetArea( i ).flags & AREA_REACHABLE_WALK ) {
+			walkAreas.Append( i );
+		}
+	}
+	if ( walkAreas.Num() == 0 ) {
+		gameLocal.Printf( "no walk reachable areas\n" );
+		return;
+	}
+
+	idRandom random( 0x5eed );
+	idList<int> startAreas, goalAreas;
+	startAreas.SetNum( numQueries );
+	goalAreas.SetNum( numQueries );
+	for ( i = 0; i < numQueries; i++ ) {
+		startAreas[i] = walkAreas[ random.RandomInt( walkAreas.Num() ) ];
+		goalAreas[i] = walkAreas[ random.RandomInt( walkAreas.Num() ) ];
+	}
+
+	if ( !precomputedCache ) {
+		gameLocal.Printf( "no precomputed routing tables, set aas_precomputeRouting 1 and reload the map to compare\n" );
+	}
+
+	const bool oldEnabled = precomputedEnabled;
+	numModes = precomputedCache ? 2 : 1;
+	for ( mode = 0; mode < numModes; mode++ ) {
+		precomputedEnabled = ( mode != 0 );
+		FlushRoutingCache();
+
+		int totalTime = 0, maxTime = 0, firstTime = 0;
+		numRoutes = 0;
+		for ( i = 0; i < numQueries; i++ ) {
+			const uint64 startTime = Sys_Microseconds();
+			if ( RouteToGoalArea( startAreas[i], AreaCenter( startAreas[i] ), goalAreas[i], TFL_WALK|TFL_AIR, travelTime, &reach ) ) {
+				numRoutes++;
+			}
+			const int time = (int)( Sys_Microseconds() - startTime );
+			if ( i == 0 ) {
+				firstTime = time;
+			}
+			totalTime += time;
+			maxTime = Max( maxTime, time );
+		}
+		gameLocal.Printf( "%-11s: %d queries, %d routes, %d usec total, %.2f usec avg, %d usec max, %d usec cold\n",
+			precomputedEnabled ? "precomputed" : "lazy", numQueries, numRoutes, totalTime, (float)totalTime / numQueries, maxTime, firstTime );
+	}
+	precomputedEnabled = oldEnabled;
+	FlushRoutingCache();
+}
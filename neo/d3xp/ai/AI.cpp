@@ -2453,10 +2453,10 @@ void idAI::Turn() {
 
 		// set the blend between no turn and full turn
 		float frac = anim_turn_amount / anim_turn_angles;
-		animator.CurrentAnim( ANIMCHANNEL_LEGS )->SetSyncedAnimWeight( 0, 1.0f - frac );
-		animator.CurrentAnim( ANIMCHANNEL_LEGS )->SetSyncedAnimWeight( 1, frac );
-		animator.CurrentAnim( ANIMCHANNEL_TORSO )->SetSyncedAnimWeight( 0, 1.0f - frac );
-		animator.CurrentAnim( ANIMCHANNEL_TORSO )->SetSyncedAnimWeight( 1, frac );
+		animator.SetSyncedAnimWeight( ANIMCHANNEL_LEGS, 0, 1.0f - frac );
+		animator.SetSyncedAnimWeight( ANIMCHANNEL_LEGS, 1, frac );
+		animator.SetSyncedAnimWeight( ANIMCHANNEL_TORSO, 0, 1.0f - frac );
+		animator.SetSyncedAnimWeight( ANIMCHANNEL_TORSO, 1, frac );
 
 		// get the total rotation from the start of the anim
 		animator.GetDeltaRotation( 0, gameLocal.time, rotateAxis );
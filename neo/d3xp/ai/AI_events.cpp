@@ -2671,10 +2671,10 @@ void idAI::Event_AnimTurn( float angles ) {
 		}
 	} else {
 		anim_turn_amount = 0.0f;
-		animator.CurrentAnim( ANIMCHANNEL_LEGS )->SetSyncedAnimWeight( 0, 1.0f );
-		animator.CurrentAnim( ANIMCHANNEL_LEGS )->SetSyncedAnimWeight( 1, 0.0f );
-		animator.CurrentAnim( ANIMCHANNEL_TORSO )->SetSyncedAnimWeight( 0, 1.0f );
-		animator.CurrentAnim( ANIMCHANNEL_TORSO )->SetSyncedAnimWeight( 1, 0.0f );
+		animator.SetSyncedAnimWeight( ANIMCHANNEL_LEGS, 0, 1.0f );
+		animator.SetSyncedAnimWeight( ANIMCHANNEL_LEGS, 1, 0.0f );
+		animator.SetSyncedAnimWeight( ANIMCHANNEL_TORSO, 0, 1.0f );
+		animator.SetSyncedAnimWeight( ANIMCHANNEL_TORSO, 1, 0.0f );
 	}
 }
 
@@ -33,12 +33,16 @@ If you have questions concerning this license or the applicable additional terms
 #include "../Game_local.h"
 
 idCVar binaryLoadAnim( "binaryLoadAnim", "1", 0, "enable binary load/write of idMD5Anim" );
+idCVar binaryQuantizeAnim( "binaryQuantizeAnim", "1", CVAR_BOOL, "store the frames of newly generated binary anims as 16 bit components" );
 
-static const byte B_ANIM_MD5_VERSION = 101;
+static const byte B_ANIM_MD5_VERSION = 102;
 static const unsigned int B_ANIM_MD5_MAGIC = ( 'B' << 24 ) | ( 'M' << 16 ) | ( 'D' << 8 ) | B_ANIM_MD5_VERSION;
+static const unsigned int B_ANIM_MD5_MAGIC_101 = ( 'B' << 24 ) | ( 'M' << 16 ) | ( 'D' << 8 ) | 101;	// float frames only
 
 static const int JOINT_FRAME_PAD	= 1;	// one extra to be able to read one more float than is necessary
 
+static const float MAX_QUANTIZED_TRANSLATION_STEP	= 1.0f / 32.0f;	// anims with larger translation ranges are kept as floats
+
 bool idAnimManager::forceExport = false;
 
 /***********************************************************************
@@ -89,6 +93,9 @@ void idMD5Anim::Free() {
 	jointInfo.Clear();
 	bounds.Clear();
 	componentFrames.Clear();
+	quantizedFrames.Clear();
+	componentOffsets.Clear();
+	componentScales.Clear();
 }
 
 /*
@@ -157,6 +164,7 @@ idMD5Anim::Allocated
 */
 size_t idMD5Anim::Allocated() const {
 	size_t	size = bounds.Allocated() + jointInfo.Allocated() + componentFrames.Allocated() + name.Allocated();
+	size += quantizedFrames.Allocated() + componentOffsets.Allocated() + componentScales.Allocated();
 	return size;
 }
 
@@ -351,6 +359,9 @@ bool idMD5Anim::LoadAnim( const char * filename ) {
 	animLength = ( ( numFrames - 1 ) * 1000 + frameRate - 1 ) / frameRate;
 
 	if ( binaryLoadAnim.GetBool() ) {
+		if ( binaryQuantizeAnim.GetBool() ) {
+			Quantize();
+		}
 		idLib::Printf( "Writing %s\n", generatedFileName.c_str() );
 		idFileLocal outputFile( fileSystem->OpenFileWrite( generatedFileName, "fs_basepath" ) );
 		WriteBinary( outputFile, sourceTimeStamp );
@@ -373,7 +384,7 @@ bool idMD5Anim::LoadBinary( idFile * file, ID_TIME_T sourceTimeStamp ) {
 
 	unsigned int magic = 0;
 	file->ReadBig( magic );
-	if ( magic != B_ANIM_MD5_MAGIC ) {
+	if ( magic != B_ANIM_MD5_MAGIC && magic != B_ANIM_MD5_MAGIC_101 ) {
 		return false;
 	}
 
@@ -428,10 +439,32 @@ bool idMD5Anim::LoadBinary( idFile * file, ID_TIME_T sourceTimeStamp ) {
 		j.w = 0.0f;
 	}
 
-	file->ReadBig( num );
-	componentFrames.SetNum( num + JOINT_FRAME_PAD );
-	for ( int i = 0; i < componentFrames.Num(); i++ ) {
-		file->ReadFloat( componentFrames[i] );
+	bool quantized = false;
+	if ( magic != B_ANIM_MD5_MAGIC_101 ) {
+		file->ReadBool( quantized );
+	}
+
+	if ( quantized ) {
+		componentFrames.Clear();
+
+		componentOffsets.SetNum( numAnimatedComponents );
+		componentScales.SetNum( numAnimatedComponents );
+		file->ReadBigArray( componentOffsets.Ptr(), numAnimatedComponents );
+		file->ReadBigArray( componentScales.Ptr(), numAnimatedComponents );
+
+		file->ReadBig( num );
+		quantizedFrames.SetNum( num + JOINT_FRAME_PAD );
+		file->ReadBigArray( quantizedFrames.Ptr(), quantizedFrames.Num() );
+	} else {
+		quantizedFrames.Clear();
+		componentOffsets.Clear();
+		componentScales.Clear();
+
+		file->ReadBig( num );
+		componentFrames.SetNum( num + JOINT_FRAME_PAD );
+		for ( int i = 0; i < componentFrames.Num(); i++ ) {
+			file->ReadFloat( componentFrames[i] );
+		}
 	}
 
 	//file->ReadString( name );
@@ -488,9 +521,19 @@ void idMD5Anim::WriteBinary( idFile * file, ID_TIME_T sourceTimeStamp ) {
 		file->WriteVec3( j.t );
 	}
 
-	file->WriteBig( componentFrames.Num() - JOINT_FRAME_PAD );
-	for ( int i = 0; i < componentFrames.Num(); i++ ) {
-		file->WriteFloat( componentFrames[i] );
+	file->WriteBool( IsQuantized() );
+
+	if ( IsQuantized() ) {
+		file->WriteBigArray( componentOffsets.Ptr(), componentOffsets.Num() );
+		file->WriteBigArray( componentScales.Ptr(), componentScales.Num() );
+
+		file->WriteBig( quantizedFrames.Num() - JOINT_FRAME_PAD );
+		file->WriteBigArray( quantizedFrames.Ptr(), quantizedFrames.Num() );
+	} else {
+		file->WriteBig( componentFrames.Num() - JOINT_FRAME_PAD );
+		for ( int i = 0; i < componentFrames.Num(); i++ ) {
+			file->WriteFloat( componentFrames[i] );
+		}
 	}
 
 	//file->WriteString( name );
@@ -498,6 +541,88 @@ void idMD5Anim::WriteBinary( idFile * file, ID_TIME_T sourceTimeStamp ) {
 	//file->WriteBig( ref_count );
 }
 
+/*
+========================
+idMD5Anim::Quantize
+
+Stores every animated component as a 16 bit fraction of the range that component covers
+over all the frames.  Returns false and keeps the float frames when a translation range
+is too large to quantize without visible error.
+========================
+*/
+bool idMD5Anim::Quantize() {
+	if ( numAnimatedComponents == 0 || IsQuantized() ) {
+		return false;
+	}
+
+	// mark the translation components
+	idList< bool > isTranslation;
+	isTranslation.SetNum( numAnimatedComponents );
+	for ( int c = 0; c < numAnimatedComponents; c++ ) {
+		isTranslation[c] = false;
+	}
+	for ( int i = 0; i < jointInfo.Num(); i++ ) {
+		int component = jointInfo[i].firstComponent;
+		for ( int bit = ANIM_BIT_TX; bit <= ANIM_BIT_TZ; bit++ ) {
+			if ( jointInfo[i].animBits & BIT( bit ) ) {
+				isTranslation[component++] = true;
+			}
+		}
+	}
+
+	componentOffsets.SetNum( numAnimatedComponents );
+	componentScales.SetNum( numAnimatedComponents );
+	for ( int c = 0; c < numAnimatedComponents; c++ ) {
+		float minValue = idMath::INFINITY;
+		float maxValue = -idMath::INFINITY;
+		for ( int i = 0; i < numFrames; i++ ) {
+			const float value = componentFrames[i * numAnimatedComponents + c];
+			minValue = Min( minValue, value );
+			maxValue = Max( maxValue, value );
+		}
+		const float scale = ( maxValue - minValue ) / 65535.0f;
+		if ( isTranslation[c] && scale > MAX_QUANTIZED_TRANSLATION_STEP ) {
+			componentOffsets.Clear();
+			componentScales.Clear();
+			return false;
+		}
+		componentOffsets[c] = minValue;
+		componentScales[c] = scale;
+	}
+
+	const int numComponents = numFrames * numAnimatedComponents;
+	quantizedFrames.SetGranularity( 1 );
+	quantizedFrames.SetNum( numComponents + JOINT_FRAME_PAD );
+	for ( int i = 0; i < numComponents; i++ ) {
+		const int c = i % numAnimatedComponents;
+		int q = 0;
+		if ( componentScales[c] > 0.0f ) {
+			q = idMath::Ftoi( ( componentFrames[i] - componentOffsets[c] ) / componentScales[c] + 0.5f );
+		}
+		quantizedFrames[i] = (uint16)idMath::ClampInt( 0, 65535, q );
+	}
+	for ( int i = numComponents; i < quantizedFrames.Num(); i++ ) {
+		quantizedFrames[i] = 0;
+	}
+
+	componentFrames.Clear();
+
+	return true;
+}
+
+/*
+====================
+idMD5Anim::GetComponent
+====================
+*/
+ID_INLINE float idMD5Anim::GetComponent( int framenum, int component ) const {
+	const int index = framenum * numAnimatedComponents + component;
+	if ( quantizedFrames.Num() ) {
+		return componentOffsets[component] + quantizedFrames[index] * componentScales[component];
+	}
+	return componentFrames[index];
+}
+
 /*
 ====================
 idMD5Anim::IncreaseRefs
@@ -612,23 +737,20 @@ void idMD5Anim::GetOrigin( idVec3 &offset, int time, int cyclecount ) const {
 	frameBlend_t frame;
 	ConvertTimeToFrame( time, cyclecount, frame );
 
-	const float *componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-	const float *componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+	int component = jointInfo[ 0 ].firstComponent;
 
 	if ( jointInfo[ 0 ].animBits & ANIM_TX ) {
-		offset.x = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
-		componentPtr1++;
-		componentPtr2++;
+		offset.x = GetComponent( frame.frame1, component ) * frame.frontlerp + GetComponent( frame.frame2, component ) * frame.backlerp;
+		component++;
 	}
 
 	if ( jointInfo[ 0 ].animBits & ANIM_TY ) {
-		offset.y = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
-		componentPtr1++;
-		componentPtr2++;
+		offset.y = GetComponent( frame.frame1, component ) * frame.frontlerp + GetComponent( frame.frame2, component ) * frame.backlerp;
+		component++;
 	}
 
 	if ( jointInfo[ 0 ].animBits & ANIM_TZ ) {
-		offset.z = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
+		offset.z = GetComponent( frame.frame1, component ) * frame.frontlerp + GetComponent( frame.frame2, component ) * frame.backlerp;
 	}
 
 	if ( frame.cycleCount ) {
@@ -652,22 +774,29 @@ void idMD5Anim::GetOriginRotation( idQuat &rotation, int time, int cyclecount )
 	frameBlend_t frame;
 	ConvertTimeToFrame( time, cyclecount, frame );
 
-	const float	*jointframe1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-	const float	*jointframe2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+	int component = jointInfo[ 0 ].firstComponent;
 
 	if ( animBits & ANIM_TX ) {
-		jointframe1++;
-		jointframe2++;
+		component++;
 	}
 
 	if ( animBits & ANIM_TY ) {
-		jointframe1++;
-		jointframe2++;
+		component++;
 	}
 
 	if ( animBits & ANIM_TZ ) {
-		jointframe1++;
-		jointframe2++;
+		component++;
+	}
+
+	float jointframe1[3];
+	float jointframe2[3];
+	for ( int i = 0, bit = ANIM_BIT_QX; bit <= ANIM_BIT_QZ; bit++ ) {
+		if ( animBits & BIT( bit ) ) {
+			jointframe1[i] = GetComponent( frame.frame1, component );
+			jointframe2[i] = GetComponent( frame.frame2, component );
+			component++;
+			i++;
+		}
 	}
 
 	idQuat q1;
@@ -764,23 +893,20 @@ void idMD5Anim::GetBounds( idBounds &bnds, int time, int cyclecount ) const {
 	// origin position
 	idVec3 offset = baseFrame[ 0 ].t;
 	if ( jointInfo[ 0 ].animBits & ( ANIM_TX | ANIM_TY | ANIM_TZ ) ) {
-		const float *componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-		const float *componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+		int component = jointInfo[ 0 ].firstComponent;
 
 		if ( jointInfo[ 0 ].animBits & ANIM_TX ) {
-			offset.x = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
-			componentPtr1++;
-			componentPtr2++;
+			offset.x = GetComponent( frame.frame1, component ) * frame.frontlerp + GetComponent( frame.frame2, component ) * frame.backlerp;
+			component++;
 		}
 
 		if ( jointInfo[ 0 ].animBits & ANIM_TY ) {
-			offset.y = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
-			componentPtr1++;
-			componentPtr2++;
+			offset.y = GetComponent( frame.frame1, component ) * frame.frontlerp + GetComponent( frame.frame2, component ) * frame.backlerp;
+			component++;
 		}
 
 		if ( jointInfo[ 0 ].animBits & ANIM_TZ ) {
-			offset.z = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
+			offset.z = GetComponent( frame.frame1, component ) * frame.frontlerp + GetComponent( frame.frame2, component ) * frame.backlerp;
 		}
 	}
 
@@ -788,13 +914,39 @@ void idMD5Anim::GetBounds( idBounds &bnds, int time, int cyclecount ) const {
 	bnds[ 1 ] -= offset;
 }
 
+/*
+====================
+idMD5AnimFrame / idMD5AnimQuantizedFrame
+
+The component sources the frame decoders are instantiated with.
+====================
+*/
+class idMD5AnimFrame {
+public:
+					idMD5AnimFrame( const float * frame ) : frame( frame ) {}
+	float			operator[]( int component ) const { return frame[component]; }
+private:
+	const float *	frame;
+};
+
+class idMD5AnimQuantizedFrame {
+public:
+					idMD5AnimQuantizedFrame( const uint16 * frame, const float * offsets, const float * scales ) : frame( frame ), offsets( offsets ), scales( scales ) {}
+	float			operator[]( int component ) const { return offsets[component] + frame[component] * scales[component]; }
+private:
+	const uint16 *	frame;
+	const float *	offsets;
+	const float *	scales;
+};
+
 /*
 ====================
 DecodeInterpolatedFrames
 
 ====================
 */
-int DecodeInterpolatedFrames( idJointQuat * joints, idJointQuat * blendJoints, int * lerpIndex, const float * frame1, const float * frame2,
+template< class frame_t >
+int DecodeInterpolatedFrames( idJointQuat * joints, idJointQuat * blendJoints, int * lerpIndex, const frame_t & frame1, const frame_t & frame2,
 							const jointAnimInfo_t * jointInfo, const int * index, const int numIndexes ) {
 	int numLerpJoints = 0;
 	for ( int i = 0; i < numIndexes; i++ ) {
@@ -811,36 +963,35 @@ int DecodeInterpolatedFrames( idJointQuat * joints, idJointQuat * blendJoints, i
 
 			*blendPtr = *jointPtr;
 
-			const float * jointframe1 = frame1 + infoPtr->firstComponent;
-			const float * jointframe2 = frame2 + infoPtr->firstComponent;
+			int c = infoPtr->firstComponent;
 
 			if ( animBits & (ANIM_TX|ANIM_TY|ANIM_TZ) ) {
 				if ( animBits & ANIM_TX ) {
-					jointPtr->t.x = *jointframe1++;
-					blendPtr->t.x = *jointframe2++;
+					jointPtr->t.x = frame1[c];
+					blendPtr->t.x = frame2[c++];
 				}
 				if ( animBits & ANIM_TY ) {
-					jointPtr->t.y = *jointframe1++;
-					blendPtr->t.y = *jointframe2++;
+					jointPtr->t.y = frame1[c];
+					blendPtr->t.y = frame2[c++];
 				}
 				if ( animBits & ANIM_TZ ) {
-					jointPtr->t.z = *jointframe1++;
-					blendPtr->t.z = *jointframe2++;
+					jointPtr->t.z = frame1[c];
+					blendPtr->t.z = frame2[c++];
 				}
 			}
 
 			if ( animBits & (ANIM_QX|ANIM_QY|ANIM_QZ) ) {
 				if ( animBits & ANIM_QX ) {
-					jointPtr->q.x = *jointframe1++;
-					blendPtr->q.x = *jointframe2++;
+					jointPtr->q.x = frame1[c];
+					blendPtr->q.x = frame2[c++];
 				}
 				if ( animBits & ANIM_QY ) {
-					jointPtr->q.y = *jointframe1++;
-					blendPtr->q.y = *jointframe2++;
+					jointPtr->q.y = frame1[c];
+					blendPtr->q.y = frame2[c++];
 				}
 				if ( animBits & ANIM_QZ ) {
-					jointPtr->q.z = *jointframe1++;
-					blendPtr->q.z = *jointframe2++;
+					jointPtr->q.z = frame1[c];
+					blendPtr->q.z = frame2[c++];
 				}
 				jointPtr->q.w = jointPtr->q.CalcW();
 				blendPtr->q.w = blendPtr->q.CalcW();
@@ -867,10 +1018,16 @@ void idMD5Anim::GetInterpolatedFrame( frameBlend_t &frame, idJointQuat *joints,
 	idJointQuat * blendJoints = (idJointQuat *)_alloca16( baseFrame.Num() * sizeof( blendJoints[ 0 ] ) );
 	int * lerpIndex = (int *)_alloca16( baseFrame.Num() * sizeof( lerpIndex[ 0 ] ) );
 
-	const float * frame1 = &componentFrames[frame.frame1 * numAnimatedComponents];
-	const float * frame2 = &componentFrames[frame.frame2 * numAnimatedComponents];
-
-	int numLerpJoints = DecodeInterpolatedFrames( joints, blendJoints, lerpIndex, frame1, frame2, jointInfo.Ptr(), index, numIndexes );
+	int numLerpJoints;
+	if ( IsQuantized() ) {
+		const idMD5AnimQuantizedFrame frame1( &quantizedFrames[frame.frame1 * numAnimatedComponents], componentOffsets.Ptr(), componentScales.Ptr() );
+		const idMD5AnimQuantizedFrame frame2( &quantizedFrames[frame.frame2 * numAnimatedComponents], componentOffsets.Ptr(), componentScales.Ptr() );
+		numLerpJoints = DecodeInterpolatedFrames( joints, blendJoints, lerpIndex, frame1, frame2, jointInfo.Ptr(), index, numIndexes );
+	} else {
+		const idMD5AnimFrame frame1( &componentFrames[frame.frame1 * numAnimatedComponents] );
+		const idMD5AnimFrame frame2( &componentFrames[frame.frame2 * numAnimatedComponents] );
+		numLerpJoints = DecodeInterpolatedFrames( joints, blendJoints, lerpIndex, frame1, frame2, jointInfo.Ptr(), index, numIndexes );
+	}
 
 	SIMDProcessor->BlendJoints( joints, blendJoints, frame.backlerp, lerpIndex, numLerpJoints );
 
@@ -885,7 +1042,8 @@ DecodeSingleFrame
 
 ====================
 */
-void DecodeSingleFrame( idJointQuat * joints, const float * frame,
+template< class frame_t >
+void DecodeSingleFrame( idJointQuat * joints, const frame_t & frame,
 						const jointAnimInfo_t * jointInfo, const int * index, const int numIndexes ) {
 	for ( int i = 0; i < numIndexes; i++ ) {
 		const int j = index[i];
@@ -896,29 +1054,29 @@ void DecodeSingleFrame( idJointQuat * joints, const float * frame,
 
 			idJointQuat * jointPtr = &joints[j];
 
-			const float * jointframe = frame + infoPtr->firstComponent;
+			int c = infoPtr->firstComponent;
 
 			if ( animBits & (ANIM_TX|ANIM_TY|ANIM_TZ) ) {
 				if ( animBits & ANIM_TX ) {
-					jointPtr->t.x = *jointframe++;
+					jointPtr->t.x = frame[c++];
 				}
 				if ( animBits & ANIM_TY ) {
-					jointPtr->t.y = *jointframe++;
+					jointPtr->t.y = frame[c++];
 				}
 				if ( animBits & ANIM_TZ ) {
-					jointPtr->t.z = *jointframe++;
+					jointPtr->t.z = frame[c++];
 				}
 			}
 
 			if ( animBits & (ANIM_QX|ANIM_QY|ANIM_QZ) ) {
 				if ( animBits & ANIM_QX ) {
-					jointPtr->q.x = *jointframe++;
+					jointPtr->q.x = frame[c++];
 				}
 				if ( animBits & ANIM_QY ) {
-					jointPtr->q.y = *jointframe++;
+					jointPtr->q.y = frame[c++];
 				}
 				if ( animBits & ANIM_QZ ) {
-					jointPtr->q.z = *jointframe++;
+					jointPtr->q.z = frame[c++];
 				}
 				jointPtr->q.w = jointPtr->q.CalcW();
 			}
@@ -940,9 +1098,13 @@ void idMD5Anim::GetSingleFrame( int framenum, idJointQuat *joints, const int *in
 		return;
 	}
 
-	const float * frame = &componentFrames[framenum * numAnimatedComponents];
-
-	DecodeSingleFrame( joints, frame, jointInfo.Ptr(), index, numIndexes );
+	if ( IsQuantized() ) {
+		const idMD5AnimQuantizedFrame frame( &quantizedFrames[framenum * numAnimatedComponents], componentOffsets.Ptr(), componentScales.Ptr() );
+		DecodeSingleFrame( joints, frame, jointInfo.Ptr(), index, numIndexes );
+	} else {
+		const idMD5AnimFrame frame( &componentFrames[framenum * numAnimatedComponents] );
+		DecodeSingleFrame( joints, frame, jointInfo.Ptr(), index, numIndexes );
+	}
 }
 
 /*
@@ -202,10 +202,15 @@ private:
 	idList<jointAnimInfo_t, TAG_MD5_ANIM>	jointInfo;
 	idList<idJointQuat, TAG_MD5_ANIM>		baseFrame;
 	idList<float, TAG_MD5_ANIM>			componentFrames;
+	idList<uint16, TAG_MD5_ANIM>		quantizedFrames;	// replaces componentFrames when quantized
+	idList<float, TAG_MD5_ANIM>			componentOffsets;	// per component range of the quantized frames
+	idList<float, TAG_MD5_ANIM>			componentScales;
 	idStr					name;
 	idVec3					totaldelta;
 	mutable int				ref_count;
 
+	float					GetComponent( int framenum, int component ) const;
+
 public:
 							idMD5Anim();
 							~idMD5Anim();
@@ -217,6 +222,8 @@ public:
 	bool					LoadAnim( const char *filename );
 	bool					LoadBinary( idFile * file, ID_TIME_T sourceTimeStamp );
 	void					WriteBinary( idFile * file, ID_TIME_T sourceTimeStamp );
+	bool					Quantize();
+	bool					IsQuantized() const { return quantizedFrames.Num() > 0; }
 
 	void					IncreaseRefs() const;
 	void					DecreaseRefs() const;
@@ -491,6 +498,7 @@ public:
 	void						ForceUpdate();
 	void						ClearForceUpdate();
 	bool						CreateFrame( int animtime, bool force );
+	bool						NeedsFrame( int animtime ) const;
 	bool						FrameHasChanged( int animtime ) const;
 	void						GetDelta( int fromtime, int totime, idVec3 &delta ) const;
 	bool						GetDeltaRotation( int fromtime, int totime, idMat3 &delta ) const;
@@ -498,6 +506,11 @@ public:
 	bool						GetBounds( int currentTime, idBounds &bounds );
 
 	idAnimBlend					*CurrentAnim( int channelNum );
+								// change the current anim of a channel, use these instead of the
+								// idAnimBlend setters so the frame gets rebuilt
+	bool						SetSyncedAnimWeight( int channelNum, int num, float weight );
+	void						SetCycleCount( int channelNum, int count );
+	void						SetStartTime( int channelNum, int startTime );
 	void						Clear( int channelNum, int currentTime, int cleartime );
 	void						SetFrame( int channelNum, int animnum, int frame, int currenttime, int blendtime );
 	void						CycleAnim( int channelNum, int animnum, int currenttime, int blendtime );
@@ -563,6 +576,51 @@ private:
 	int							AFPoseTime;
 };
 
+/*
+==============================================================================================
+
+	idAnimatorFrameBatch
+
+	Creates the frames of all the gathered animators over the job threads.  Any later
+	CreateFrame for the same time is free unless the animator was changed in between,
+	which always goes through ForceUpdate.
+
+==============================================================================================
+*/
+
+struct animatorFrameParms_t {
+	idAnimator **				animators;
+	int							numAnimators;
+	int							currentTime;
+};
+
+class idAnimatorFrameBatch {
+public:
+								idAnimatorFrameBatch();
+								~idAnimatorFrameBatch();
+
+	void						Init();
+	void						Shutdown();
+
+	void						Begin( int currentTime );
+	void						AddAnimator( idAnimator *animator );
+	void						CreateFrames();
+
+	int							NumFrames() const { return numFrames; }
+	int							Microseconds() const { return microseconds; }
+
+private:
+	static const int			MAX_JOBS = 32;
+	static const int			MIN_ANIMATORS_PER_JOB = 2;
+
+	idParallelJobList *			jobList;
+	idList<idAnimator *, TAG_ANIM>	animators;
+	animatorFrameParms_t		parms[MAX_JOBS];
+	int							currentTime;
+	int							numFrames;
+	int							microseconds;
+};
+
 /*
 ==============================================================================================
 
@@ -3415,7 +3415,10 @@ idAnimator::RemoveOriginOffset
 =====================
 */
 void idAnimator::RemoveOriginOffset( bool remove ) {
-	removeOriginOffset = remove;
+	if ( removeOriginOffset != remove ) {
+		removeOriginOffset = remove;
+		ForceUpdate();
+	}
 }
 
 /*
@@ -3535,6 +3538,43 @@ idAnimBlend *idAnimator::CurrentAnim( int channelNum ) {
 	return &channels[ channelNum ][ 0 ];
 }
 
+/*
+=====================
+idAnimator::SetSyncedAnimWeight
+=====================
+*/
+bool idAnimator::SetSyncedAnimWeight( int channelNum, int num, float weight ) {
+	idAnimBlend *blend = CurrentAnim( channelNum );
+	const float oldWeight = ( ( num >= 0 ) && ( num < ANIM_MaxSyncedAnims ) ) ? blend->animWeights[ num ] : weight;
+	if ( !blend->SetSyncedAnimWeight( num, weight ) ) {
+		return false;
+	}
+	if ( oldWeight != weight ) {
+		ForceUpdate();
+	}
+	return true;
+}
+
+/*
+=====================
+idAnimator::SetCycleCount
+=====================
+*/
+void idAnimator::SetCycleCount( int channelNum, int count ) {
+	CurrentAnim( channelNum )->SetCycleCount( count );
+	ForceUpdate();
+}
+
+/*
+=====================
+idAnimator::SetStartTime
+=====================
+*/
+void idAnimator::SetStartTime( int channelNum, int startTime ) {
+	CurrentAnim( channelNum )->SetStartTime( startTime );
+	ForceUpdate();
+}
+
 /*
 =====================
 idAnimator::Clear
@@ -3572,6 +3612,7 @@ void idAnimator::SetFrame( int channelNum, int animNum, int frame, int currentTi
 
 	PushAnims( channelNum, currentTime, blendTime );
 	channels[ channelNum ][ 0 ].SetFrame( modelDef, animNum, frame, currentTime, blendTime );
+	ForceUpdate();
 	if ( entity ) {
 		entity->BecomeActive( TH_ANIMATE );
 	}
@@ -3593,6 +3634,7 @@ void idAnimator::CycleAnim( int channelNum, int animNum, int currentTime, int bl
 	
 	PushAnims( channelNum, currentTime, blendTime );
 	channels[ channelNum ][ 0 ].CycleAnim( modelDef, animNum, currentTime, blendTime );
+	ForceUpdate();
 	if ( entity ) {
 		entity->BecomeActive( TH_ANIMATE );
 	}
@@ -3614,6 +3656,7 @@ void idAnimator::PlayAnim( int channelNum, int animNum, int currentTime, int ble
 	
 	PushAnims( channelNum, currentTime, blendTime );
 	channels[ channelNum ][ 0 ].PlayAnim( modelDef, animNum, currentTime, blendTime );
+	ForceUpdate();
 	if ( entity ) {
 		entity->BecomeActive( TH_ANIMATE );
 	}
@@ -3644,6 +3687,7 @@ void idAnimator::SyncAnimChannels( int channelNum, int fromChannelNum, int curre
 
 	// disable framecommands on the current channel so that commands aren't called twice
 	toBlend.AllowFrameCommands( false );
+	ForceUpdate();
 
 	if ( entity ) {
 		entity->BecomeActive( TH_ANIMATE );
@@ -4122,7 +4166,10 @@ idAnimator::SetAFPoseBlendWeight
 =====================
 */
 void idAnimator::SetAFPoseBlendWeight( float blendWeight ) {
-	AFPoseBlendWeight = blendWeight;
+	if ( AFPoseBlendWeight != blendWeight ) {
+		AFPoseBlendWeight = blendWeight;
+		ForceUpdate();
+	}
 }
 
 /*
@@ -4253,6 +4300,28 @@ bool idAnimator::FrameHasChanged( int currentTime ) const {
 	return false;
 }
 
+static idCVar r_showSkel( "r_showSkel", "0", CVAR_RENDERER | CVAR_INTEGER, "", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
+
+/*
+=====================
+idAnimator::NeedsFrame
+
+Returns true if CreateFrame would have to build a new frame for the given time
+=====================
+*/
+bool idAnimator::NeedsFrame( int currentTime ) const {
+	if ( !modelDef || !modelDef->ModelHandle() ) {
+		return false;
+	}
+	if ( lastTransformTime == currentTime ) {
+		return false;
+	}
+	if ( lastTransformTime != -1 && !stoppedAnimatingUpdate && !IsAnimating( currentTime ) ) {
+		return false;
+	}
+	return true;
+}
+
 /*
 =====================
 idAnimator::CreateFrame
@@ -4271,19 +4340,12 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 	const jointMod_t *	jointMod;
 	const idJointQuat *	defaultPose;
 
-	static idCVar		r_showSkel( "r_showSkel", "0", CVAR_RENDERER | CVAR_INTEGER, "", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
-
 	if ( !modelDef || !modelDef->ModelHandle() ) {
 		return false;
 	}
 
-	if ( !force && !r_showSkel.GetInteger() ) {
-		if ( lastTransformTime == currentTime ) {
-			return false;
-		}
-		if ( lastTransformTime != -1 && !stoppedAnimatingUpdate && !IsAnimating( currentTime ) ) {
-			return false;
-		}
+	if ( !force && !r_showSkel.GetInteger() && !NeedsFrame( currentTime ) ) {
+		return false;
 	}
 
 	lastTransformTime = currentTime;
@@ -4494,6 +4556,128 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 	return true;
 }
 
+/*
+==============================================================================================
+
+	idAnimatorFrameBatch
+
+==============================================================================================
+*/
+
+/*
+=====================
+Anim_CreateFramesJob
+=====================
+*/
+void Anim_CreateFramesJob( animatorFrameParms_t *parms ) {
+	for ( int i = 0; i < parms->numAnimators; i++ ) {
+		parms->animators[i]->CreateFrame( parms->currentTime, false );
+	}
+}
+REGISTER_PARALLEL_JOB( Anim_CreateFramesJob, "Anim_CreateFramesJob" );
+
+/*
+=====================
+idAnimatorFrameBatch::idAnimatorFrameBatch
+=====================
+*/
+idAnimatorFrameBatch::idAnimatorFrameBatch() {
+	jobList = NULL;
+	currentTime = 0;
+	numFrames = 0;
+	microseconds = 0;
+}
+
+/*
+=====================
+idAnimatorFrameBatch::~idAnimatorFrameBatch
+=====================
+*/
+idAnimatorFrameBatch::~idAnimatorFrameBatch() {
+	assert( jobList == NULL );
+}
+
+/*
+=====================
+idAnimatorFrameBatch::Init
+=====================
+*/
+void idAnimatorFrameBatch::Init() {
+	if ( jobList == NULL ) {
+		jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, MAX_JOBS, 0, NULL );
+	}
+	animators.SetGranularity( 64 );
+}
+
+/*
+=====================
+idAnimatorFrameBatch::Shutdown
+=====================
+*/
+void idAnimatorFrameBatch::Shutdown() {
+	if ( jobList != NULL ) {
+		parallelJobManager->FreeJobList( jobList );
+		jobList = NULL;
+	}
+	animators.Clear();
+}
+
+/*
+=====================
+idAnimatorFrameBatch::Begin
+=====================
+*/
+void idAnimatorFrameBatch::Begin( int time ) {
+	currentTime = time;
+	animators.SetNum( 0 );
+}
+
+/*
+=====================
+idAnimatorFrameBatch::AddAnimator
+=====================
+*/
+void idAnimatorFrameBatch::AddAnimator( idAnimator *animator ) {
+	if ( animator != NULL && animator->NeedsFrame( currentTime ) ) {
+		animators.Append( animator );
+	}
+}
+
+/*
+=====================
+idAnimatorFrameBatch::CreateFrames
+=====================
+*/
+void idAnimatorFrameBatch::CreateFrames() {
+	const uint64 startTime = Sys_Microseconds();
+
+	numFrames = animators.Num();
+	if ( numFrames > 0 ) {
+		const int numJobs = ( jobList != NULL ) ? Min( MAX_JOBS, numFrames / MIN_ANIMATORS_PER_JOB ) : 0;
+		if ( numJobs <= 1 ) {
+			for ( int i = 0; i < numFrames; i++ ) {
+				animators[i]->CreateFrame( currentTime, false );
+			}
+		} else {
+			// hand out contiguous ranges so each job walks its own animators
+			int first = 0;
+			for ( int i = 0; i < numJobs; i++ ) {
+				const int last = ( numFrames * ( i + 1 ) ) / numJobs;
+				parms[i].animators = animators.Ptr() + first;
+				parms[i].numAnimators = last - first;
+				parms[i].currentTime = currentTime;
+				jobList->AddJob( (jobRun_t)Anim_CreateFramesJob, &parms[i] );
+				first = last;
+			}
+			jobList->Submit();
+			jobList->Wait();
+		}
+	}
+
+	animators.SetNum( 0 );
+	microseconds = (int)( Sys_Microseconds() - startTime );
+}
+
 /*
 =====================
 idAnimator::ForceUpdate
@@ -273,7 +273,7 @@ void idTestModel::Think() {
 						headAnimator->PlayAnim( ANIMCHANNEL_ALL, headAnim, gameLocal.time, FRAME2MS( g_testModelBlend.GetInteger() ) );
 						if ( headAnimator->AnimLength( headAnim ) > animator.AnimLength( anim ) ) {
 							// loop the body anim when the head anim is longer
-							animator.CurrentAnim( ANIMCHANNEL_ALL )->SetCycleCount( -1 );
+							animator.SetCycleCount( ANIMCHANNEL_ALL, -1 );
 						}
 					}
 				}
@@ -337,7 +337,7 @@ void idTestModel::Think() {
 				headAnimator->PlayAnim( ANIMCHANNEL_ALL, headAnim, gameLocal.time, FRAME2MS( g_testModelBlend.GetInteger() ) );
 				if ( headAnimator->AnimLength( headAnim ) > animator.AnimLength( anim ) ) {
 					// loop the body anim when the head anim is longer
-					animator.CurrentAnim( ANIMCHANNEL_ALL )->SetCycleCount( -1 );
+					animator.SetCycleCount( ANIMCHANNEL_ALL, -1 );
 				}
 			}
 		}
@@ -239,6 +239,10 @@ public:
 	static idTypeInfo *			GetType( int num );
 
 private:
+	friend class idEvent;
+
+	mutable idLinkList<idEvent>	eventList;			// events scheduled on this object
+
 	classSpawnFunc_t			CallSpawnFunc( idTypeInfo *cls );
 
 	bool						PostEventArgs( const idEventDef *ev, int time, int numargs, ... );
@@ -39,6 +39,9 @@ Event are used for scheduling tasks and for linking script commands.
 #include "../Game_local.h"
 
 #define MAX_EVENTSPERFRAME			4096
+#define EVENT_POOL_GRANULARITY		512			// number of events added to the pool when it runs out
+#define EVENT_DATA_GRANULARITY		16			// argument data sizes are rounded up to a multiple of this
+#define EVENT_DATA_SLAB_SIZE		( 16 * 1024 )	// argument data is allocated in slabs of this size
 //#define CREATE_EVENT_CODE
 
 /***********************************************************************
@@ -214,14 +217,320 @@ const idEventDef *idEventDef::FindEvent( const char *name ) {
 
 ***********************************************************************/
 
+/*
+===============================================================================
+
+	idEventQueue
+
+	Binary heap of the scheduled events ordered on time.  Events scheduled for the
+	same time are serviced in the order they were scheduled, just like the sorted
+	lists this replaced, but scheduling and cancelling an event is O(log n) instead
+	of a walk over all the pending events.
+
+===============================================================================
+*/
+
+class idEventQueue {
+public:
+	int							Num() const { return heap.Num(); }
+	idEvent *					First() const { return ( heap.Num() > 0 ) ? heap[0] : NULL; }
+	void						Add( idEvent *event );
+	void						Remove( idEvent *event );
+	void						Clear();
+	void						GetSorted( idList<idEvent *> &events ) const;
+
+	static bool					Before( const idEvent *a, const idEvent *b );
+
+private:
+	idList<idEvent *, TAG_IDCLASS>	heap;
+
+	void						Set( int index, idEvent *event );
+	void						SiftUp( int index );
+	void						SiftDown( int index );
+};
+
+class idSort_Events : public idSort_Quick< idEvent *, idSort_Events > {
+public:
+	int Compare( idEvent * const & a, idEvent * const & b ) const;
+};
+
+/*
+===============================================================================
+
+	idEventDataPool
+
+	The argument data of the events with the same rounded up size comes from the
+	same free list, the lists are filled from fixed size slabs that are only
+	released when the event system shuts down.
+
+===============================================================================
+*/
+
+class idEventDataPool {
+public:
+								idEventDataPool();
+
+	void						Shutdown();
+
+	byte *						Alloc( int size );
+	void						Free( byte *data, int size );
+
+	int							NumSlabs() const { return slabs.Num(); }
+	int							NumSizes() const { return freeLists.Num(); }
+	int							LiveBytes() const { return liveBytes; }
+	int							PeakBytes() const { return peakBytes; }
+
+private:
+	idList< idList<byte *, TAG_IDCLASS>, TAG_IDCLASS >	freeLists;	// free data for each size class
+	idList<byte *, TAG_IDCLASS>	slabs;
+	int							liveBytes;
+	int							peakBytes;
+};
+
 static idLinkList<idEvent> FreeEvents;
-static idLinkList<idEvent> EventQueue;
-static idLinkList<idEvent> FastEventQueue;
-static idEvent EventPool[ MAX_EVENTS ];
+static idEventQueue EventQueue;
+static idEventQueue FastEventQueue;
+static idList<idEvent *, TAG_IDCLASS> EventPool;	// blocks of EVENT_POOL_GRANULARITY events
+static idEventDataPool EventDataPool;
+static unsigned int EventSequence;
+static int numLiveEvents;
+static int peakLiveEvents;
+
+/*
+================
+idEventQueue::Before
+================
+*/
+ID_INLINE bool idEventQueue::Before( const idEvent *a, const idEvent *b ) {
+	if ( a->time != b->time ) {
+		return a->time < b->time;
+	}
+	return (int)( a->sequence - b->sequence ) < 0;
+}
+
+/*
+================
+idEventQueue::Set
+================
+*/
+ID_INLINE void idEventQueue::Set( int index, idEvent *event ) {
+	heap[index] = event;
+	event->queueIndex = index;
+}
+
+/*
+================
+idEventQueue::SiftUp
+================
+*/
+void idEventQueue::SiftUp( int index ) {
+	idEvent *event = heap[index];
+	while ( index > 0 ) {
+		const int parent = ( index - 1 ) >> 1;
+		if ( !Before( event, heap[parent] ) ) {
+			break;
+		}
+		Set( index, heap[parent] );
+		index = parent;
+	}
+	Set( index, event );
+}
+
+/*
+================
+idEventQueue::SiftDown
+================
+*/
+void idEventQueue::SiftDown( int index ) {
+	idEvent *event = heap[index];
+	const int num = heap.Num();
+	while ( 1 ) {
+		int child = index * 2 + 1;
+		if ( child >= num ) {
+			break;
+		}
+		if ( child + 1 < num && Before( heap[child + 1], heap[child] ) ) {
+			child++;
+		}
+		if ( !Before( heap[child], event ) ) {
+			break;
+		}
+		Set( index, heap[child] );
+		index = child;
+	}
+	Set( index, event );
+}
+
+/*
+================
+idEventQueue::Add
+================
+*/
+void idEventQueue::Add( idEvent *event ) {
+	assert( event->queue == NULL );
+	event->queue = this;
+	event->queueIndex = heap.Append( event );
+	SiftUp( event->queueIndex );
+}
+
+/*
+================
+idEventQueue::Remove
+================
+*/
+void idEventQueue::Remove( idEvent *event ) {
+	assert( event->queue == this && heap[event->queueIndex] == event );
+
+	const int index = event->queueIndex;
+	idEvent *last = heap[heap.Num() - 1];
+	heap.SetNum( heap.Num() - 1 );
+
+	event->queue = NULL;
+	event->queueIndex = -1;
+
+	if ( last != event ) {
+		Set( index, last );
+		if ( index > 0 && Before( last, heap[( index - 1 ) >> 1] ) ) {
+			SiftUp( index );
+		} else {
+			SiftDown( index );
+		}
+	}
+}
+
+/*
+================
+idEventQueue::Clear
+================
+*/
+void idEventQueue::Clear() {
+	for ( int i = 0; i < heap.Num(); i++ ) {
+		heap[i]->queue = NULL;
+		heap[i]->queueIndex = -1;
+	}
+	heap.Clear();
+}
+
+/*
+================
+idSort_Events::Compare
+================
+*/
+int idSort_Events::Compare( idEvent * const & a, idEvent * const & b ) const {
+	if ( idEventQueue::Before( a, b ) ) {
+		return -1;
+	}
+	if ( idEventQueue::Before( b, a ) ) {
+		return 1;
+	}
+	return 0;
+}
+
+/*
+================
+idEventQueue::GetSorted
+
+  gets the events in the order they will be serviced
+================
+*/
+void idEventQueue::GetSorted( idList<idEvent *> &events ) const {
+	events.SetNum( heap.Num() );
+	for ( int i = 0; i < heap.Num(); i++ ) {
+		events[i] = heap[i];
+	}
+	events.SortWithTemplate( idSort_Events() );
+}
+
+/*
+================
+idEventDataPool::idEventDataPool
+================
+*/
+idEventDataPool::idEventDataPool() {
+	liveBytes = 0;
+	peakBytes = 0;
+}
+
+/*
+================
+idEventDataPool::Shutdown
+================
+*/
+void idEventDataPool::Shutdown() {
+	for ( int i = 0; i < slabs.Num(); i++ ) {
+		Mem_Free16( slabs[i] );
+	}
+	slabs.Clear();
+	freeLists.Clear();
+	liveBytes = 0;
+	peakBytes = 0;
+}
+
+/*
+================
+idEventDataPool::Alloc
+================
+*/
+byte *idEventDataPool::Alloc( int size ) {
+	assert( size > 0 );
+
+	const int sizeClass = ( size - 1 ) / EVENT_DATA_GRANULARITY;
+	if ( sizeClass >= freeLists.Num() ) {
+		freeLists.SetNum( sizeClass + 1 );
+	}
+
+	idList<byte *, TAG_IDCLASS> &freeList = freeLists[sizeClass];
+	if ( freeList.Num() == 0 ) {
+		// carve a new slab into blocks of this size
+		const int blockSize = ( sizeClass + 1 ) * EVENT_DATA_GRANULARITY;
+		const int numBlocks = Max( 1, EVENT_DATA_SLAB_SIZE / blockSize );
+		byte *slab = (byte *)Mem_Alloc16( numBlocks * blockSize, TAG_IDCLASS );
+		slabs.Append( slab );
+		freeList.SetNum( numBlocks );
+		for ( int i = 0; i < numBlocks; i++ ) {
+			freeList[i] = slab + ( numBlocks - 1 - i ) * blockSize;
+		}
+	}
+
+	liveBytes += size;
+	peakBytes = Max( peakBytes, liveBytes );
+
+	byte *data = freeList[freeList.Num() - 1];
+	freeList.SetNum( freeList.Num() - 1 );
+	return data;
+}
+
+/*
+================
+idEventDataPool::Free
+================
+*/
+void idEventDataPool::Free( byte *data, int size ) {
+	const int sizeClass = ( size - 1 ) / EVENT_DATA_GRANULARITY;
+	assert( sizeClass < freeLists.Num() );
+	freeLists[sizeClass].Append( data );
+	liveBytes -= size;
+}
 
 bool idEvent::initialized = false;
 
-idDynamicBlockAlloc<byte, 16 * 1024, 256>	idEvent::eventDataAllocator;
+/*
+================
+idEvent::idEvent
+================
+*/
+idEvent::idEvent() {
+	eventdef	= NULL;
+	data		= NULL;
+	time		= 0;
+	object		= NULL;
+	typeinfo	= NULL;
+	queue		= NULL;
+	queueIndex	= -1;
+	sequence	= 0;
+	eventNode.SetOwner( this );
+	objectNode.SetOwner( this );
+}
 
 /*
 ================
@@ -232,6 +541,35 @@ idEvent::~idEvent() {
 	Free();
 }
 
+/*
+================
+idEvent::GrowPool
+================
+*/
+void idEvent::GrowPool() {
+	idEvent *events = new (TAG_IDCLASS) idEvent[EVENT_POOL_GRANULARITY];
+	EventPool.Append( events );
+	for ( int i = 0; i < EVENT_POOL_GRANULARITY; i++ ) {
+		events[i].eventNode.AddToEnd( FreeEvents );
+	}
+}
+
+/*
+================
+idEvent::FreePool
+================
+*/
+void idEvent::FreePool() {
+	ClearEventList();
+	for ( int i = 0; i < EventPool.Num(); i++ ) {
+		delete[] EventPool[i];
+	}
+	EventPool.Clear();
+	FreeEvents.Clear();
+	numLiveEvents = 0;
+	peakLiveEvents = 0;
+}
+
 /*
 ================
 idEvent::Alloc
@@ -247,12 +585,15 @@ idEvent *idEvent::Alloc( const idEventDef *evdef, int numargs, va_list args ) {
 	const char	*materialName;
 
 	if ( FreeEvents.IsListEmpty() ) {
-		gameLocal.Error( "idEvent::Alloc : No more free events" );
+		GrowPool();
 	}
 
 	ev = FreeEvents.Next();
 	ev->eventNode.Remove();
 
+	numLiveEvents++;
+	peakLiveEvents = Max( peakLiveEvents, numLiveEvents );
+
 	ev->eventdef = evdef;
 
 	if ( numargs != evdef->GetNumArgs() ) {
@@ -261,8 +602,7 @@ idEvent *idEvent::Alloc( const idEventDef *evdef, int numargs, va_list args ) {
 
 	size = evdef->GetArgSize();
 	if ( size ) {
-		ev->data = eventDataAllocator.Alloc( size );
-		memset( ev->data, 0, size );
+		ev->data = EventDataPool.Alloc( size );
 	} else {
 		ev->data = NULL;
 		return ev;
@@ -289,10 +629,14 @@ idEvent *idEvent::Alloc( const idEventDef *evdef, int numargs, va_list args ) {
 		case D_EVENT_VECTOR :
 			if ( arg->value ) {
 				*reinterpret_cast<idVec3 *>( dataPtr ) = *reinterpret_cast<const idVec3 *>( arg->value );
+			} else {
+				reinterpret_cast<idVec3 *>( dataPtr )->Zero();
 			}
 			break;
 
 		case D_EVENT_STRING :
+			// the whole string is written to save games
+			memset( dataPtr, 0, MAX_STRING_LEN );
 			if ( arg->value ) {
 				idStr::Copynz( reinterpret_cast<char *>( dataPtr ), reinterpret_cast<const char *>( arg->value ), MAX_STRING_LEN );
 			}
@@ -304,6 +648,7 @@ idEvent *idEvent::Alloc( const idEventDef *evdef, int numargs, va_list args ) {
 			break;
 
 		case D_EVENT_TRACE :
+			memset( dataPtr, 0, sizeof( bool ) + sizeof( trace_t ) + MAX_STRING_LEN );
 			if ( arg->value ) {
 				*reinterpret_cast<bool *>( dataPtr ) = true;
 				*reinterpret_cast<trace_t *>( dataPtr + sizeof( bool ) ) = *reinterpret_cast<const trace_t *>( arg->value );
@@ -364,14 +709,25 @@ idEvent::Free
 */
 void idEvent::Free() {
 	if ( data ) {
-		eventDataAllocator.Free( data );
+		EventDataPool.Free( data, eventdef->GetArgSize() );
 		data = NULL;
 	}
 
+	// the event is live when it isn't in the free list
+	if ( !eventNode.InList() ) {
+		numLiveEvents--;
+	}
+
+	if ( queue != NULL ) {
+		queue->Remove( this );
+	}
+	objectNode.Remove();
+
 	eventdef	= NULL;
 	time		= 0;
 	object		= NULL;
 	typeinfo	= NULL;
+	sequence	= 0;
 
 	eventNode.SetOwner( this );
 	eventNode.AddToEnd( FreeEvents );
@@ -383,8 +739,6 @@ idEvent::Schedule
 ================
 */
 void idEvent::Schedule( idClass *obj, const idTypeInfo *type, int time ) {
-	idEvent *event;
-
 	assert( initialized );
 	if ( !initialized ) {
 		return;
@@ -393,37 +747,24 @@ void idEvent::Schedule( idClass *obj, const idTypeInfo *type, int time ) {
 	object = obj;
 	typeinfo = type;
 
-	// wraps after 24 days...like I care. ;)
-	this->time = gameLocal.time + time;
-
 	eventNode.Remove();
+	if ( queue != NULL ) {
+		queue->Remove( this );
+	}
 
-	if ( obj->IsType( idEntity::Type ) && ( ( (idEntity*)(obj) )->timeGroup == TIME_GROUP2 ) ) {
-		event = FastEventQueue.Next();
-		while( ( event != NULL ) && ( this->time >= event->time ) ) {
-			event = event->eventNode.Next();
-		}
+	objectNode.SetOwner( this );
+	objectNode.AddToEnd( obj->eventList );
 
-		if ( event ) {
-			eventNode.InsertBefore( event->eventNode );
-		} else {
-			eventNode.AddToEnd( FastEventQueue );
-		}
+	// events for the same time are serviced in the order they are scheduled
+	sequence = EventSequence++;
 
-		return;
+	if ( obj->IsType( idEntity::Type ) && ( ( (idEntity*)(obj) )->timeGroup == TIME_GROUP2 ) ) {
+		// wraps after 24 days...like I care. ;)
+		this->time = gameLocal.time + time;
+		FastEventQueue.Add( this );
 	} else {
 		this->time = gameLocal.slow.time + time;
-	}
-
-	event = EventQueue.Next();
-	while( ( event != NULL ) && ( this->time >= event->time ) ) {
-		event = event->eventNode.Next();
-	}
-
-	if ( event ) {
-		eventNode.InsertBefore( event->eventNode );
-	} else {
-		eventNode.AddToEnd( EventQueue );
+		EventQueue.Add( this );
 	}
 }
 
@@ -440,21 +781,11 @@ void idEvent::CancelEvents( const idClass *obj, const idEventDef *evdef ) {
 		return;
 	}
 
-	for( event = EventQueue.Next(); event != NULL; event = next ) {
-		next = event->eventNode.Next();
-		if ( event->object == obj ) {
-			if ( !evdef || ( evdef == event->eventdef ) ) {
-				event->Free();
-			}
-		}
-	}
-
-	for( event = FastEventQueue.Next(); event != NULL; event = next ) {
-		next = event->eventNode.Next();
-		if ( event->object == obj ) {
-			if ( !evdef || ( evdef == event->eventdef ) ) {
-				event->Free();
-			}
+	for( event = obj->eventList.Next(); event != NULL; event = next ) {
+		next = event->objectNode.Next();
+		assert( event->object == obj );
+		if ( !evdef || ( evdef == event->eventdef ) ) {
+			event->Free();
 		}
 	}
 }
@@ -472,13 +803,20 @@ void idEvent::ClearEventList() {
 	//
 	FreeEvents.Clear();
 	EventQueue.Clear();
-   
+	FastEventQueue.Clear();
+	EventSequence = 0;
+
 	// 
 	// add the events to the free list
 	//
-	for( i = 0; i < MAX_EVENTS; i++ ) {
-		EventPool[ i ].Free();
+	for( i = 0; i < EventPool.Num(); i++ ) {
+		for ( int j = 0; j < EVENT_POOL_GRANULARITY; j++ ) {
+			EventPool[ i ][ j ].Free();
+		}
 	}
+
+	// the free list was emptied above, so Free counted every event as live
+	numLiveEvents = 0;
 }
 
 /*
@@ -500,8 +838,8 @@ void idEvent::ServiceEvents() {
 	const char  *materialName;
 
 	num = 0;
-	while( !EventQueue.IsListEmpty() ) {
-		event = EventQueue.Next();
+	while( EventQueue.Num() > 0 ) {
+		event = EventQueue.First();
 		assert( event );
 
 		if ( event->time > gameLocal.time ) {
@@ -556,9 +894,10 @@ void idEvent::ServiceEvents() {
 			}
 		}
 
-		// the event is removed from its list so that if then object
+		// the event is removed from its queue so that if then object
 		// is deleted, the event won't be freed twice
-		event->eventNode.Remove();
+		event->queue->Remove( event );
+		event->objectNode.Remove();
 		assert( event->object );
 		event->object->ProcessEventArgPtr( ev, args );
 
@@ -601,8 +940,8 @@ void idEvent::ServiceFastEvents() {
 	const char  *materialName;
 
 	num = 0;
-	while( !FastEventQueue.IsListEmpty() ) {
-		event = FastEventQueue.Next();
+	while( FastEventQueue.Num() > 0 ) {
+		event = FastEventQueue.First();
 		assert( event );
 
 		if ( event->time > gameLocal.fast.time ) {
@@ -655,9 +994,10 @@ void idEvent::ServiceFastEvents() {
 			}
 		}
 
-		// the event is removed from its list so that if then object
+		// the event is removed from its queue so that if then object
 		// is deleted, the event won't be freed twice
-		event->eventNode.Remove();
+		event->queue->Remove( event );
+		event->objectNode.Remove();
 		assert( event->object );
 		event->object->ProcessEventArgPtr( ev, args );
 
@@ -707,8 +1047,6 @@ void idEvent::Init() {
 
 	ClearEventList();
 
-	eventDataAllocator.Init();
-
 	gameLocal.Printf( "...%i event definitions\n", idEventDef::NumEventCommands() );
 
 	// the event system has started
@@ -728,14 +1066,29 @@ void idEvent::Shutdown() {
 		return;
 	}
 
-	ClearEventList();
-	
-	eventDataAllocator.Shutdown();
+	FreePool();
+	EventDataPool.Shutdown();
 
 	// say it is now shutdown
 	initialized = false;
 }
 
+/*
+================
+idEvent::EventStats_f
+================
+*/
+void idEvent::EventStats_f( const idCmdArgs &args ) {
+	const int numEvents = EventPool.Num() * EVENT_POOL_GRANULARITY;
+
+	gameLocal.Printf( "%6d pending events\n", EventQueue.Num() );
+	gameLocal.Printf( "%6d pending fast events\n", FastEventQueue.Num() );
+	gameLocal.Printf( "%6d live events, %d peak, %d allocated (%d kB)\n", numLiveEvents, peakLiveEvents, numEvents, numEvents * (int)sizeof( idEvent ) >> 10 );
+	gameLocal.Printf( "%6d kB live argument data, %d kB peak, %d slabs (%d kB) over %d size classes\n",
+						EventDataPool.LiveBytes() >> 10, EventDataPool.PeakBytes() >> 10,
+						EventDataPool.NumSlabs(), EventDataPool.NumSlabs() * EVENT_DATA_SLAB_SIZE >> 10, EventDataPool.NumSizes() );
+}
+
 /*
 ================
 idEvent::Save
@@ -748,11 +1101,14 @@ void idEvent::Save( idSaveGame *savefile ) {
 	byte *dataPtr;
 	bool validTrace;
 	const char	*format;
+	idList<idEvent *> events;
 
-	savefile->WriteInt( EventQueue.Num() );
+	// the events are saved in the order they will be serviced, which is what the sorted lists used to hold
+	EventQueue.GetSorted( events );
+	savefile->WriteInt( events.Num() );
 
-	event = EventQueue.Next();
-	while( event != NULL ) {
+	for ( int e = 0; e < events.Num(); e++ ) {
+		event = events[e];
 		savefile->WriteInt( event->time );
 		savefile->WriteString( event->eventdef->GetName() );
 		savefile->WriteString( event->typeinfo->classname );
@@ -796,22 +1152,20 @@ void idEvent::Save( idSaveGame *savefile ) {
 			}
 		}
 		assert( size == (int)event->eventdef->GetArgSize() );
-		event = event->eventNode.Next();
 	}
 
 	// Save the Fast EventQueue
-	savefile->WriteInt( FastEventQueue.Num() );
+	FastEventQueue.GetSorted( events );
+	savefile->WriteInt( events.Num() );
 
-	event = FastEventQueue.Next();
-	while( event != NULL ) {
+	for ( int e = 0; e < events.Num(); e++ ) {
+		event = events[e];
 		savefile->WriteInt( event->time );
 		savefile->WriteString( event->eventdef->GetName() );
 		savefile->WriteString( event->typeinfo->classname );
 		savefile->WriteObject( event->object );
 		savefile->WriteInt( event->eventdef->GetArgSize() );
 		savefile->Write( event->data, event->eventdef->GetArgSize() );
-
-		event = event->eventNode.Next();
 	}
 }
 
@@ -832,12 +1186,14 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 
 	for ( i = 0; i < num; i++ ) {
 		if ( FreeEvents.IsListEmpty() ) {
-			gameLocal.Error( "idEvent::Restore : No more free events" );
+			GrowPool();
 		}
 
 		event = FreeEvents.Next();
 		event->eventNode.Remove();
-		event->eventNode.AddToEnd( EventQueue );
+
+		numLiveEvents++;
+		peakLiveEvents = Max( peakLiveEvents, numLiveEvents );
 
 		savefile->ReadInt( event->time );
 
@@ -859,13 +1215,21 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 
 		savefile->ReadObject( event->object );
 
+		// restored in service order so the sequence keeps the order of events for the same time
+		event->sequence = EventSequence++;
+		EventQueue.Add( event );
+		if ( event->object != NULL ) {
+			event->objectNode.SetOwner( event );
+			event->objectNode.AddToEnd( event->object->eventList );
+		}
+
 		// read the args
 		savefile->ReadInt( argsize );
 		if ( argsize != (int)event->eventdef->GetArgSize() ) {
 			savefile->Error( "idEvent::Restore: arg size (%d) doesn't match saved arg size(%d) on event '%s'", event->eventdef->GetArgSize(), argsize, event->eventdef->GetName() );
 		}
 		if ( argsize ) {
-			event->data = eventDataAllocator.Alloc( argsize );
+			event->data = EventDataPool.Alloc( argsize );
 			format = event->eventdef->GetArgFormat();
 			assert( format );
 			for ( j = 0, size = 0; j < event->eventdef->GetNumArgs(); ++j) {
@@ -914,12 +1278,14 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 
 	for ( i = 0; i < num; i++ ) {
 		if ( FreeEvents.IsListEmpty() ) {
-			gameLocal.Error( "idEvent::Restore : No more free events" );
+			GrowPool();
 		}
 
 		event = FreeEvents.Next();
 		event->eventNode.Remove();
-		event->eventNode.AddToEnd( FastEventQueue );
+
+		numLiveEvents++;
+		peakLiveEvents = Max( peakLiveEvents, numLiveEvents );
 
 		savefile->ReadInt( event->time );
 
@@ -941,13 +1307,21 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 
 		savefile->ReadObject( event->object );
 
+		// restored in service order so the sequence keeps the order of events for the same time
+		event->sequence = EventSequence++;
+		FastEventQueue.Add( event );
+		if ( event->object != NULL ) {
+			event->objectNode.SetOwner( event );
+			event->objectNode.AddToEnd( event->object->eventList );
+		}
+
 		// read the args
 		savefile->ReadInt( argsize );
 		if ( argsize != (int)event->eventdef->GetArgSize() ) {
 			savefile->Error( "idEvent::Restore: arg size (%d) doesn't match saved arg size(%d) on event '%s'", event->eventdef->GetArgSize(), argsize, event->eventdef->GetName() );
 		}
 		if ( argsize ) {
-			event->data = eventDataAllocator.Alloc( argsize );
+			event->data = EventDataPool.Alloc( argsize );
 			savefile->Read( event->data, argsize );
 		} else {
 			event->data = NULL;
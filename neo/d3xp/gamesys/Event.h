@@ -84,8 +84,11 @@ public:
 
 class idSaveGame;
 class idRestoreGame;
+class idEventQueue;
 
 class idEvent {
+	friend class idEventQueue;
+
 private:
 	const idEventDef			*eventdef;
 	byte						*data;
@@ -93,14 +96,19 @@ private:
 	idClass						*object;
 	const idTypeInfo			*typeinfo;
 
-	idLinkList<idEvent>			eventNode;
-
-	static idDynamicBlockAlloc<byte, 16 * 1024, 256> eventDataAllocator;
+	idLinkList<idEvent>			eventNode;		// node in the free list
+	idLinkList<idEvent>			objectNode;		// node in the list of events scheduled on the object
+	idEventQueue *				queue;			// queue the event is scheduled in, NULL if not scheduled
+	int							queueIndex;		// index in the queue heap
+	unsigned int				sequence;		// events scheduled for the same time are serviced in this order
 
+	static void					GrowPool();
+	static void					FreePool();
 
 public:
 	static bool					initialized;
 
+								idEvent();
 								~idEvent();
 
 	static idEvent				*Alloc( const idEventDef *evdef, int numargs, va_list args );
@@ -116,6 +124,7 @@ public:
 	static void					ServiceFastEvents();
 	static void					Init();
 	static void					Shutdown();
+	static void					EventStats_f( const idCmdArgs &args );
 
 	// save games
 	static void					Save( idSaveGame *savefile );					// archives object for save game file
@@ -1425,6 +1425,43 @@ static void Cmd_AASStats_f( const idCmdArgs &args ) {
 	}
 }
 
+/*
+==================
+Cmd_AASRoutingBenchmark_f
+==================
+*/
+static void Cmd_AASRoutingBenchmark_f( const idCmdArgs &args ) {
+	int aasNum;
+
+	if ( !gameLocal.CheatsOk() ) {
+		return;
+	}
+
+	aasNum = aas_test.GetInteger();
+	idAAS *aas = gameLocal.GetAAS( aasNum );
+	if ( !aas ) {
+		gameLocal.Printf( "No aas #%d loaded\n", aasNum );
+	} else {
+		aas->RoutingBenchmark( args.Argc() > 1 ? atoi( args.Argv( 1 ) ) : 1000 );
+	}
+}
+
+/*
+==================
+Cmd_AASCacheStats_f
+==================
+*/
+static void Cmd_AASCacheStats_f( const idCmdArgs &args ) {
+	const bool reset = ( idStr::Icmp( args.Argv( 1 ), "reset" ) == 0 );
+
+	for ( int i = 0; i < gameLocal.NumAAS(); i++ ) {
+		idAAS *aas = gameLocal.GetAAS( i );
+		if ( aas ) {
+			aas->CacheStats( reset );
+		}
+	}
+}
+
 /*
 ==================
 Cmd_TestDamage_f
@@ -2295,6 +2332,7 @@ so it can perform tab completion
 void idGameLocal::InitConsoleCommands() {
 	cmdSystem->AddCommand( "game_memory",			idClass::DisplayInfo_f,		CMD_FL_GAME,				"displays game class info" );
 	cmdSystem->AddCommand( "listClasses",			idClass::ListClasses_f,		CMD_FL_GAME,				"lists game classes" );
+	cmdSystem->AddCommand( "eventStats",			idEvent::EventStats_f,		CMD_FL_GAME,				"shows the number of pending, live and peak events and the argument data usage" );
 	cmdSystem->AddCommand( "listThreads",			idThread::ListThreads_f,	CMD_FL_GAME|CMD_FL_CHEAT,	"lists script threads" );
 	cmdSystem->AddCommand( "listEntities",			Cmd_EntityList_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"lists game entities" );
 	cmdSystem->AddCommand( "listActiveEntities",	Cmd_ActiveEntityList_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"lists active game entities" );
@@ -2350,6 +2388,8 @@ void idGameLocal::InitConsoleCommands() {
 	cmdSystem->AddCommand( "reloadanims",			Cmd_ReloadAnims_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"reloads animations" );
 	cmdSystem->AddCommand( "listAnims",				Cmd_ListAnims_f,			CMD_FL_GAME,				"lists all animations" );
 	cmdSystem->AddCommand( "aasStats",				Cmd_AASStats_f,				CMD_FL_GAME,				"shows AAS stats" );
+	cmdSystem->AddCommand( "aasRoutingBenchmark",	Cmd_AASRoutingBenchmark_f,	CMD_FL_GAME|CMD_FL_CHEAT,	"times random route queries with lazy and precomputed routing tables, usage: aasRoutingBenchmark [numQueries]" );
+	cmdSystem->AddCommand( "aasCacheStats",			Cmd_AASCacheStats_f,		CMD_FL_GAME,				"shows AAS routing cache hit/miss stats, 'aasCacheStats reset' also resets the counters" );
 	cmdSystem->AddCommand( "testDamage",			Cmd_TestDamage_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"tests a damage def", idCmdSystem::ArgCompletion_Decl<DECL_ENTITYDEF> );
 	cmdSystem->AddCommand( "weaponSplat",			Cmd_WeaponSplat_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"projects a blood splat on the player weapon" );
 	cmdSystem->AddCommand( "saveSelected",			Cmd_SaveSelected_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"saves the selected entity to the .map file" );
@@ -119,6 +119,8 @@ idCVar g_showEnemies(				"g_showEnemies",			"0",			CVAR_GAME | CVAR_BOOL, "draws
 
 idCVar g_frametime(					"g_frametime",				"0",			CVAR_GAME | CVAR_BOOL, "displays timing information for each game frame" );
 idCVar g_timeentities(				"g_timeEntities",			"0",			CVAR_GAME | CVAR_FLOAT, "when non-zero, shows entities whose think functions exceeded the # of milliseconds specified" );
+idCVar g_parallelAnimators(			"g_parallelAnimators",		"1",			CVAR_GAME | CVAR_BOOL, "create the animation frames of the active entities in the player PVS over the job threads before the entities think" );
+idCVar g_showAnimatorFrames(		"g_showAnimatorFrames",		"0",			CVAR_GAME | CVAR_BOOL, "print the number of animation frames created before think and the time it took" );
 
 idCVar g_debugShockwave(			"g_debugShockwave",			"0",			CVAR_GAME | CVAR_BOOL, "Debug the shockwave" );
 
@@ -195,6 +197,8 @@ idCVar af_useLinearTime(			"af_useLinearTime",			"1",			CVAR_GAME | CVAR_BOOL, "
 idCVar af_useImpulseFriction(		"af_useImpulseFriction",	"0",			CVAR_GAME | CVAR_BOOL, "use impulse based contact friction" );
 idCVar af_useJointImpulseFriction(	"af_useJointImpulseFriction","0",			CVAR_GAME | CVAR_BOOL, "use impulse based joint friction" );
 idCVar af_useSymmetry(				"af_useSymmetry",			"1",			CVAR_GAME | CVAR_BOOL, "use constraint matrix symmetry" );
+idCVar af_useIterativeLCP(			"af_useIterativeLCP",		"0",			CVAR_GAME | CVAR_BOOL, "solve auxiliary constraints with the sparse Gauss-Seidel solver warm started from the previous frame" );
+idCVar af_lcpIterations(			"af_lcpIterations",			"16",			CVAR_GAME | CVAR_INTEGER, "maximum number of iterations of the iterative LCP solver", 1, 256 );
 idCVar af_skipSelfCollision(		"af_skipSelfCollision",		"0",			CVAR_GAME | CVAR_BOOL, "skip self collision detection" );
 idCVar af_skipLimits(				"af_skipLimits",			"0",			CVAR_GAME | CVAR_BOOL, "skip joint limits" );
 idCVar af_skipFriction(				"af_skipFriction",			"0",			CVAR_GAME | CVAR_BOOL, "skip friction" );
@@ -206,6 +210,8 @@ idCVar af_jointFrictionScale(		"af_jointFrictionScale",	"0",			CVAR_GAME | CVAR_
 idCVar af_contactFrictionScale(		"af_contactFrictionScale",	"0",			CVAR_GAME | CVAR_FLOAT, "scales the contact friction" );
 idCVar af_highlightBody(			"af_highlightBody",			"",				CVAR_GAME, "name of the body to highlight" );
 idCVar af_highlightConstraint(		"af_highlightConstraint",	"",				CVAR_GAME, "name of the constraint to highlight" );
+idCVar af_parallelIslands(			"af_parallelIslands",		"0",			CVAR_GAME | CVAR_BOOL, "solve the constraints of the active articulated figures over the job threads before the entities think, changes made to the figures during think are applied a frame later" );
+idCVar af_showIslands(				"af_showIslands",			"0",			CVAR_GAME | CVAR_BOOL, "print the number of articulated figures solved before think and the time it took" );
 idCVar af_showTimings(				"af_showTimings",			"0",			CVAR_GAME | CVAR_BOOL, "show articulated figure cpu usage" );
 idCVar af_showConstraints(			"af_showConstraints",		"0",			CVAR_GAME | CVAR_BOOL, "show constraints" );
 idCVar af_showConstraintNames(		"af_showConstraintNames",	"0",			CVAR_GAME | CVAR_BOOL, "show constraint names" );
@@ -307,6 +313,8 @@ idCVar aas_pullPlayer(				"aas_pullPlayer",			"0",			CVAR_GAME | CVAR_INTEGER, "
 idCVar aas_randomPullPlayer(		"aas_randomPullPlayer",		"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar aas_goalArea(				"aas_goalArea",				"0",			CVAR_GAME | CVAR_INTEGER, "" );
 idCVar aas_showPushIntoArea(		"aas_showPushIntoArea",		"0",			CVAR_GAME | CVAR_BOOL, "" );
+idCVar aas_precomputeRouting(		"aas_precomputeRouting",	"0",			CVAR_GAME | CVAR_BOOL, "precompute the routing towards all cluster portals over the job threads when the AAS is loaded" );
+idCVar aas_routingCacheSize(		"aas_routingCacheSize",		"2048",			CVAR_GAME | CVAR_INTEGER, "memory budget in KB for the routing cache of each AAS, the least recently used cache is freed first", 64, 65536 );
 
 idCVar g_countDown(					"g_countDown",				"15",			CVAR_GAME | CVAR_INTEGER | CVAR_ARCHIVE, "pregame countdown in seconds", 4, 3600 );
 idCVar g_gameReviewPause(			"g_gameReviewPause",		"10",			CVAR_GAME | CVAR_NETWORKSYNC | CVAR_INTEGER | CVAR_ARCHIVE, "scores review time in seconds (at end game)", 2, 3600 );
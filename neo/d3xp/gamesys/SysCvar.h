@@ -79,6 +79,8 @@ extern idCVar	g_showEnemies;
 
 extern idCVar	g_frametime;
 extern idCVar	g_timeentities;
+extern idCVar	g_parallelAnimators;
+extern idCVar	g_showAnimatorFrames;
 
 extern idCVar	ai_debugScript;
 extern idCVar	ai_debugMove;
@@ -124,6 +126,8 @@ extern idCVar	af_useLinearTime;
 extern idCVar	af_useImpulseFriction;
 extern idCVar	af_useJointImpulseFriction;
 extern idCVar	af_useSymmetry;
+extern idCVar	af_useIterativeLCP;
+extern idCVar	af_lcpIterations;
 extern idCVar	af_skipSelfCollision;
 extern idCVar	af_skipLimits;
 extern idCVar	af_skipFriction;
@@ -135,6 +139,8 @@ extern idCVar	af_jointFrictionScale;
 extern idCVar	af_contactFrictionScale;
 extern idCVar	af_highlightBody;
 extern idCVar	af_highlightConstraint;
+extern idCVar	af_parallelIslands;
+extern idCVar	af_showIslands;
 extern idCVar	af_showTimings;
 extern idCVar	af_showConstraints;
 extern idCVar	af_showConstraintNames;
@@ -249,6 +255,8 @@ extern idCVar	aas_pullPlayer;
 extern idCVar	aas_randomPullPlayer;
 extern idCVar	aas_goalArea;
 extern idCVar	aas_showPushIntoArea;
+extern idCVar	aas_routingCacheSize;
+extern idCVar	aas_precomputeRouting;
 
 extern idCVar	net_clientPredictGUI;
 
@@ -0,0 +1,205 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").  
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#pragma hdrstop
+#include "../../idlib/precompiled.h"
+
+#include "../Game_local.h"
+
+/*
+================
+AF_SolveIslandsJob
+================
+*/
+void AF_SolveIslandsJob( afIslandParms_t *parms ) {
+	for ( int i = 0; i < parms->numFigures; i++ ) {
+		parms->figures[i]->SolveConstraints();
+	}
+}
+REGISTER_PARALLEL_JOB( AF_SolveIslandsJob, "AF_SolveIslandsJob" );
+
+/*
+================
+idAFIslands::idAFIslands
+================
+*/
+idAFIslands::idAFIslands() {
+	jobList = NULL;
+	timeStepMSec = 0;
+	endTimeMSec = 0;
+	numIslands = 0;
+	microseconds = 0;
+}
+
+/*
+================
+idAFIslands::~idAFIslands
+================
+*/
+idAFIslands::~idAFIslands() {
+	assert( jobList == NULL );
+}
+
+/*
+================
+idAFIslands::Init
+================
+*/
+void idAFIslands::Init() {
+	if ( jobList == NULL ) {
+		jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, MAX_JOBS, 0, NULL );
+	}
+	entities.SetGranularity( 32 );
+	figures.SetGranularity( 32 );
+}
+
+/*
+================
+idAFIslands::Shutdown
+================
+*/
+void idAFIslands::Shutdown() {
+	if ( jobList != NULL ) {
+		parallelJobManager->FreeJobList( jobList );
+		jobList = NULL;
+	}
+	entities.Clear();
+	figures.Clear();
+}
+
+/*
+================
+idAFIslands::Begin
+================
+*/
+void idAFIslands::Begin( int timeStep, int endTime ) {
+	timeStepMSec = timeStep;
+	endTimeMSec = endTime;
+	entities.SetNum( 0 );
+	figures.SetNum( 0 );
+}
+
+/*
+================
+idAFIslands::AddEntity
+
+  the entity must be the master of its team and run the articulated figure physics
+================
+*/
+void idAFIslands::AddEntity( idEntity *ent ) {
+	assert( ent->GetPhysics()->IsType( idPhysics_AF::Type ) );
+	entities.Append( ent );
+}
+
+/*
+================
+idAFIslands::DisableTeamClip
+
+  same as idEntity::RunPhysics so the figure doesn't collide with its own team
+================
+*/
+void idAFIslands::DisableTeamClip( idEntity *ent ) const {
+	for ( idEntity *part = ent; part != NULL; part = part->GetNextTeamEntity() ) {
+		if ( !part->fl.solidForTeam ) {
+			part->GetPhysics()->DisableClip();
+		}
+	}
+}
+
+/*
+================
+idAFIslands::EnableTeamClip
+================
+*/
+void idAFIslands::EnableTeamClip( idEntity *ent ) const {
+	for ( idEntity *part = ent; part != NULL; part = part->GetNextTeamEntity() ) {
+		if ( !part->fl.solidForTeam ) {
+			part->GetPhysics()->EnableClip();
+		}
+	}
+}
+
+/*
+================
+idAFIslands::Evaluate
+================
+*/
+void idAFIslands::Evaluate() {
+	int i;
+
+	const uint64 startTime = Sys_Microseconds();
+
+	// set up the contacts of all figures before any of them moves
+	int numEntities = 0;
+	for ( i = 0; i < entities.Num(); i++ ) {
+		idEntity *ent = entities[i];
+		idPhysics_AF *af = static_cast<idPhysics_AF *>( ent->GetPhysics() );
+
+		DisableTeamClip( ent );
+		if ( af->BeginEvaluate( timeStepMSec, endTimeMSec ) ) {
+			entities[numEntities++] = ent;
+			figures.Append( af );
+		} else {
+			af->StoreEvaluateResult( endTimeMSec, false );
+		}
+		EnableTeamClip( ent );
+	}
+	entities.SetNum( numEntities );
+
+	numIslands = figures.Num();
+
+	const int numJobs = ( jobList != NULL ) ? Min( MAX_JOBS, numIslands ) : 0;
+	if ( numJobs <= 1 ) {
+		for ( i = 0; i < numIslands; i++ ) {
+			figures[i]->SolveConstraints();
+		}
+	} else {
+		int first = 0;
+		for ( i = 0; i < numJobs; i++ ) {
+			const int last = ( numIslands * ( i + 1 ) ) / numJobs;
+			parms[i].figures = figures.Ptr() + first;
+			parms[i].numFigures = last - first;
+			jobList->AddJob( (jobRun_t)AF_SolveIslandsJob, &parms[i] );
+			first = last;
+		}
+		jobList->Submit();
+		jobList->Wait();
+	}
+
+	// collisions move other entities so handle them in entity order
+	for ( i = 0; i < numIslands; i++ ) {
+		DisableTeamClip( entities[i] );
+		const bool moved = figures[i]->EndEvaluate();
+		EnableTeamClip( entities[i] );
+		figures[i]->StoreEvaluateResult( endTimeMSec, moved );
+	}
+
+	entities.SetNum( 0 );
+	figures.SetNum( 0 );
+	microseconds = (int)( Sys_Microseconds() - startTime );
+}
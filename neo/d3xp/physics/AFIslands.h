@@ -0,0 +1,87 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").  
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+
+#ifndef __AFISLANDS_H__
+#define __AFISLANDS_H__
+
+/*
+===============================================================================
+
+	idAFIslands
+
+	Solves the constraints of independent articulated figures over the job threads
+	before the entities think.  Contacts and collisions involve other entities and are
+	handled on the game thread in entity order, only the constraint solve of each
+	figure runs in parallel.  Every figure is an island during the solve because its
+	contacts with the world and other entities are fixed before it starts.
+
+===============================================================================
+*/
+
+class idEntity;
+class idPhysics_AF;
+class idParallelJobList;
+
+struct afIslandParms_t {
+	idPhysics_AF **				figures;
+	int							numFigures;
+};
+
+class idAFIslands {
+public:
+								idAFIslands();
+								~idAFIslands();
+
+	void						Init();
+	void						Shutdown();
+
+	void						Begin( int timeStepMSec, int endTimeMSec );
+	void						AddEntity( idEntity *ent );
+	void						Evaluate();
+
+	int							NumIslands() const { return numIslands; }
+	int							Microseconds() const { return microseconds; }
+
+private:
+	static const int			MAX_JOBS = 32;
+
+	idParallelJobList *			jobList;
+	idList<idEntity *, TAG_IDLIB_LIST_PHYSICS>		entities;
+	idList<idPhysics_AF *, TAG_IDLIB_LIST_PHYSICS>	figures;
+	afIslandParms_t				parms[MAX_JOBS];
+	int							timeStepMSec;
+	int							endTimeMSec;
+	int							numIslands;
+	int							microseconds;
+
+	void						DisableTeamClip( idEntity *ent ) const;
+	void						EnableTeamClip( idEntity *ent ) const;
+};
+
+#endif /* !__AFISLANDS_H__ */
@@ -32,23 +32,34 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "../Game_local.h"
 
-#define	MAX_SECTOR_DEPTH				12
-#define MAX_SECTORS						((1<<(MAX_SECTOR_DEPTH+1))-1)
-
-typedef struct clipSector_s {
-	int						axis;		// -1 = leaf node
-	float					dist;
-	struct clipSector_s *	children[2];
-	struct clipLink_s *		clipLinks;
-} clipSector_t;
-
-typedef struct clipLink_s {
-	idClipModel *			clipModel;
-	struct clipSector_s *	sector;
-	struct clipLink_s *		prevInSector;
-	struct clipLink_s *		nextInSector;
-	struct clipLink_s *		nextLink;
-} clipLink_t;
+#define MAX_CLIP_GRID_SIZE				64			// maximum number of grid cells along the x and y axis
+#define MIN_CLIP_CELL_SIZE				128.0f
+#define CLIP_BLOCK_SIZE					4
+
+// clip models in SoA layout so the bounds of a whole block can be tested at once
+typedef struct clipBlock_s {
+	ALIGN16( float			mins[3][CLIP_BLOCK_SIZE] );
+	ALIGN16( float			maxs[3][CLIP_BLOCK_SIZE] );
+	ALIGN16( int			contents[CLIP_BLOCK_SIZE] );	// zero for disabled clip models
+	idClipModel *			clipModels[CLIP_BLOCK_SIZE];
+} clipBlock_t;
+
+typedef struct clipCell_s {
+	idList<clipBlock_t, TAG_PHYSICS_CLIP>	blocks;
+	int						numClipModels;
+} clipCell_t;
+
+// scratch space of TracePacket, too large for the stack
+typedef struct tracePacket_s {
+	idClipModel *			clipModelList[MAX_GENTITIES];
+	idVec3					starts[MAX_TRACE_BATCH];
+	idVec3					ends[MAX_TRACE_BATCH];
+	int						pointNums[MAX_TRACE_BATCH];
+	int						subsetNums[MAX_TRACE_BATCH];
+	bool					isPoint[MAX_TRACE_BATCH];
+	idBounds				traceBounds[MAX_TRACE_BATCH];
+	trace_t					subsetResults[MAX_TRACE_BATCH];
+} tracePacket_t;
 
 typedef struct trmCache_s {
 	idTraceModel			trm;
@@ -60,8 +71,6 @@ typedef struct trmCache_s {
 
 idVec3 vec3_boxEpsilon( CM_BOX_EPSILON, CM_BOX_EPSILON, CM_BOX_EPSILON );
 
-idBlockAlloc<clipLink_t, 1024>	clipLinkAllocator;
-
 
 /*
 ===============================================================
@@ -357,8 +366,9 @@ void idClipModel::Init() {
 	collisionModelHandle = 0;
 	renderModelHandle = -1;
 	traceModelIndex = -1;
-	clipLinks = NULL;
-	touchCount = -1;
+	linkedClip = NULL;
+	clipCell = -1;
+	clipSlot = -1;
 }
 
 /*
@@ -433,8 +443,9 @@ idClipModel::idClipModel( const idClipModel *model ) {
 		LoadModel( *GetCachedTraceModel( model->traceModelIndex ) );
 	}
 	renderModelHandle = model->renderModelHandle;
-	clipLinks = NULL;
-	touchCount = -1;
+	linkedClip = NULL;
+	clipCell = -1;
+	clipSlot = -1;
 }
 
 /*
@@ -473,8 +484,8 @@ void idClipModel::Save( idSaveGame *savefile ) const {
 	}
 	savefile->WriteInt( traceModelIndex );
 	savefile->WriteInt( renderModelHandle );
-	savefile->WriteBool( clipLinks != NULL );
-	savefile->WriteInt( touchCount );
+	savefile->WriteBool( clipCell != -1 );
+	savefile->WriteInt( -1 );	// was the touch count of the sector tree
 }
 
 /*
@@ -509,12 +520,14 @@ void idClipModel::Restore( idRestoreGame *savefile ) {
 	}
 	savefile->ReadInt( renderModelHandle );
 	savefile->ReadBool( linked );
-	savefile->ReadInt( touchCount );
+	int unusedTouchCount;
+	savefile->ReadInt( unusedTouchCount );
 
 	// the render model will be set when the clip model is linked
 	renderModelHandle = -1;
-	clipLinks = NULL;
-	touchCount = -1;
+	linkedClip = NULL;
+	clipCell = -1;
+	clipSlot = -1;
 
 	if ( linked ) {
 		Link( gameLocal.clip, entity, id, origin, axis, renderModelHandle );
@@ -527,7 +540,7 @@ idClipModel::SetPosition
 ================
 */
 void idClipModel::SetPosition( const idVec3 &newOrigin, const idMat3 &newAxis ) {
-	if ( clipLinks ) {
+	if ( clipCell != -1 ) {
 		Unlink();	// unlink from old position
 	}
 	origin = newOrigin;
@@ -574,52 +587,19 @@ idClipModel::Unlink
 ===============
 */
 void idClipModel::Unlink() {
-	clipLink_t *link;
-
-	for ( link = clipLinks; link; link = clipLinks ) {
-		clipLinks = link->nextLink;
-		if ( link->prevInSector ) {
-			link->prevInSector->nextInSector = link->nextInSector;
-		} else {
-			link->sector->clipLinks = link->nextInSector;
-		}
-		if ( link->nextInSector ) {
-			link->nextInSector->prevInSector = link->prevInSector;
-		}
-		clipLinkAllocator.Free( link );
+	if ( clipCell != -1 ) {
+		linkedClip->UnlinkClipModel( this );
 	}
 }
 
 /*
 ===============
-idClipModel::Link_r
+idClipModel::UpdateClipCellContents
 ===============
 */
-void idClipModel::Link_r( struct clipSector_s *node ) {
-	clipLink_t *link;
-
-	while( node->axis != -1 ) {
-		if ( absBounds[0][node->axis] > node->dist ) {
-			node = node->children[0];
-		} else if ( absBounds[1][node->axis] < node->dist ) {
-			node = node->children[1];
-		} else {
-			Link_r( node->children[0] );
-			node = node->children[1];
-		}
-	}
-
-	link = clipLinkAllocator.Alloc();
-	link->clipModel = this;
-	link->sector = node;
-	link->nextInSector = node->clipLinks;
-	link->prevInSector = NULL;
-	if ( node->clipLinks ) {
-		node->clipLinks->prevInSector = link;
-	}
-	node->clipLinks = link;
-	link->nextLink = clipLinks;
-	clipLinks = link;
+void idClipModel::UpdateClipCellContents() {
+	clipBlock_t &block = linkedClip->clipCells[clipCell].blocks[clipSlot / CLIP_BLOCK_SIZE];
+	block.contents[clipSlot % CLIP_BLOCK_SIZE] = enabled ? contents : 0;
 }
 
 /*
@@ -634,7 +614,7 @@ void idClipModel::Link( idClip &clp ) {
 		return;
 	}
 
-	if ( clipLinks ) {
+	if ( clipCell != -1 ) {
 		Unlink();	// unlink from old position
 	}
 
@@ -657,7 +637,7 @@ void idClipModel::Link( idClip &clp ) {
 	absBounds[0] -= vec3_boxEpsilon;
 	absBounds[1] += vec3_boxEpsilon;
 
-	Link_r( clp.clipSectors );
+	clp.LinkClipModel( this );
 }
 
 /*
@@ -705,60 +685,15 @@ idClip::idClip
 ===============
 */
 idClip::idClip() {
-	numClipSectors = 0;
-	clipSectors = NULL;
 	worldBounds.Zero();
+	gridOrigin.Zero();
+	gridCellSize = gridInvCellSize = 0.0f;
+	gridSize[0] = gridSize[1] = 0;
+	numClipCells = 0;
+	clipCells = NULL;
+	tracePacket = NULL;
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
-}
-
-/*
-===============
-idClip::CreateClipSectors_r
-
-Builds a uniformly subdivided tree for the given world size
-===============
-*/
-clipSector_t *idClip::CreateClipSectors_r( const int depth, const idBounds &bounds, idVec3 &maxSector ) {
-	int				i;
-	clipSector_t	*anode;
-	idVec3			size;
-	idBounds		front, back;
-
-	anode = &clipSectors[idClip::numClipSectors];
-	idClip::numClipSectors++;
-
-	if ( depth == MAX_SECTOR_DEPTH ) {
-		anode->axis = -1;
-		anode->children[0] = anode->children[1] = NULL;
-
-		for ( i = 0; i < 3; i++ ) {
-			if ( bounds[1][i] - bounds[0][i] > maxSector[i] ) {
-				maxSector[i] = bounds[1][i] - bounds[0][i];
-			}
-		}
-		return anode;
-	}
-
-	size = bounds[1] - bounds[0];
-	if ( size[0] >= size[1] && size[0] >= size[2] ) {
-		anode->axis = 0;
-	} else if ( size[1] >= size[0] && size[1] >= size[2] ) {
-		anode->axis = 1;
-	} else {
-		anode->axis = 2;
-	}
-
-	anode->dist = 0.5f * ( bounds[1][anode->axis] + bounds[0][anode->axis] );
-
-	front = bounds;
-	back = bounds;
-	
-	front[0][anode->axis] = back[1][anode->axis] = anode->dist;
-	
-	anode->children[0] = CreateClipSectors_r( depth+1, front, maxSector );
-	anode->children[1] = CreateClipSectors_r( depth+1, back, maxSector );
-
-	return anode;
+	numTouchQueries = numTouchCells = numTouchTests = numTouchModels = 0;
 }
 
 /*
@@ -768,28 +703,37 @@ idClip::Init
 */
 void idClip::Init() {
 	cmHandle_t h;
-	idVec3 size, maxSector = vec3_origin;
+	idVec3 size;
 
-	// clear clip sectors
-	clipSectors = new (TAG_PHYSICS_CLIP) clipSector_t[MAX_SECTORS];
-	memset( clipSectors, 0, MAX_SECTORS * sizeof( clipSector_t ) );
-	numClipSectors = 0;
-	touchCount = -1;
 	// get world map bounds
 	h = collisionModelManager->LoadModel( "worldMap" );
 	collisionModelManager->GetModelBounds( h, worldBounds );
-	// create world sectors
-	CreateClipSectors_r( 0, worldBounds, maxSector );
 
+	// create the clip grid over the xy plane of the world
 	size = worldBounds[1] - worldBounds[0];
+	gridOrigin.Set( worldBounds[0][0], worldBounds[0][1] );
+	gridCellSize = Max( MIN_CLIP_CELL_SIZE, Max( size[0], size[1] ) / MAX_CLIP_GRID_SIZE );
+	gridInvCellSize = 1.0f / gridCellSize;
+	for ( int i = 0; i < 2; i++ ) {
+		gridSize[i] = idMath::ClampInt( 1, MAX_CLIP_GRID_SIZE, idMath::Ftoi( idMath::Ceil( size[i] * gridInvCellSize ) ) );
+	}
+	// one extra cell for the clip models that are too large for the grid
+	numClipCells = gridSize[0] * gridSize[1] + 1;
+	clipCells = new (TAG_PHYSICS_CLIP) clipCell_t[numClipCells];
+	for ( int i = 0; i < numClipCells; i++ ) {
+		clipCells[i].numClipModels = 0;
+	}
+	tracePacket = new (TAG_PHYSICS_CLIP) tracePacket_t;
+
 	gameLocal.Printf( "map bounds are (%1.1f, %1.1f, %1.1f)\n", size[0], size[1], size[2] );
-	gameLocal.Printf( "max clip sector is (%1.1f, %1.1f, %1.1f)\n", maxSector[0], maxSector[1], maxSector[2] );
+	gameLocal.Printf( "clip grid is %d x %d cells of %1.1f units\n", gridSize[0], gridSize[1], gridCellSize );
 
 	// initialize a default clip model
 	defaultClipModel.LoadModel( idTraceModel( idBounds( idVec3( 0, 0, 0 ) ).Expand( 8 ) ) );
 
 	// set counters to zero
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
+	numTouchQueries = numTouchCells = numTouchTests = numTouchModels = 0;
 }
 
 /*
@@ -798,8 +742,23 @@ idClip::Shutdown
 ===============
 */
 void idClip::Shutdown() {
-	delete[] clipSectors;
-	clipSectors = NULL;
+	// make sure no clip model still references the grid
+	for ( int i = 0; i < numClipCells; i++ ) {
+		clipCell_t &cell = clipCells[i];
+		for ( int j = 0; j < cell.numClipModels; j++ ) {
+			idClipModel *mdl = cell.blocks[j / CLIP_BLOCK_SIZE].clipModels[j % CLIP_BLOCK_SIZE];
+			mdl->linkedClip = NULL;
+			mdl->clipCell = -1;
+			mdl->clipSlot = -1;
+		}
+	}
+
+	delete[] clipCells;
+	clipCells = NULL;
+	numClipCells = 0;
+
+	delete tracePacket;
+	tracePacket = NULL;
 
 	// free the trace model used for the temporaryClipModel
 	if ( temporaryClipModel.traceModelIndex != -1 ) {
@@ -812,13 +771,102 @@ void idClip::Shutdown() {
 		idClipModel::FreeTraceModel( defaultClipModel.traceModelIndex );
 		defaultClipModel.traceModelIndex = -1;
 	}
+}
+
+/*
+===============
+idClip::LinkClipModel
+
+Adds the clip model to the grid cell that contains the center of its absolute bounds.
+Clip models that extend more than a cell beyond their center go into the large model cell.
+===============
+*/
+void idClip::LinkClipModel( idClipModel *mdl ) {
+	const idBounds &absBounds = mdl->absBounds;
+	int cellNum;
+
+	if (	absBounds[1][0] - absBounds[0][0] > 2.0f * gridCellSize ||
+			absBounds[1][1] - absBounds[0][1] > 2.0f * gridCellSize ) {
+		cellNum = numClipCells - 1;
+	} else {
+		int x = idMath::Ftoi( idMath::Floor( ( 0.5f * ( absBounds[0][0] + absBounds[1][0] ) - gridOrigin[0] ) * gridInvCellSize ) );
+		int y = idMath::Ftoi( idMath::Floor( ( 0.5f * ( absBounds[0][1] + absBounds[1][1] ) - gridOrigin[1] ) * gridInvCellSize ) );
+		x = idMath::ClampInt( 0, gridSize[0] - 1, x );
+		y = idMath::ClampInt( 0, gridSize[1] - 1, y );
+		cellNum = y * gridSize[0] + x;
+	}
+
+	clipCell_t &cell = clipCells[cellNum];
+	const int slot = cell.numClipModels++;
+	const int lane = slot % CLIP_BLOCK_SIZE;
+
+	if ( slot / CLIP_BLOCK_SIZE >= cell.blocks.Num() ) {
+		clipBlock_t &newBlock = cell.blocks.Alloc();
+		for ( int i = 0; i < CLIP_BLOCK_SIZE; i++ ) {
+			for ( int j = 0; j < 3; j++ ) {
+				newBlock.mins[j][i] = idMath::INFINITY;
+				newBlock.maxs[j][i] = -idMath::INFINITY;
+			}
+			newBlock.contents[i] = 0;
+			newBlock.clipModels[i] = NULL;
+		}
+	}
+
+	clipBlock_t &block = cell.blocks[slot / CLIP_BLOCK_SIZE];
+	for ( int j = 0; j < 3; j++ ) {
+		block.mins[j][lane] = absBounds[0][j];
+		block.maxs[j][lane] = absBounds[1][j];
+	}
+	block.contents[lane] = mdl->enabled ? mdl->contents : 0;
+	block.clipModels[lane] = mdl;
 
-	clipLinkAllocator.Shutdown();
+	mdl->linkedClip = this;
+	mdl->clipCell = cellNum;
+	mdl->clipSlot = slot;
+}
+
+/*
+===============
+idClip::UnlinkClipModel
+
+Moves the last clip model of the cell into the slot of the removed clip model.
+===============
+*/
+void idClip::UnlinkClipModel( idClipModel *mdl ) {
+	assert( mdl->linkedClip == this && mdl->clipCell >= 0 && mdl->clipCell < numClipCells );
+
+	clipCell_t &cell = clipCells[mdl->clipCell];
+	const int last = --cell.numClipModels;
+	clipBlock_t &lastBlock = cell.blocks[last / CLIP_BLOCK_SIZE];
+	const int lastLane = last % CLIP_BLOCK_SIZE;
+
+	if ( mdl->clipSlot != last ) {
+		clipBlock_t &block = cell.blocks[mdl->clipSlot / CLIP_BLOCK_SIZE];
+		const int lane = mdl->clipSlot % CLIP_BLOCK_SIZE;
+		for ( int j = 0; j < 3; j++ ) {
+			block.mins[j][lane] = lastBlock.mins[j][lastLane];
+			block.maxs[j][lane] = lastBlock.maxs[j][lastLane];
+		}
+		block.contents[lane] = lastBlock.contents[lastLane];
+		block.clipModels[lane] = lastBlock.clipModels[lastLane];
+		block.clipModels[lane]->clipSlot = mdl->clipSlot;
+	}
+
+	for ( int j = 0; j < 3; j++ ) {
+		lastBlock.mins[j][lastLane] = idMath::INFINITY;
+		lastBlock.maxs[j][lastLane] = -idMath::INFINITY;
+	}
+	lastBlock.contents[lastLane] = 0;
+	lastBlock.clipModels[lastLane] = NULL;
+
+	mdl->linkedClip = NULL;
+	mdl->clipCell = -1;
+	mdl->clipSlot = -1;
 }
 
 /*
 ====================
-idClip::ClipModelsTouchingBounds_r
+idClip::ClipModelsTouchingBoundsInCell
 ====================
 */
 typedef struct listParms_s {
@@ -827,58 +875,75 @@ typedef struct listParms_s {
 	idClipModel	**	list;
 	int				count;
 	int				maxCount;
+	int				numCells;
+	int				numTests;
 } listParms_t;
 
-void idClip::ClipModelsTouchingBounds_r( const struct clipSector_s *node, listParms_t &parms ) const {
+void idClip::ClipModelsTouchingBoundsInCell( const clipCell_t &cell, listParms_t &parms ) const {
+	const int numBlocks = ( cell.numClipModels + CLIP_BLOCK_SIZE - 1 ) / CLIP_BLOCK_SIZE;
 
-	while( node->axis != -1 ) {
-		if ( parms.bounds[0][node->axis] > node->dist ) {
-			node = node->children[0];
-		} else if ( parms.bounds[1][node->axis] < node->dist ) {
-			node = node->children[1];
-		} else {
-			ClipModelsTouchingBounds_r( node->children[0], parms );
-			node = node->children[1];
-		}
-	}
+	parms.numCells++;
+	parms.numTests += cell.numClipModels;
 
-	for ( clipLink_t *link = node->clipLinks; link; link = link->nextInSector ) {
-		idClipModel	*check = link->clipModel;
+#ifdef ID_WIN_X86_SSE2_INTRIN
 
-		// if the clip model is enabled
-		if ( !check->enabled ) {
-			continue;
-		}
+	const __m128 qminX = _mm_set1_ps( parms.bounds[0][0] );
+	const __m128 qminY = _mm_set1_ps( parms.bounds[0][1] );
+	const __m128 qminZ = _mm_set1_ps( parms.bounds[0][2] );
+	const __m128 qmaxX = _mm_set1_ps( parms.bounds[1][0] );
+	const __m128 qmaxY = _mm_set1_ps( parms.bounds[1][1] );
+	const __m128 qmaxZ = _mm_set1_ps( parms.bounds[1][2] );
 
-		// avoid duplicates in the list
-		if ( check->touchCount == touchCount ) {
-			continue;
-		}
+	for ( int i = 0; i < numBlocks; i++ ) {
+		const clipBlock_t &block = cell.blocks[i];
 
-		// if the clip model does not have any contents we are looking for
-		if ( !( check->contents & parms.contentMask ) ) {
-			continue;
-		}
+		__m128 overlap = _mm_and_ps( _mm_cmple_ps( _mm_load_ps( block.mins[0] ), qmaxX ), _mm_cmpge_ps( _mm_load_ps( block.maxs[0] ), qminX ) );
+		overlap = _mm_and_ps( overlap, _mm_and_ps( _mm_cmple_ps( _mm_load_ps( block.mins[1] ), qmaxY ), _mm_cmpge_ps( _mm_load_ps( block.maxs[1] ), qminY ) ) );
+		overlap = _mm_and_ps( overlap, _mm_and_ps( _mm_cmple_ps( _mm_load_ps( block.mins[2] ), qmaxZ ), _mm_cmpge_ps( _mm_load_ps( block.maxs[2] ), qminZ ) ) );
 
-		// if the bounds really do overlap
-		if (	check->absBounds[0][0] > parms.bounds[1][0] ||
-				check->absBounds[1][0] < parms.bounds[0][0] ||
-				check->absBounds[0][1] > parms.bounds[1][1] ||
-				check->absBounds[1][1] < parms.bounds[0][1] ||
-				check->absBounds[0][2] > parms.bounds[1][2] ||
-				check->absBounds[1][2] < parms.bounds[0][2] ) {
-			continue;
+		int mask = _mm_movemask_ps( overlap );
+		for ( int lane = 0; mask != 0; lane++, mask >>= 1 ) {
+			if ( !( mask & 1 ) || !( block.contents[lane] & parms.contentMask ) ) {
+				continue;
+			}
+			if ( parms.count >= parms.maxCount ) {
+				gameLocal.Warning( "idClip::ClipModelsTouchingBoundsInCell: max count" );
+				return;
+			}
+			parms.list[parms.count++] = block.clipModels[lane];
 		}
+	}
 
-		if ( parms.count >= parms.maxCount ) {
-			gameLocal.Warning( "idClip::ClipModelsTouchingBounds_r: max count" );
-			return;
-		}
+#else
 
-		check->touchCount = touchCount;
-		parms.list[parms.count] = check;
-		parms.count++;
+	for ( int i = 0; i < numBlocks; i++ ) {
+		const clipBlock_t &block = cell.blocks[i];
+
+		for ( int lane = 0; lane < CLIP_BLOCK_SIZE; lane++ ) {
+			// if the clip model is enabled and has any contents we are looking for
+			if ( !( block.contents[lane] & parms.contentMask ) ) {
+				continue;
+			}
+
+			// if the bounds really do overlap
+			if (	block.mins[0][lane] > parms.bounds[1][0] ||
+					block.maxs[0][lane] < parms.bounds[0][0] ||
+					block.mins[1][lane] > parms.bounds[1][1] ||
+					block.maxs[1][lane] < parms.bounds[0][1] ||
+					block.mins[2][lane] > parms.bounds[1][2] ||
+					block.maxs[2][lane] < parms.bounds[0][2] ) {
+				continue;
+			}
+
+			if ( parms.count >= parms.maxCount ) {
+				gameLocal.Warning( "idClip::ClipModelsTouchingBoundsInCell: max count" );
+				return;
+			}
+			parms.list[parms.count++] = block.clipModels[lane];
+		}
 	}
+
+#endif
 }
 
 /*
@@ -892,7 +957,7 @@ int idClip::ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, i
 	if (	bounds[0][0] > bounds[1][0] ||
 			bounds[0][1] > bounds[1][1] ||
 			bounds[0][2] > bounds[1][2] ) {
-		// we should not go through the tree for degenerate or backwards bounds
+		// we should not go through the grid for degenerate or backwards bounds
 		assert( false );
 		return 0;
 	}
@@ -903,9 +968,35 @@ int idClip::ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, i
 	parms.list = clipModelList;
 	parms.count = 0;
 	parms.maxCount = maxCount;
+	parms.numCells = 0;
+	parms.numTests = 0;
+
+	// the clip models in a cell extend at most one cell size beyond the cell
+	int cellMin[2], cellMax[2];
+	for ( int i = 0; i < 2; i++ ) {
+		cellMin[i] = idMath::Ftoi( idMath::Floor( ( parms.bounds[0][i] - gridCellSize - gridOrigin[i] ) * gridInvCellSize ) );
+		cellMax[i] = idMath::Ftoi( idMath::Floor( ( parms.bounds[1][i] + gridCellSize - gridOrigin[i] ) * gridInvCellSize ) );
+		cellMin[i] = idMath::ClampInt( 0, gridSize[i] - 1, cellMin[i] );
+		cellMax[i] = idMath::ClampInt( 0, gridSize[i] - 1, cellMax[i] );
+	}
+
+	for ( int y = cellMin[1]; y <= cellMax[1]; y++ ) {
+		for ( int x = cellMin[0]; x <= cellMax[0]; x++ ) {
+			const clipCell_t &cell = clipCells[y * gridSize[0] + x];
+			if ( cell.numClipModels > 0 ) {
+				ClipModelsTouchingBoundsInCell( cell, parms );
+			}
+		}
+	}
+	ClipModelsTouchingBoundsInCell( clipCells[numClipCells - 1], parms );
 
-	touchCount++;
-	ClipModelsTouchingBounds_r( clipSectors, parms );
+	// the queries can run on the job threads, only the main thread keeps statistics
+	if ( idLib::IsMainThread() ) {
+		numTouchQueries++;
+		numTouchCells += parms.numCells;
+		numTouchTests += parms.numTests;
+		numTouchModels += parms.count;
+	}
 
 	return parms.count;
 }
@@ -1207,6 +1298,211 @@ bool idClip::Translation( trace_t &results, const idVec3 &start, const idVec3 &e
 	return ( results.fraction < 1.0f );
 }
 
+/*
+============
+idClip::TraceBatch
+============
+*/
+int idClip::TraceBatch( trace_t *results, const clipTrace_t *traces, const int numTraces, int contentMask, const idEntity *passEntity ) {
+	int numHits = 0;
+
+	for ( int first = 0; first < numTraces; first += MAX_TRACE_BATCH ) {
+		numHits += TracePacket( results + first, traces + first, Min( numTraces - first, MAX_TRACE_BATCH ), contentMask, passEntity );
+	}
+	return numHits;
+}
+
+/*
+============
+idClip::TracePacket
+
+  the point traces are batched per model, the box traces share the list of touched clip models
+============
+*/
+int idClip::TracePacket( trace_t *results, const clipTrace_t *traces, const int numTraces, int contentMask, const idEntity *passEntity ) {
+	int i, j, k, num, numPoints, numSubset, numHits;
+	idClipModel *touch;
+	idBounds batchBounds;
+	trace_t trace;
+
+	assert( numTraces <= MAX_TRACE_BATCH );
+	assert( tracePacket != NULL );
+
+	idClipModel **clipModelList = tracePacket->clipModelList;
+	idVec3 *starts = tracePacket->starts;
+	idVec3 *ends = tracePacket->ends;
+	int *pointNums = tracePacket->pointNums;
+	int *subsetNums = tracePacket->subsetNums;
+	bool *isPoint = tracePacket->isPoint;
+	idBounds *traceBounds = tracePacket->traceBounds;
+	trace_t *subsetResults = tracePacket->subsetResults;
+
+	const bool testWorld = ( !passEntity || passEntity->entityNumber != ENTITYNUM_WORLD );
+
+	// gather the point traces
+	numPoints = 0;
+	for ( i = 0; i < numTraces; i++ ) {
+		const idBounds &bounds = traces[i].bounds;
+		isPoint[i] = bounds.IsCleared() || ( bounds[1][0] - bounds[0][0] <= 0.0f &&
+											bounds[1][1] - bounds[0][1] <= 0.0f &&
+											bounds[1][2] - bounds[0][2] <= 0.0f );
+		if ( isPoint[i] ) {
+			starts[numPoints] = traces[i].start;
+			ends[numPoints] = traces[i].end;
+			pointNums[numPoints++] = i;
+		}
+	}
+
+	// test all point traces against the world at once
+	if ( testWorld && numPoints > 0 ) {
+		idClip::numTranslations += numPoints;
+		collisionModelManager->TracePoints( subsetResults, starts, ends, numPoints, contentMask, 0, vec3_origin, mat3_default );
+		for ( k = 0; k < numPoints; k++ ) {
+			trace_t &result = results[pointNums[k]];
+			result = subsetResults[k];
+			result.c.entityNum = result.fraction != 1.0f ? ENTITYNUM_WORLD : ENTITYNUM_NONE;
+		}
+	} else {
+		for ( k = 0; k < numPoints; k++ ) {
+			trace_t &result = results[pointNums[k]];
+			memset( &result, 0, sizeof( result ) );
+			result.fraction = 1.0f;
+			result.endpos = traces[pointNums[k]].end;
+			result.endAxis = mat3_identity;
+		}
+	}
+
+	// get the clip models touched by any of the traces
+	batchBounds.Clear();
+	for ( i = 0; i < numTraces; i++ ) {
+		const clipTrace_t &t = traces[i];
+		if ( isPoint[i] ) {
+			traceBounds[i].FromPointTranslation( t.start, results[i].endpos - t.start );
+		} else {
+			traceBounds[i].FromBoundsTranslation( t.bounds, t.start, mat3_identity, t.end - t.start );
+		}
+		batchBounds += traceBounds[i];
+	}
+
+	num = GetTraceClipModels( batchBounds, contentMask, passEntity, clipModelList );
+
+	// box traces are done one by one against the shared list of clip models
+	for ( i = 0; i < numTraces; i++ ) {
+		if ( isPoint[i] ) {
+			continue;
+		}
+
+		const clipTrace_t &t = traces[i];
+		trace_t &result = results[i];
+
+		temporaryClipModel.LoadModel( idTraceModel( t.bounds ) );
+		if ( TestHugeTranslation( result, &temporaryClipModel, t.start, t.end, mat3_identity ) ) {
+			continue;
+		}
+		const idTraceModel *trm = TraceModelForClipModel( &temporaryClipModel );
+
+		if ( testWorld ) {
+			idClip::numTranslations++;
+			collisionModelManager->Translation( &result, t.start, t.end, trm, mat3_identity, contentMask, 0, vec3_origin, mat3_default );
+			result.c.entityNum = result.fraction != 1.0f ? ENTITYNUM_WORLD : ENTITYNUM_NONE;
+			if ( result.fraction == 0.0f ) {
+				continue;
+			}
+		} else {
+			memset( &result, 0, sizeof( result ) );
+			result.fraction = 1.0f;
+			result.endpos = t.end;
+			result.endAxis = mat3_identity;
+		}
+
+		traceBounds[i].FromBoundsTranslation( trm->bounds, t.start, mat3_identity, result.endpos - t.start );
+		const float radius = trm->bounds.GetRadius();
+
+		for ( j = 0; j < num; j++ ) {
+			touch = clipModelList[j];
+
+			if ( !touch || !traceBounds[i].IntersectsBounds( touch->absBounds ) ) {
+				continue;
+			}
+
+			if ( touch->renderModelHandle != -1 ) {
+				idClip::numRenderModelTraces++;
+				TraceRenderModel( trace, t.start, t.end, radius, mat3_identity, touch );
+			} else {
+				idClip::numTranslations++;
+				collisionModelManager->Translation( &trace, t.start, t.end, trm, mat3_identity, contentMask,
+										touch->Handle(), touch->origin, touch->axis );
+			}
+
+			if ( trace.fraction < result.fraction ) {
+				result = trace;
+				result.c.entityNum = touch->entity->entityNumber;
+				result.c.id = touch->id;
+				if ( result.fraction == 0.0f ) {
+					break;
+				}
+			}
+		}
+	}
+
+	// point traces are batched per clip model
+	for ( j = 0; j < num && numPoints > 0; j++ ) {
+		touch = clipModelList[j];
+
+		if ( !touch ) {
+			continue;
+		}
+
+		numSubset = 0;
+		for ( k = 0; k < numPoints; k++ ) {
+			i = pointNums[k];
+			if ( results[i].fraction == 0.0f || !traceBounds[i].IntersectsBounds( touch->absBounds ) ) {
+				continue;
+			}
+			starts[numSubset] = traces[i].start;
+			ends[numSubset] = traces[i].end;
+			subsetNums[numSubset++] = i;
+		}
+
+		if ( numSubset == 0 ) {
+			continue;
+		}
+
+		if ( touch->renderModelHandle != -1 ) {
+			idClip::numRenderModelTraces += numSubset;
+			for ( k = 0; k < numSubset; k++ ) {
+				trace_t &result = results[subsetNums[k]];
+				TraceRenderModel( trace, starts[k], ends[k], 0.0f, mat3_identity, touch );
+				if ( trace.fraction < result.fraction ) {
+					result = trace;
+					result.c.entityNum = touch->entity->entityNumber;
+					result.c.id = touch->id;
+				}
+			}
+		} else {
+			idClip::numTranslations += numSubset;
+			collisionModelManager->TracePoints( subsetResults, starts, ends, numSubset, contentMask,
+									touch->Handle(), touch->origin, touch->axis );
+			for ( k = 0; k < numSubset; k++ ) {
+				trace_t &result = results[subsetNums[k]];
+				if ( subsetResults[k].fraction < result.fraction ) {
+					result = subsetResults[k];
+					result.c.entityNum = touch->entity->entityNumber;
+					result.c.id = touch->id;
+				}
+			}
+		}
+	}
+
+	numHits = 0;
+	for ( i = 0; i < numTraces; i++ ) {
+		if ( results[i].fraction < 1.0f ) {
+			numHits++;
+		}
+	}
+	return numHits;
+}
+
 /*
 ============
 idClip::Rotation
@@ -1692,6 +1988,9 @@ void idClip::PrintStatistics() {
 	gameLocal.Printf( "t = %-3d, r = %-3d, m = %-3d, render = %-3d, contents = %-3d, contacts = %-3d\n",
 					numTranslations, numRotations, numMotions, numRenderModelTraces, numContents, numContacts );
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
+	gameLocal.Printf( "touch queries = %-3d, cells = %-3d, tests = %-3d, models = %-3d\n",
+					numTouchQueries, numTouchCells, numTouchTests, numTouchModels );
+	numTouchQueries = numTouchCells = numTouchTests = numTouchModels = 0;
 }
 
 /*
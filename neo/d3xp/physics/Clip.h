@@ -72,7 +72,7 @@ public:
 
 	void					Link( idClip &clp );				// must have been linked with an entity and id before
 	void					Link( idClip &clp, idEntity *ent, int newId, const idVec3 &newOrigin, const idMat3 &newAxis, int renderModelHandle = -1 );
-	void					Unlink();						// unlink from sectors
+	void					Unlink();						// unlink from the clip grid
 	void					SetPosition( const idVec3 &newOrigin, const idMat3 &newAxis );	// unlinks the clip model
 	void					Translate( const idVec3 &translation );							// unlinks the clip model
 	void					Rotate( const idRotation &rotation );							// unlinks the clip model
@@ -123,11 +123,12 @@ private:
 	int						traceModelIndex;		// trace model used for collision detection
 	int						renderModelHandle;		// render model def handle
 
-	struct clipLink_s *		clipLinks;				// links into sectors
-	int						touchCount;
+	idClip *				linkedClip;				// clip the model is linked into
+	int						clipCell;				// clip grid cell the model is linked into, -1 if not linked
+	int						clipSlot;				// index of the model in the clip grid cell
 
 	void					Init();			// initialize
-	void					Link_r( struct clipSector_s *node );
+	void					UpdateClipCellContents();
 
 	static int				AllocTraceModel( const idTraceModel &trm, bool persistantThroughSaves = true );
 	static void				FreeTraceModel( int traceModelIndex );
@@ -150,10 +151,16 @@ ID_INLINE void idClipModel::Rotate( const idRotation &rotation ) {
 
 ID_INLINE void idClipModel::Enable() {
 	enabled = true;
+	if ( clipCell != -1 ) {
+		UpdateClipCellContents();
+	}
 }
 
 ID_INLINE void idClipModel::Disable() {
 	enabled = false;
+	if ( clipCell != -1 ) {
+		UpdateClipCellContents();
+	}
 }
 
 ID_INLINE void idClipModel::SetMaterial( const idMaterial *m ) {
@@ -166,6 +173,9 @@ ID_INLINE const idMaterial * idClipModel::GetMaterial() const {
 
 ID_INLINE void idClipModel::SetContents( int newContents ) {
 	contents = newContents;
+	if ( clipCell != -1 ) {
+		UpdateClipCellContents();
+	}
 }
 
 ID_INLINE int idClipModel::GetContents() const {
@@ -221,7 +231,7 @@ ID_INLINE bool idClipModel::IsTraceModel() const {
 }
 
 ID_INLINE bool idClipModel::IsLinked() const {
-	return ( clipLinks != NULL );
+	return ( clipCell != -1 );
 }
 
 ID_INLINE bool idClipModel::IsEnabled() const {
@@ -246,6 +256,15 @@ ID_INLINE const idTraceModel *idClipModel::GetTraceModel() const {
 //
 //===============================================================
 
+#define MAX_TRACE_BATCH				256		// number of traces in a batch that are resolved together
+
+// a trace in a batch, traces with cleared or zero sized bounds are point traces
+typedef struct clipTrace_s {
+	idVec3					start;
+	idVec3					end;
+	idBounds				bounds;
+} clipTrace_t;
+
 class idClip {
 
 	friend class idClipModel;
@@ -274,6 +293,10 @@ public:
 	bool					TraceBounds( trace_t &results, const idVec3 &start, const idVec3 &end, const idBounds &bounds,
 								int contentMask, const idEntity *passEntity );
 
+	// batched translations versus the rest of the world, returns the number of traces that hit something
+	int						TraceBatch( trace_t *results, const clipTrace_t *traces, const int numTraces,
+								int contentMask, const idEntity *passEntity );
+
 	// clip versus a specific model
 	void					TranslationModel( trace_t &results, const idVec3 &start, const idVec3 &end,
 								const idClipModel *mdl, const idMat3 &trmAxis, int contentMask,
@@ -308,12 +331,19 @@ public:
 	bool					DrawModelContactFeature( const contactInfo_t &contact, const idClipModel *clipModel, int lifetime ) const;
 
 private:
-	int						numClipSectors;
-	struct clipSector_s *	clipSectors;
+							// loose grid over the xy plane of the world, every clip model is linked into the
+							// cell that contains its center and the last cell holds the clip models that are
+							// too large for the grid
 	idBounds				worldBounds;
+	idVec2					gridOrigin;
+	float					gridCellSize;
+	float					gridInvCellSize;
+	int						gridSize[2];
+	int						numClipCells;
+	struct clipCell_s *		clipCells;
+	struct tracePacket_s *	tracePacket;
 	idClipModel				temporaryClipModel;
 	idClipModel				defaultClipModel;
-	mutable int				touchCount;
 							// statistics
 	int						numTranslations;
 	int						numRotations;
@@ -321,13 +351,21 @@ private:
 	int						numRenderModelTraces;
 	int						numContents;
 	int						numContacts;
+							// broadphase statistics, only counted on the main thread
+	mutable int				numTouchQueries;
+	mutable int				numTouchCells;
+	mutable int				numTouchTests;
+	mutable int				numTouchModels;
 
 private:
-	struct clipSector_s *	CreateClipSectors_r( const int depth, const idBounds &bounds, idVec3 &maxSector );
-	void					ClipModelsTouchingBounds_r( const struct clipSector_s *node, struct listParms_s &parms ) const;
+	void					LinkClipModel( idClipModel *mdl );
+	void					UnlinkClipModel( idClipModel *mdl );
+	void					ClipModelsTouchingBoundsInCell( const struct clipCell_s &cell, struct listParms_s &parms ) const;
 	const idTraceModel *	TraceModelForClipModel( const idClipModel *mdl ) const;
 	int						GetTraceClipModels( const idBounds &bounds, int contentMask, const idEntity *passEntity, idClipModel **clipModelList ) const;
 	void					TraceRenderModel( trace_t &trace, const idVec3 &start, const idVec3 &end, const float radius, const idMat3 &axis, idClipModel *touch ) const;
+	int						TracePacket( trace_t *results, const clipTrace_t *traces, const int numTraces,
+								int contentMask, const idEntity *passEntity );
 };
 
 
@@ -60,6 +60,8 @@ const idVec6 vec6_lcp_epsilon				= idVec6( LCP_EPSILON, LCP_EPSILON, LCP_EPSILON
 static int lastTimerReset = 0;
 static int numArticulatedFigures = 0;
 static idTimer timer_total, timer_pc, timer_ac, timer_collision, timer_lcp;
+static int numLcpSolves, numLcpIterations;
+static float maxLcpResidual;
 #endif
 
 
@@ -2979,6 +2981,7 @@ idAFConstraint_Contact::idAFConstraint_Contact() {
 	fc = NULL;
 	fl.allowPrimary = false;
 	fl.frameConstraint = true;
+	fl.isContact = true;
 }
 
 /*
@@ -3166,6 +3169,7 @@ idAFConstraint_ContactFriction::idAFConstraint_ContactFriction() {
 	cc = NULL;
 	fl.allowPrimary = false;
 	fl.frameConstraint = true;
+	fl.isContact = true;
 }
 
 /*
@@ -5222,17 +5226,40 @@ void idPhysics_AF::AuxiliaryForces( float timeStep ) {
 		}
 	}
 
+	idLCP * solver = lcp;
+	if ( af_useIterativeLCP.GetBool() ) {
+		solver = iterativeLcp;
+		solver->SetMaxIterations( af_lcpIterations.GetInteger() );
+
+		// warm start from the lagrange multipliers of the previous frame, the contact
+		// constraints are handed to different contacts every frame so they start at zero
+		for ( k = 0, i = 0; i < auxiliaryConstraints.Num(); i++ ) {
+			constraint = auxiliaryConstraints[i];
+			for ( j = 0; j < constraint->J1.GetNumRows(); j++, k++ ) {
+				lm[k] = constraint->fl.isContact ? 0.0f : constraint->lm[j];
+			}
+		}
+	}
+
 #ifdef AF_TIMINGS
-	timer_lcp.Start();
+	const bool timings = af_showTimings.GetInteger() != 0;
+	if ( timings ) {
+		timer_lcp.Start();
+	}
 #endif
 
 	// calculate lagrange multipliers for auxiliary constraints
-	if ( !lcp->Solve( jmk, lm, rhs, lo, hi, boxIndex ) ) {
+	if ( !solver->Solve( jmk, lm, rhs, lo, hi, boxIndex ) ) {
 		return;		// bad monkey!
 	}
 
 #ifdef AF_TIMINGS
-	timer_lcp.Stop();
+	if ( timings ) {
+		timer_lcp.Stop();
+		numLcpSolves++;
+		numLcpIterations += solver->GetNumIterations();
+		maxLcpResidual = Max( maxLcpResidual, solver->GetResidual() );
+	}
 #endif
 
 	// calculate auxiliary constraint forces
@@ -6214,10 +6241,12 @@ const idBounds &idPhysics_AF::GetAbsBounds( int id ) const {
 
 /*
 ================
-idPhysics_AF::Evaluate
+idPhysics_AF::BeginEvaluate
+
+  sets up the constraints for the time step, returns false if the figure doesn't need to be solved
 ================
 */
-bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
+bool idPhysics_AF::BeginEvaluate( int timeStepMSec, int endTimeMSec ) {
 	float timeStep;
 
 	if ( timeScaleRampStart < MS2SEC( endTimeMSec ) && timeScaleRampEnd > MS2SEC( endTimeMSec ) ) {
@@ -6228,7 +6257,8 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
 		timeStep = MS2SEC( timeStepMSec ) * timeScale;
 	}
 	current.lastTimeStep = timeStep;
-
+	evaluateTimeStep = timeStep;
+	evaluateEndTimeMSec = endTimeMSec;
 
 	// if the articulated figure changed
 	if ( changedAF || ( linearTime != af_useLinearTime.GetBool() ) ) {
@@ -6259,7 +6289,10 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
 	AddPushVelocity( -current.pushVelocity );
 
 #ifdef AF_TIMINGS
-	timer_total.Start();
+	// the figures evaluated ahead of think overlap, so only time them one at a time
+	if ( af_showTimings.GetInteger() != 0 ) {
+		timer_total.Start();
+	}
 #endif
 
 #ifdef AF_TIMINGS
@@ -6285,15 +6318,25 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
 	// add frame constraints
 	AddFrameConstraints();
 
+	return true;
+}
+
+/*
+================
+idPhysics_AF::SolveConstraints
+
+  calculates the constraint forces and the next state, this only touches the figure itself
+================
+*/
+void idPhysics_AF::SolveConstraints() {
+	const float timeStep = evaluateTimeStep;
+
 #ifdef AF_TIMINGS
-	int i, numPrimary = 0, numAuxiliary = 0;
-	for ( i = 0; i < primaryConstraints.Num(); i++ ) {
-		numPrimary += primaryConstraints[i]->J1.GetNumRows();
-	}
-	for ( i = 0; i < auxiliaryConstraints.Num(); i++ ) {
-		numAuxiliary += auxiliaryConstraints[i]->J1.GetNumRows();
+	// never set while the figures are solved on the job threads
+	const bool timings = af_showTimings.GetInteger() != 0;
+	if ( timings ) {
+		timer_pc.Start();
 	}
-	timer_pc.Start();
 #endif
 
 	// factor matrices for primary constraints
@@ -6303,19 +6346,35 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
 	PrimaryForces( timeStep );
 
 #ifdef AF_TIMINGS
-	timer_pc.Stop();
-	timer_ac.Start();
+	if ( timings ) {
+		timer_pc.Stop();
+		timer_ac.Start();
+	}
 #endif
 
 	// calculate and apply auxiliary constraint forces
 	AuxiliaryForces( timeStep );
 
 #ifdef AF_TIMINGS
-	timer_ac.Stop();
+	if ( timings ) {
+		timer_ac.Stop();
+	}
 #endif
 
 	// evolve current state to next state
 	Evolve( timeStep );
+}
+
+/*
+================
+idPhysics_AF::EndEvaluate
+
+  handles collisions and moves to the next state
+================
+*/
+bool idPhysics_AF::EndEvaluate() {
+	const float timeStep = evaluateTimeStep;
+	const int endTimeMSec = evaluateEndTimeMSec;
 
 	// debug graphics
 	DebugDraw();
@@ -6375,25 +6434,35 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
 	}
 
 #ifdef AF_TIMINGS
-	timer_total.Stop();
+	if ( af_showTimings.GetInteger() != 0 ) {
+		timer_total.Stop();
+	}
+
+	int i, numPrimary = 0, numAuxiliary = 0;
+	for ( i = 0; i < primaryConstraints.Num(); i++ ) {
+		numPrimary += primaryConstraints[i]->J1.GetNumRows();
+	}
+	for ( i = 0; i < auxiliaryConstraints.Num(); i++ ) {
+		numAuxiliary += auxiliaryConstraints[i]->J1.GetNumRows();
+	}
 
 	if ( af_showTimings.GetInteger() == 1 ) {
-		gameLocal.Printf( "%12s: t %1.4f pc %2d, %1.4f ac %2d %1.4f lcp %1.4f cd %1.4f\n",
+		gameLocal.Printf( "%12s: t %1.4f pc %2d, %1.4f ac %2d %1.4f lcp %1.4f (%d it, %1.1e res) cd %1.4f\n",
 						self->name.c_str(),
 						timer_total.Milliseconds(),
 						numPrimary, timer_pc.Milliseconds(),
 						numAuxiliary, timer_ac.Milliseconds() - timer_lcp.Milliseconds(),
-						timer_lcp.Milliseconds(), timer_collision.Milliseconds() );
+						timer_lcp.Milliseconds(), numLcpIterations, maxLcpResidual, timer_collision.Milliseconds() );
 	}
 	else if ( af_showTimings.GetInteger() == 2 ) {
 		numArticulatedFigures++;
 		if ( endTimeMSec > lastTimerReset ) {
-			gameLocal.Printf( "af %d: t %1.4f pc %2d, %1.4f ac %2d %1.4f lcp %1.4f cd %1.4f\n",
+			gameLocal.Printf( "af %d: t %1.4f pc %2d, %1.4f ac %2d %1.4f lcp %1.4f (%d solves, %d it, %1.1e res) cd %1.4f\n",
 							numArticulatedFigures,
 							timer_total.Milliseconds(),
 							numPrimary, timer_pc.Milliseconds(),
 							numAuxiliary, timer_ac.Milliseconds() - timer_lcp.Milliseconds(),
-							timer_lcp.Milliseconds(), timer_collision.Milliseconds() );
+							timer_lcp.Milliseconds(), numLcpSolves, numLcpIterations, maxLcpResidual, timer_collision.Milliseconds() );
 		}
 	}
 
@@ -6405,12 +6474,36 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
 		timer_ac.Clear();
 		timer_collision.Clear();
 		timer_lcp.Clear();
+		numLcpSolves = 0;
+		numLcpIterations = 0;
+		maxLcpResidual = 0.0f;
 	}
 #endif
 
 	return true;
 }
 
+/*
+================
+idPhysics_AF::Evaluate
+================
+*/
+bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
+	// the figure was already evaluated ahead of think by idAFIslands
+	if ( evaluatedTime == endTimeMSec ) {
+		evaluatedTime = -1;
+		return evaluatedMoved;
+	}
+
+	if ( !BeginEvaluate( timeStepMSec, endTimeMSec ) ) {
+		return false;
+	}
+
+	SolveConstraints();
+
+	return EndEvaluate();
+}
+
 /*
 ================
 idPhysics_AF::UpdateTime
@@ -6601,6 +6694,12 @@ idPhysics_AF::idPhysics_AF() {
 	masterBody = NULL;
 
 	lcp = idLCP::AllocSymmetric();
+	iterativeLcp = idLCP::AllocGaussSeidel();
+
+	evaluateTimeStep = 0.0f;
+	evaluateEndTimeMSec = 0;
+	evaluatedTime = -1;
+	evaluatedMoved = false;
 
 	memset( &current, 0, sizeof( current ) );
 	current.atRest = -1;
@@ -6676,6 +6775,7 @@ idPhysics_AF::~idPhysics_AF() {
 	}
 
 	delete lcp;
+	delete iterativeLcp;
 
 	if ( masterBody ) {
 		delete masterBody;
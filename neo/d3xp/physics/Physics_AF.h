@@ -141,6 +141,7 @@ protected:
 		bool				noCollision			: 1;	// true if body1 and body2 never collide with each other
 		bool				isPrimary			: 1;	// true if this is a primary constraint
 		bool				isZero				: 1;	// true if 's' is zero during calculations
+		bool				isContact			: 1;	// true if the constraint is handed to a different contact every frame
 	} fl;
 
 protected:
@@ -955,6 +956,16 @@ public:	// common physics interface
 	void					WriteToSnapshot( idBitMsg &msg ) const;
 	void					ReadFromSnapshot( const idBitMsg &msg );
 
+public:	// evaluation split up so idAFIslands can solve independent figures in parallel
+							// sets up the frame constraints, returns false if the figure doesn't need to be solved
+	bool					BeginEvaluate( int timeStepMSec, int endTimeMSec );
+							// only touches the figure itself and can run on any thread
+	void					SolveConstraints();
+							// handles collisions and moves to the next state, returns true if the figure moved
+	bool					EndEvaluate();
+							// the next call to Evaluate for this time returns the stored result
+	void					StoreEvaluateResult( int endTimeMSec, bool moved ) { evaluatedTime = endTimeMSec; evaluatedMoved = moved; }
+
 private:
 							// articulated figure
 	idList<idAFTree *, TAG_IDLIB_LIST_PHYSICS>		trees;							// tree structures
@@ -1015,6 +1026,12 @@ private:
 
 	idAFBody *				masterBody;						// master body
 	idLCP *					lcp;							// linear complementarity problem solver
+	idLCP *					iterativeLcp;					// warm started solver used with af_useIterativeLCP
+
+	float					evaluateTimeStep;				// time step set by BeginEvaluate
+	int						evaluateEndTimeMSec;			// end time set by BeginEvaluate
+	int						evaluatedTime;					// end time of the result stored by idAFIslands
+	bool					evaluatedMoved;					// stored result of the evaluation
 
 private:
 	void					BuildTrees();
@@ -2573,3 +2573,184 @@ idCompressor::AllocLZW
 idCompressor * idCompressor::AllocLZW() {
 	return new (TAG_IDFILE) idCompressor_LZW();
 }
+
+/*
+=================================================================================
+
+	idBlockCompressor_LZ
+
+	Each sequence starts with a token byte holding the number of literals in
+	the high nibble and the match length minus LZ_MIN_MATCH in the low nibble.
+	A nibble of 15 is followed by extra length bytes that are added until a
+	byte other than 255. The literals follow, then a 16 bit little endian
+	match offset. The block always ends with a sequence without a match.
+
+=================================================================================
+*/
+
+static const int LZ_MIN_MATCH	= 4;
+static const int LZ_MAX_OFFSET	= 65535;
+static const int LZ_HASH_BITS	= 14;
+
+ID_INLINE static uint32 LZ_Read32( const byte *p ) {
+	uint32 v;
+	memcpy( &v, p, sizeof( v ) );
+	return v;
+}
+
+ID_INLINE static int LZ_Hash( uint32 v ) {
+	return ( v * 2654435761U ) >> ( 32 - LZ_HASH_BITS );
+}
+
+ID_INLINE static byte *LZ_WriteLength( byte *op, int length ) {
+	while ( length >= 255 ) {
+		*op++ = 255;
+		length -= 255;
+	}
+	*op++ = (byte)length;
+	return op;
+}
+
+ID_INLINE static bool LZ_ReadLength( const byte *&ip, const byte *iend, int &length ) {
+	int b;
+	do {
+		if ( ip >= iend ) {
+			return false;
+		}
+		b = *ip++;
+		length += b;
+	} while ( b == 255 );
+	return true;
+}
+
+/*
+================
+idBlockCompressor_LZ::Compress
+================
+*/
+int idBlockCompressor_LZ::Compress( const byte *src, int srcLength, byte *dest, int destLength ) {
+	if ( destLength < MaxCompressedSize( srcLength ) ) {
+		return -1;
+	}
+
+	int *hashTable = (int *)Mem_Alloc( ( 1 << LZ_HASH_BITS ) * sizeof( int ), TAG_TEMP );
+	memset( hashTable, -1, ( 1 << LZ_HASH_BITS ) * sizeof( int ) );
+
+	const byte *ip = src;
+	const byte *anchor = src;
+	const byte *iend = src + srcLength;
+	byte *op = dest;
+
+	while ( iend - ip >= LZ_MIN_MATCH ) {
+		const uint32 sequence = LZ_Read32( ip );
+		const int h = LZ_Hash( sequence );
+		const int ref = hashTable[h];
+		const int pos = ip - src;
+		hashTable[h] = pos;
+
+		if ( ref < 0 || pos - ref > LZ_MAX_OFFSET || LZ_Read32( src + ref ) != sequence ) {
+			ip++;
+			continue;
+		}
+
+		const byte *match = src + ref;
+		int matchLength = LZ_MIN_MATCH;
+		while ( ip + matchLength < iend && ip[matchLength] == match[matchLength] ) {
+			matchLength++;
+		}
+
+		const int literalLength = ip - anchor;
+		byte *token = op++;
+		*token = (byte)( ( Min( literalLength, 15 ) << 4 ) | Min( matchLength - LZ_MIN_MATCH, 15 ) );
+		if ( literalLength >= 15 ) {
+			op = LZ_WriteLength( op, literalLength - 15 );
+		}
+		memcpy( op, anchor, literalLength );
+		op += literalLength;
+
+		const int offset = ip - match;
+		*op++ = (byte)( offset & 0xFF );
+		*op++ = (byte)( offset >> 8 );
+		if ( matchLength - LZ_MIN_MATCH >= 15 ) {
+			op = LZ_WriteLength( op, matchLength - LZ_MIN_MATCH - 15 );
+		}
+
+		ip += matchLength;
+		anchor = ip;
+	}
+
+	// the last sequence only has literals
+	const int literalLength = iend - anchor;
+	*op++ = (byte)( Min( literalLength, 15 ) << 4 );
+	if ( literalLength >= 15 ) {
+		op = LZ_WriteLength( op, literalLength - 15 );
+	}
+	memcpy( op, anchor, literalLength );
+	op += literalLength;
+
+	Mem_Free( hashTable );
+
+	return op - dest;
+}
+
+/*
+================
+idBlockCompressor_LZ::Decompress
+================
+*/
+int idBlockCompressor_LZ::Decompress( const byte *src, int srcLength, byte *dest, int destLength ) {
+	const byte *ip = src;
+	const byte *iend = src + srcLength;
+	byte *op = dest;
+	byte *oend = dest + destLength;
+
+	while ( ip < iend ) {
+		const int token = *ip++;
+
+		int literalLength = token >> 4;
+		if ( literalLength == 15 && !LZ_ReadLength( ip, iend, literalLength ) ) {
+			return -1;
+		}
+		if ( literalLength > iend - ip || literalLength > oend - op ) {
+			return -1;
+		}
+		memcpy( op, ip, literalLength );
+		op += literalLength;
+		ip += literalLength;
+
+		if ( ip >= iend ) {
+			break;
+		}
+
+		if ( iend - ip < 2 ) {
+			return -1;
+		}
+		const int offset = ip[0] | ( ip[1] << 8 );
+		ip += 2;
+		if ( offset == 0 || offset > op - dest ) {
+			return -1;
+		}
+
+		int matchLength = token & 15;
+		if ( matchLength == 15 && !LZ_ReadLength( ip, iend, matchLength ) ) {
+			return -1;
+		}
+		matchLength += LZ_MIN_MATCH;
+		if ( matchLength > oend - op ) {
+			return -1;
+		}
+
+		const byte *match = op - offset;
+		if ( offset >= matchLength ) {
+			memcpy( op, match, matchLength );
+		} else {
+			// overlapping match repeats the last offset bytes
+			for ( int i = 0; i < matchLength; i++ ) {
+				op[i] = match[i];
+			}
+		}
+		op += matchLength;
+	}
+
+	return op - dest;
+}
@@ -70,4 +70,25 @@ public:
 	virtual int				Seek( long offset, fsOrigin_t origin ) = 0;
 };
 
+/*
+===============================================================================
+
+	idBlockCompressor_LZ is a fast byte oriented LZ77 codec that compresses
+	independent blocks from memory to memory. It is meant for data that is
+	compressed once offline and decompressed many times, like the entries
+	of resource containers.
+
+===============================================================================
+*/
+
+class idBlockCompressor_LZ {
+public:
+							// worst case compressed size for a block of the given length
+	static int				MaxCompressedSize( int length ) { return length + length / 255 + 16; }
+							// returns the compressed length or -1 if dest is smaller than MaxCompressedSize( srcLength )
+	static int				Compress( const byte *src, int srcLength, byte *dest, int destLength );
+							// returns the decompressed length or -1 if the data is corrupt or does not fit
+	static int				Decompress( const byte *src, int srcLength, byte *dest, int destLength );
+};
+
 #endif /* !__COMPRESSOR_H__ */
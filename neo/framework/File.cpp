@@ -241,6 +241,29 @@ int idFile::Seek( long offset, fsOrigin_t origin ) {
 	return -1;
 }
 
+/*
+=================
+idFile::Tell64
+=================
+*/
+int64 idFile::Tell64() const {
+	return Tell();
+}
+
+/*
+=================
+idFile::Seek64
+
+  files that can't be larger than 2 GB only support 32 bit offsets
+=================
+*/
+int idFile::Seek64( int64 offset, fsOrigin_t origin ) {
+	if ( offset != (long)offset ) {
+		return -1;
+	}
+	return Seek( (long)offset, origin );
+}
+
 /*
 =================
 idFile::Rewind
@@ -1341,6 +1364,39 @@ int idFile_Permanent::Seek( long offset, fsOrigin_t origin ) {
 	return ( retVal == INVALID_SET_FILE_POINTER ) ? -1 : 0;
 }
 
+/*
+=================
+idFile_Permanent::Tell64
+=================
+*/
+int64 idFile_Permanent::Tell64() const {
+	LARGE_INTEGER zero, pos;
+	zero.QuadPart = 0;
+	if ( !SetFilePointerEx( o, zero, &pos, FILE_CURRENT ) ) {
+		return -1;
+	}
+	return pos.QuadPart;
+}
+
+/*
+=================
+idFile_Permanent::Seek64
+
+  returns zero on success and -1 on failure
+=================
+*/
+int idFile_Permanent::Seek64( int64 offset, fsOrigin_t origin ) {
+	LARGE_INTEGER distance;
+	distance.QuadPart = offset;
+	BOOL result = FALSE;
+	switch( origin ) {
+		case FS_SEEK_CUR: result = SetFilePointerEx( o, distance, NULL, FILE_CURRENT ); break;
+		case FS_SEEK_END: result = SetFilePointerEx( o, distance, NULL, FILE_END ); break;
+		case FS_SEEK_SET: result = SetFilePointerEx( o, distance, NULL, FILE_BEGIN ); break;
+	}
+	return result ? 0 : -1;
+}
+
 #if 1
 /*
 =================================================================================
@@ -1441,6 +1497,34 @@ int idFile_Cached::Seek( long offset, fsOrigin_t origin ) {
 	internalFilePos = idFile_Permanent::Tell();
 	return retVal;
 }
+
+/*
+=================
+idFile_Cached::Tell64
+=================
+*/
+int64 idFile_Cached::Tell64() const {
+	return internalFilePos;
+}
+
+/*
+=================
+idFile_Cached::Seek64
+
+  returns zero on success and -1 on failure
+=================
+*/
+int idFile_Cached::Seek64( int64 offset, fsOrigin_t origin ) {
+	if ( origin == FS_SEEK_SET && offset >= (int64)bufferedStartOffset && offset < (int64)bufferedEndOffset ) {
+		// don't do anything to the actual file ptr, just update or internal position
+		internalFilePos = offset;
+		return 0;
+	}
+
+	int retVal = idFile_Permanent::Seek64( offset, origin );
+	internalFilePos = idFile_Permanent::Tell64();
+	return retVal;
+}
 #endif
 
 /*
@@ -1599,13 +1683,17 @@ idFile_InnerResource
 idFile_InnerResource::idFile_InnerResource
 =================
 */
-idFile_InnerResource::idFile_InnerResource( const char *_name, idFile *rezFile, int _offset, int _len ) {
+idFile_InnerResource::idFile_InnerResource( const char *_name, idFile *rezFile, int64 _offset, int _len, int _codec ) {
 	name = _name;
 	offset = _offset;
 	length = _len;
 	resourceFile = rezFile;
 	internalFilePos = 0;
 	resourceBuffer = NULL;
+	codec = _codec;
+	blockBuffer = NULL;
+	cachedBlock = -1;
+	compressedBuffer = NULL;
 }
 
 /*
@@ -1617,6 +1705,8 @@ idFile_InnerResource::~idFile_InnerResource() {
 	if ( resourceBuffer != NULL ) {
 		fileSystem->FreeResourceBuffer();
 	}
+	Mem_Free( blockBuffer );
+	Mem_Free( compressedBuffer );
 }
 
 /*
@@ -1635,6 +1725,10 @@ int idFile_InnerResource::Read( void *buffer, int len ) {
 		len = length - internalFilePos;
 	}
 
+	if ( codec != RESOURCE_CODEC_NONE && resourceBuffer == NULL ) {
+		return ReadCompressed( buffer, len );
+	}
+
 	int read = 0; //fileSystem->ReadFromBGL( resourceFile, (byte*)buffer, offset + internalFilePos, len );
 
 	if ( read != len ) {
@@ -1651,6 +1745,107 @@ int idFile_InnerResource::Read( void *buffer, int len ) {
 	return read;
 }
 
+/*
+=================
+idFile_InnerResource::LoadBlockTable
+
+The block sizes are stored in front of the compressed blocks
+=================
+*/
+bool idFile_InnerResource::LoadBlockTable() {
+	const int numBlocks = ( length + RESOURCE_BLOCK_SIZE - 1 ) / RESOURCE_BLOCK_SIZE;
+	blockSizes.SetNum( numBlocks );
+	blockOffsets.SetNum( numBlocks );
+
+	const int tableSize = numBlocks * sizeof( int );
+	if ( fileSystem->ReadFromBGL( resourceFile, blockSizes.Ptr(), offset, tableSize ) != tableSize ) {
+		blockSizes.Clear();
+		return false;
+	}
+
+	int64 blockOffset = offset + tableSize;
+	for ( int i = 0; i < numBlocks; i++ ) {
+		idSwap::Big( blockSizes[i] );
+		blockOffsets[i] = blockOffset;
+		blockOffset += blockSizes[i] & ~RESOURCE_BLOCK_STORED;
+	}
+	return true;
+}
+
+/*
+=================
+idFile_InnerResource::DecompressBlock
+=================
+*/
+bool idFile_InnerResource::DecompressBlock( int block, byte *dest, int blockLength ) {
+	const int size = (int)( blockSizes[block] & ~RESOURCE_BLOCK_STORED );
+
+	if ( blockSizes[block] & RESOURCE_BLOCK_STORED ) {
+		// the block didn't compress
+		return size == blockLength && fileSystem->ReadFromBGL( resourceFile, dest, blockOffsets[block], size ) == size;
+	}
+
+	const int maxCompressedSize = idBlockCompressor_LZ::MaxCompressedSize( RESOURCE_BLOCK_SIZE );
+	if ( size > maxCompressedSize ) {
+		return false;
+	}
+	if ( compressedBuffer == NULL ) {
+		compressedBuffer = (byte *)Mem_Alloc( maxCompressedSize, TAG_RESOURCE );
+	}
+	if ( fileSystem->ReadFromBGL( resourceFile, compressedBuffer, blockOffsets[block], size ) != size ) {
+		return false;
+	}
+	return idBlockCompressor_LZ::Decompress( compressedBuffer, size, dest, blockLength ) == blockLength;
+}
+
+/*
+=================
+idFile_InnerResource::ReadCompressed
+
+Whole blocks are decompressed straight into the caller's buffer,
+partial blocks go through blockBuffer
+=================
+*/
+int idFile_InnerResource::ReadCompressed( void *buffer, int len ) {
+	if ( blockSizes.Num() == 0 && length > 0 && !LoadBlockTable() ) {
+		common->Warning( "idFile_InnerResource: couldn't read the block table of %s", name.c_str() );
+		return 0;
+	}
+
+	byte *dest = (byte *)buffer;
+	int read = 0;
+	while ( read < len ) {
+		const int block = internalFilePos / RESOURCE_BLOCK_SIZE;
+		const int blockStart = block * RESOURCE_BLOCK_SIZE;
+		const int blockLength = Min( RESOURCE_BLOCK_SIZE, length - blockStart );
+		const int inBlock = internalFilePos - blockStart;
+		const int count = Min( blockLength - inBlock, len - read );
+
+		if ( inBlock == 0 && count == blockLength ) {
+			if ( !DecompressBlock( block, dest + read, blockLength ) ) {
+				common->Warning( "idFile_InnerResource: corrupt block %d in %s", block, name.c_str() );
+				break;
+			}
+		} else {
+			if ( cachedBlock != block ) {
+				if ( blockBuffer == NULL ) {
+					blockBuffer = (byte *)Mem_Alloc( RESOURCE_BLOCK_SIZE, TAG_RESOURCE );
+				}
+				if ( !DecompressBlock( block, blockBuffer, blockLength ) ) {
+					common->Warning( "idFile_InnerResource: corrupt block %d in %s", block, name.c_str() );
+					cachedBlock = -1;
+					break;
+				}
+				cachedBlock = block;
+			}
+			memcpy( dest + read, blockBuffer + inBlock, count );
+		}
+		read += count;
+		internalFilePos += count;
+	}
+	return read;
+}
+
 /*
 =================
 idFile_InnerResource::Tell
@@ -70,6 +70,10 @@ public:
 	virtual void			Flush();
 							// Seek on a file.
 	virtual int				Seek( long offset, fsOrigin_t origin );
+							// Returns the 64 bit offset in file.
+	virtual int64			Tell64() const;
+							// Seek on a file with a 64 bit offset.
+	virtual int				Seek64( int64 offset, fsOrigin_t origin );
 							// Go back to the beginning of the file.
 	virtual void			Rewind();
 							// Like fprintf.
@@ -248,6 +252,8 @@ public:
 	virtual void			ForceFlush();
 	virtual void			Flush();
 	virtual int				Seek( long offset, fsOrigin_t origin );
+	virtual int64			Tell64() const;
+	virtual int				Seek64( int64 offset, fsOrigin_t origin );
 
 	// returns file pointer
 	idFileHandle			GetFilePtr() { return o; }
@@ -273,6 +279,8 @@ public:
 
 	virtual int				Tell() const;
 	virtual int				Seek( long offset, fsOrigin_t origin );
+	virtual int64			Tell64() const;
+	virtual int				Seek64( int64 offset, fsOrigin_t origin );
 
 private:
 	uint64				internalFilePos;
@@ -313,7 +321,7 @@ class idFile_InnerResource : public idFile {
 	friend class			idFileSystemLocal;
 
 public:
-							idFile_InnerResource( const char *_name, idFile *rezFile, int _offset, int _len );
+							idFile_InnerResource( const char *_name, idFile *rezFile, int64 _offset, int _len, int _codec = 0 );
 	virtual					~idFile_InnerResource();
 
 	virtual const char *	GetName() const { return name.c_str(); }
@@ -330,12 +338,24 @@ public:
 	}
 
 private:
+	int						ReadCompressed( void *buffer, int len );
+	bool					LoadBlockTable();
+	bool					DecompressBlock( int block, byte *dest, int blockLength );
+
 	idStr				name;				// name of the file in the pak
-	int					offset;				// offset in the resource file
+	int64				offset;				// offset in the resource file
 	int					length;				// size
 	idFile *			resourceFile;		// actual file
 	int					internalFilePos;	// seek offset
 	byte *				resourceBuffer;		// if using the temp save memory
+
+	// compressed entries
+	int					codec;				// resourceCodec_t
+	idList< int, TAG_RESOURCE >		blockSizes;		// compressed size of each block
+	idList< int64, TAG_RESOURCE >	blockOffsets;	// offset of each block in the resource file
+	byte *				blockBuffer;		// last decompressed block for partial reads
+	int					cachedBlock;
+	byte *				compressedBuffer;	// compressed data of the block being decompressed
 };
 #endif
 /*
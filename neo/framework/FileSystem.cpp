@@ -124,6 +124,82 @@ struct searchpath_t {
 #define FSFLAG_SEARCH_DIRS		( 1 << 0 )
 #define FSFLAG_RETURN_FILE_MEM	( 1 << 1 )
 
+/*
+================================================
+idBackgroundLoader reads the preload ranges of the resource containers that aren't
+memory mapped ahead of the loads on a worker thread, ReadFromBGL is served from the
+completed buffers. The loader reads through its own file handles so it never moves
+the file position of the container the loads read from.
+================================================
+*/
+enum bglRangeState_t {
+	BGL_PENDING,
+	BGL_READING,
+	BGL_DONE,
+	BGL_RELEASED
+};
+
+struct bglRange_t {
+	int						containerIndex;
+	idFile *				loaderFile;			// handle used by the loader
+	int64					offset;
+	int						length;
+	int						needed;				// bytes of preload entries, the rest are merged gaps
+	int						consumed;			// bytes served from the buffer
+	int						lastUsed;			// use count at the last hit, for eviction
+	byte *					buffer;
+	volatile int			state;				// bglRangeState_t
+};
+
+struct bglStats_t {
+	int						numRanges;
+	int64					bytesQueued;
+	int64					bytesRead;			// read by the loader
+	int64					bytesServed;		// served from completed buffers
+	int64					bytesMissed;		// read on the caller's thread
+	int						numHits;
+	int						numMisses;
+	int						numStalls;			// reads that waited for the loader
+	int						numEvictions;		// completed ranges freed before they were used up
+	uint64					stallMicroseconds;
+	uint64					startMicroseconds;
+};
+
+class idBackgroundLoader : public idSysThread {
+public:
+							idBackgroundLoader();
+
+	void					Start( const idList< bglRange_t > & ranges, int64 memoryBudget );
+	void					Stop();
+	bool					IsActive() const { return active; }
+
+	// returns -1 if the range isn't covered by a completed or in flight read
+	int						Read( int containerIndex, void *buffer, int64 offset, int len );
+	void					AddMiss( int len ) { stats.numMisses++; stats.bytesMissed += len; }
+
+	const bglStats_t &		GetStats() const { return stats; }
+
+protected:
+	virtual int				Run();
+
+private:
+	idList< bglRange_t >	ranges;
+	idSysMutex				mutex;
+	idSysSignal				rangeDone;
+	idSysSignal				spaceAvailable;
+	int						nextRange;
+	int						useCount;
+	int64					bufferedBytes;
+	int64					budget;
+	volatile bool			cancel;
+	bool					active;
+	bglStats_t				stats;
+
+	int						FindRange( int containerIndex, int64 offset, int len ) const;
+	void					ReleaseRange( bglRange_t & range );
+	void					EvictRanges();
+};
+
 class idFileSystemLocal : public idFileSystem {
 public:
 							idFileSystemLocal();
@@ -181,7 +257,7 @@ public:
 	virtual void			StopPreload();
 	idFile *				GetResourceFile( const char *fileName, bool memFile );
 	bool					GetResourceCacheEntry( const char *fileName, idResourceCacheEntry &rc );
-	virtual int				ReadFromBGL( idFile *_resourceFile, void * _buffer, int _offset, int _len );
+	virtual int				ReadFromBGL( idFile *_resourceFile, void * _buffer, int64 _offset, int _len );
 	virtual bool			IsBinaryModel( const idStr & resName ) const;
 	virtual bool			IsSoundSample( const idStr & resName ) const;
 	virtual void			FreeResourceBuffer() { resourceBufferAvailable = resourceBufferSize; }
@@ -233,10 +309,15 @@ private:
 	static idCVar			fs_enableBGL;
 	static idCVar			fs_debugBGL;
 
+	static idCVar			fs_bglMemory;
+
 	idStr					manifestName;
 	idStrList				fileManifest;
 	idPreloadManifest		preloadList;
 
+	idBackgroundLoader		backgroundLoader;
+	idList< idFile * >		backgroundLoaderFiles;	// handles opened for the background loader
+
 	idList< idResourceContainer * > resourceFiles;
 	byte *	resourceBufferPtr;
 	int		resourceBufferSize;
@@ -278,8 +359,9 @@ private:
 
 idCVar	idFileSystemLocal::fs_debug( "fs_debug", "0", CVAR_SYSTEM | CVAR_INTEGER, "", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
 idCVar	idFileSystemLocal::fs_debugResources( "fs_debugResources", "0", CVAR_SYSTEM | CVAR_BOOL, "" );
-idCVar	idFileSystemLocal::fs_enableBGL( "fs_enableBGL", "0", CVAR_SYSTEM | CVAR_BOOL, "" );
-idCVar	idFileSystemLocal::fs_debugBGL( "fs_debugBGL", "0", CVAR_SYSTEM | CVAR_BOOL, "" );
+idCVar	idFileSystemLocal::fs_enableBGL( "fs_enableBGL", "1", CVAR_SYSTEM | CVAR_BOOL, "read the preloads of resource files that aren't memory mapped on a background thread" );
+idCVar	idFileSystemLocal::fs_debugBGL( "fs_debugBGL", "0", CVAR_SYSTEM | CVAR_BOOL, "print the background loader statistics after each preload" );
+idCVar	idFileSystemLocal::fs_bglMemory( "fs_bglMemory", "64", CVAR_SYSTEM | CVAR_INTEGER, "megabytes the background loader may read ahead of the loads", 1, 1024 );
 idCVar	idFileSystemLocal::fs_copyfiles( "fs_copyfiles", "0", CVAR_SYSTEM | CVAR_INIT | CVAR_BOOL, "Copy every file touched to fs_savepath" );
 idCVar	idFileSystemLocal::fs_buildResources( "fs_buildresources", "0", CVAR_SYSTEM | CVAR_BOOL | CVAR_INIT, "Copy every file touched to a resource file" );
 idCVar	idFileSystemLocal::fs_game( "fs_game", "", CVAR_SYSTEM | CVAR_INIT | CVAR_SERVERINFO, "mod path" );
@@ -293,24 +375,386 @@ idCVar	fs_enableBackgroundCaching( "fs_enableBackgroundCaching", "1", CVAR_SYSTE
 idFileSystemLocal	fileSystemLocal;
 idFileSystem *		fileSystem = &fileSystemLocal;
 
+/*
+================
+idBackgroundLoader::idBackgroundLoader
+================
+*/
+idBackgroundLoader::idBackgroundLoader() {
+	nextRange = 0;
+	useCount = 0;
+	bufferedBytes = 0;
+	budget = 0;
+	cancel = false;
+	active = false;
+	memset( &stats, 0, sizeof( stats ) );
+}
+
+/*
+================
+idBackgroundLoader::Start
+================
+*/
+void idBackgroundLoader::Start( const idList< bglRange_t > & _ranges, int64 memoryBudget ) {
+	assert( !active );
+
+	if ( !IsRunning() ) {
+		StartWorkerThread( "BackgroundLoader", CORE_ANY, THREAD_NORMAL );
+	}
+
+	ranges = _ranges;
+	nextRange = 0;
+	useCount = 0;
+	bufferedBytes = 0;
+	budget = memoryBudget;
+	cancel = false;
+	active = true;
+
+	memset( &stats, 0, sizeof( stats ) );
+	stats.numRanges = ranges.Num();
+	for ( int i = 0; i < ranges.Num(); i++ ) {
+		stats.bytesQueued += ranges[i].length;
+	}
+	stats.startMicroseconds = Sys_Microseconds();
+
+	SignalWork();
+}
+
+/*
+================
+idBackgroundLoader::Stop
+
+Cancels the reads that haven't started and frees all buffers.
+================
+*/
+void idBackgroundLoader::Stop() {
+	if ( !active ) {
+		return;
+	}
+
+	cancel = true;
+	spaceAvailable.Raise();
+	WaitForThread();
+
+	for ( int i = 0; i < ranges.Num(); i++ ) {
+		ReleaseRange( ranges[i] );
+	}
+	ranges.Clear();
+	active = false;
+}
+
+/*
+================
+idBackgroundLoader::Run
+================
+*/
+int idBackgroundLoader::Run() {
+	while ( !cancel ) {
+		mutex.Lock();
+		if ( nextRange >= ranges.Num() ) {
+			mutex.Unlock();
+			break;
+		}
+		bglRange_t & range = ranges[nextRange];
+		if ( bufferedBytes > 0 && bufferedBytes + range.length > budget ) {
+			// wait for the loads to catch up
+			mutex.Unlock();
+			spaceAvailable.Wait( 100 );
+			continue;
+		}
+		range.buffer = (byte *)Mem_Alloc( range.length, TAG_RESOURCE );
+		range.state = BGL_READING;
+		bufferedBytes += range.length;
+		nextRange++;
+		mutex.Unlock();
+
+		range.loaderFile->Seek64( range.offset, FS_SEEK_SET );
+		const int read = range.loaderFile->Read( range.buffer, range.length );
+
+		mutex.Lock();
+		if ( read == range.length ) {
+			range.state = BGL_DONE;
+			range.lastUsed = useCount;
+			stats.bytesRead += read;
+		} else {
+			ReleaseRange( range );
+		}
+		mutex.Unlock();
+		rangeDone.Raise();
+	}
+	return 0;
+}
+
+/*
+================
+idBackgroundLoader::ReleaseRange
+
+Must be called with the mutex locked or with the loader stopped.
+================
+*/
+void idBackgroundLoader::ReleaseRange( bglRange_t & range ) {
+	if ( range.buffer != NULL ) {
+		Mem_Free( range.buffer );
+		range.buffer = NULL;
+		bufferedBytes -= range.length;
+		spaceAvailable.Raise();
+	}
+	range.state = BGL_RELEASED;
+}
+
+/*
+================
+idBackgroundLoader::EvictRanges
+
+Frees the least recently used completed ranges until the next range fits in the
+budget. Must be called with the mutex locked.
+================
+*/
+void idBackgroundLoader::EvictRanges() {
+	while ( nextRange < ranges.Num() && bufferedBytes > 0 && bufferedBytes + ranges[nextRange].length > budget ) {
+		int oldest = -1;
+		for ( int i = 0; i < nextRange; i++ ) {
+			if ( ranges[i].state == BGL_DONE && ( oldest == -1 || ranges[i].lastUsed < ranges[oldest].lastUsed ) ) {
+				oldest = i;
+			}
+		}
+		if ( oldest == -1 ) {
+			break;
+		}
+		ReleaseRange( ranges[oldest] );
+		stats.numEvictions++;
+	}
+}
+
+/*
+================
+idBackgroundLoader::FindRange
+================
+*/
+int idBackgroundLoader::FindRange( int containerIndex, int64 offset, int len ) const {
+	// the ranges are sorted on container and offset, find the last one that starts at or before offset
+	int lo = 0;
+	int hi = ranges.Num();
+	while ( lo < hi ) {
+		const int mid = ( lo + hi ) >> 1;
+		const bglRange_t & range = ranges[mid];
+		if ( range.containerIndex < containerIndex || ( range.containerIndex == containerIndex && range.offset <= offset ) ) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	const int index = lo - 1;
+	if ( index < 0 || ranges[index].containerIndex != containerIndex || offset + len > ranges[index].offset + ranges[index].length ) {
+		return -1;
+	}
+	return index;
+}
+
+/*
+================
+idBackgroundLoader::Read
+
+A range is released once all of its preload entries have been read from it. Loads
+arrive in the order of the preload list while the loader reads in file order, so when
+a load gets ahead of the loader the least recently used ranges are evicted to let it
+continue.
+================
+*/
+int idBackgroundLoader::Read( int containerIndex, void *buffer, int64 offset, int len ) {
+	mutex.Lock();
+
+	const int index = FindRange( containerIndex, offset, len );
+	if ( index == -1 || ranges[index].state == BGL_RELEASED ) {
+		mutex.Unlock();
+		return -1;
+	}
+	if ( ranges[index].state == BGL_PENDING ) {
+		EvictRanges();
+		mutex.Unlock();
+		return -1;
+	}
+
+	bglRange_t & range = ranges[index];
+	if ( range.state == BGL_READING ) {
+		const uint64 stallStart = Sys_Microseconds();
+		while ( range.state == BGL_READING ) {
+			mutex.Unlock();
+			rangeDone.Wait( 10 );
+			mutex.Lock();
+		}
+		stats.numStalls++;
+		stats.stallMicroseconds += Sys_Microseconds() - stallStart;
+		if ( range.state != BGL_DONE ) {
+			mutex.Unlock();
+			return -1;
+		}
+	}
+
+	memcpy( buffer, range.buffer + ( offset - range.offset ), len );
+	stats.numHits++;
+	stats.bytesServed += len;
+
+	range.consumed += len;
+	range.lastUsed = ++useCount;
+	if ( range.consumed >= range.needed ) {
+		ReleaseRange( range );
+	}
+
+	mutex.Unlock();
+	return len;
+}
+
 /*
 ================
 idFileSystemLocal::ReadFromBGL
 ================
 */
-int idFileSystemLocal::ReadFromBGL( idFile *_resourceFile, void * _buffer, int _offset, int _len ) {
-	if ( _resourceFile->Tell() != _offset ) {
-		_resourceFile->Seek( _offset, FS_SEEK_SET );
+int idFileSystemLocal::ReadFromBGL( idFile *_resourceFile, void * _buffer, int64 _offset, int _len ) {
+	if ( backgroundLoader.IsActive() ) {
+		for ( int i = 0; i < resourceFiles.Num(); i++ ) {
+			if ( resourceFiles[i]->resourceFile != _resourceFile ) {
+				continue;
+			}
+			const int read = backgroundLoader.Read( i, _buffer, _offset, _len );
+			if ( read >= 0 ) {
+				return read;
+			}
+			backgroundLoader.AddMiss( _len );
+			break;
+		}
+	}
+	if ( _resourceFile->Tell64() != _offset ) {
+		_resourceFile->Seek64( _offset, FS_SEEK_SET );
 	}
 	return _resourceFile->Read( _buffer, _len );
 }
 
+struct preloadRange_t {
+	int		containerIndex;
+	int64	offset;
+	int64	length;
+};
+
+static int PreloadRangeCompare( const preloadRange_t *a, const preloadRange_t *b ) {
+	if ( a->containerIndex != b->containerIndex ) {
+		return a->containerIndex - b->containerIndex;
+	}
+	if ( a->offset != b->offset ) {
+		return ( a->offset < b->offset ) ? -1 : 1;
+	}
+	return 0;
+}
+
+// ranges closer than this are merged into a single prefetch
+static const int64 PRELOAD_MERGE_GAP = 256 * 1024;
+// background loader reads are not merged beyond this size
+static const int64 PRELOAD_MAX_READ = 4 * 1024 * 1024;
+
 /*
 ================
 idFileSystemLocal::StartPreload
+
+Asks the OS to page in the mapped ranges of everything in the preload list so the
+loads that follow don't stall on page faults. The entries in containers that aren't
+mapped are read ahead by the background loader. Nearby entries are coalesced.
 ================
 */
 void idFileSystemLocal::StartPreload( const idStrList & _preload ) {
+	StopPreload();
+
+	if ( resourceFiles.Num() == 0 || _preload.Num() == 0 ) {
+		return;
+	}
+
+	const int startTime = Sys_Milliseconds();
+
+	idList< preloadRange_t > ranges;
+	idList< preloadRange_t > readRanges;
+	ranges.SetGranularity( 1024 );
+	readRanges.SetGranularity( 1024 );
+	idResourceCacheEntry rc;
+	for ( int i = 0; i < _preload.Num(); i++ ) {
+		if ( !GetResourceCacheEntry( _preload[i], rc ) ) {
+			continue;
+		}
+		idResourceContainer * container = resourceFiles[ rc.containerIndex ];
+		if ( !container->IsMapped() ) {
+			// the ordered startup container is already read into memory
+			if ( !fs_enableBGL.GetBool() || idStr::Icmp( container->GetFileName(), "_ordered.resources" ) == 0 ) {
+				continue;
+			}
+		}
+		preloadRange_t & range = container->IsMapped() ? ranges.Alloc() : readRanges.Alloc();
+		range.containerIndex = rc.containerIndex;
+		range.offset = rc.offset;
+		range.length = rc.compressedLength;
+	}
+	ranges.Sort( PreloadRangeCompare );
+	readRanges.Sort( PreloadRangeCompare );
+
+	int numPrefetches = 0;
+	int64 totalBytes = 0;
+	for ( int i = 0; i < ranges.Num(); ) {
+		const preloadRange_t & first = ranges[i];
+		int64 end = first.offset + first.length;
+		for ( i++; i < ranges.Num() && ranges[i].containerIndex == first.containerIndex && ranges[i].offset <= end + PRELOAD_MERGE_GAP; i++ ) {
+			end = Max( end, ranges[i].offset + ranges[i].length );
+		}
+		resourceFiles[ first.containerIndex ]->Prefetch( first.offset, end - first.offset );
+		totalBytes += end - first.offset;
+		numPrefetches++;
+	}
+
+	if ( fs_debugResources.GetBool() ) {
+		idLib::Printf( "RES: prefetched %d of %d preload entries in %d ranges, %lld kB, %d msec\n", ranges.Num(), _preload.Num(), numPrefetches, totalBytes >> 10, Sys_Milliseconds() - startTime );
+	}
+
+	if ( readRanges.Num() == 0 ) {
+		return;
+	}
+
+	// the loader reads through its own handles
+	backgroundLoaderFiles.AssureSize( resourceFiles.Num(), NULL );
+
+	idList< bglRange_t > loaderRanges;
+	loaderRanges.SetGranularity( 1024 );
+	for ( int i = 0; i < readRanges.Num(); ) {
+		const preloadRange_t & first = readRanges[i];
+		int64 end = first.offset + first.length;
+		int64 needed = first.length;
+		for ( i++; i < readRanges.Num() && readRanges[i].containerIndex == first.containerIndex && readRanges[i].offset <= end + PRELOAD_MERGE_GAP; i++ ) {
+			const int64 newEnd = Max( end, readRanges[i].offset + readRanges[i].length );
+			if ( newEnd - first.offset > PRELOAD_MAX_READ ) {
+				break;
+			}
+			end = newEnd;
+			needed += readRanges[i].length;
+		}
+
+		idFile *& loaderFile = backgroundLoaderFiles[ first.containerIndex ];
+		if ( loaderFile == NULL ) {
+			loaderFile = OpenFileRead( resourceFiles[ first.containerIndex ]->GetFileName() );
+			if ( loaderFile == NULL ) {
+				continue;
+			}
+		}
+
+		bglRange_t & range = loaderRanges.Alloc();
+		range.containerIndex = first.containerIndex;
+		range.loaderFile = loaderFile;
+		range.offset = first.offset;
+		range.length = (int)( end - first.offset );
+		range.needed = (int)Min( needed, end - first.offset );
+		range.consumed = 0;
+		range.lastUsed = 0;
+		range.buffer = NULL;
+		range.state = BGL_PENDING;
+	}
+
+	if ( loaderRanges.Num() > 0 ) {
+		backgroundLoader.Start( loaderRanges, (int64)fs_bglMemory.GetInteger() << 20 );
+	}
 }
 
 /*
@@ -319,6 +763,23 @@ idFileSystemLocal::StopPreload
 ================
 */
 void idFileSystemLocal::StopPreload() {
+	if ( !backgroundLoader.IsActive() ) {
+		return;
+	}
+
+	backgroundLoader.Stop();
+
+	if ( fs_debugBGL.GetBool() ) {
+		const bglStats_t & stats = backgroundLoader.GetStats();
+		const int msec = (int)( ( Sys_Microseconds() - stats.startMicroseconds ) / 1000 );
+		idLib::Printf( "BGL: %d ranges, %lld kB queued, %lld kB read ahead in %d msec\n", stats.numRanges, stats.bytesQueued >> 10, stats.bytesRead >> 10, msec );
+		idLib::Printf( "BGL: %d hits %lld kB, %d misses %lld kB, %d stalls %d msec, %d evictions\n", stats.numHits, stats.bytesServed >> 10, stats.numMisses, stats.bytesMissed >> 10, stats.numStalls, (int)( stats.stallMicroseconds / 1000 ), stats.numEvictions );
+	}
+
+	for ( int i = 0; i < backgroundLoaderFiles.Num(); i++ ) {
+		CloseFile( backgroundLoaderFiles[i] );
+	}
+	backgroundLoaderFiles.Clear();
 }
 
 /*
@@ -2298,19 +2759,25 @@ void idFileSystemLocal::CreateCRCsForResourceFileList( const idFileList & list )
 		uint32 resourceMagic;
 		currentFile->ReadBig( resourceMagic );
 
-		if ( resourceMagic != RESOURCE_FILE_MAGIC ) {
+		if ( resourceMagic != RESOURCE_FILE_MAGIC && resourceMagic != RESOURCE_FILE_MAGIC_V2 ) {
 			idLib::Printf( "Resource file magic number doesn't match, skipping %s.\n", list.GetFile( fileIndex ) );
 			continue;
 		}
 
-		int tableOffset;
-		currentFile->ReadBig( tableOffset );
+		int64 tableOffset = 0;
+		if ( resourceMagic == RESOURCE_FILE_MAGIC_V2 ) {
+			currentFile->ReadBig( tableOffset );
+		} else {
+			int tableOffset32;
+			currentFile->ReadBig( tableOffset32 );
+			tableOffset = tableOffset32;
+		}
 
 		int tableLength;
 		currentFile->ReadBig( tableLength );
 
 		// Read in the table
-		currentFile->Seek( tableOffset, FS_SEEK_SET );
+		currentFile->Seek64( tableOffset, FS_SEEK_SET );
 
 		int numFileResources;
 		currentFile->ReadBig( numFileResources );
@@ -2319,7 +2786,7 @@ void idFileSystemLocal::CreateCRCsForResourceFileList( const idFileList & list )
 		cacheEntries.SetNum( numFileResources );
 
 		for ( int innerFileIndex = 0; innerFileIndex < numFileResources; ++innerFileIndex ) {
-			cacheEntries[innerFileIndex].Read( currentFile.get() );
+			cacheEntries[innerFileIndex].Read( currentFile.get(), resourceMagic );
 		}
 
 		// All tables read, now seek to each one and calculate the CRC.
@@ -2327,7 +2794,7 @@ void idFileSystemLocal::CreateCRCsForResourceFileList( const idFileList & list )
 		for ( int innerFileIndex = 0; innerFileIndex < numFileResources; ++innerFileIndex ) {
 			const char * innerFileDataBegin = currentFile->GetDataPtr() + cacheEntries[innerFileIndex].offset;
 
-			innerFileCRCs[innerFileIndex] = CRC32_BlockChecksum( innerFileDataBegin, cacheEntries[innerFileIndex].length );
+			innerFileCRCs[innerFileIndex] = CRC32_BlockChecksum( innerFileDataBegin, cacheEntries[innerFileIndex].compressedLength );
 		}
 
 		// Get the CRC for all the CRCs.
@@ -2648,6 +3115,9 @@ Frees all resources and closes all files
 ================
 */
 void idFileSystemLocal::Shutdown( bool reloading ) {
+	StopPreload();
+	backgroundLoader.StopThread();
+
 	gameFolder.Clear();
 	searchPaths.Clear();
 
@@ -2705,6 +3175,8 @@ bool idFileSystemLocal::GetResourceCacheEntry( const char *fileName, idResourceC
 			if ( idStr::Icmp( rt.filename, canonical ) == 0 ) {
 				rc.filename = rt.filename;
 				rc.length = rt.length;
+				rc.compressedLength = rt.compressedLength;
+				rc.codec = rt.codec;
 				rc.containerIndex = idx;
 				rc.offset = rt.offset;
 				return true;
@@ -2734,7 +3206,11 @@ idFile * idFileSystemLocal::GetResourceFile( const char *fileName, bool memFile
 		if ( fs_debugResources.GetBool() ) {
 			idLib::Printf( "RES: loading file %s\n", rc.filename.c_str() );
 		}
-		idFile_InnerResource *file = new idFile_InnerResource( rc.filename, resourceFiles[ rc.containerIndex ]->resourceFile, rc.offset, rc.length );
+		idFile * mappedFile = resourceFiles[ rc.containerIndex ]->OpenMappedFile( rc );
+		if ( mappedFile != NULL ) {
+			return mappedFile;
+		}
+		idFile_InnerResource *file = new idFile_InnerResource( rc.filename, resourceFiles[ rc.containerIndex ]->resourceFile, rc.offset, rc.length, rc.codec );
 		if ( file != NULL && ( memFile || rc.length <= resourceBufferAvailable ) || rc.length < 8 * 1024 * 1024 ) {
 			byte *buf = NULL;
 			if ( rc.length < resourceBufferAvailable ) {
@@ -159,11 +159,11 @@ struct preloadEntry_s {
 
 struct preloadSort_t {
 	int idx;
-	int ofs;
+	int64 ofs;
 };
 class idSort_Preload : public idSort_Quick< preloadSort_t, idSort_Preload > {
 public:
-	int Compare( const preloadSort_t & a, const preloadSort_t & b ) const { return a.ofs - b.ofs; }
+	int Compare( const preloadSort_t & a, const preloadSort_t & b ) const { return ( a.ofs < b.ofs ) ? -1 : ( ( a.ofs > b.ofs ) ? 1 : 0 ); }
 };
 
 class idPreloadManifest {
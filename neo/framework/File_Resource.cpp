@@ -29,6 +29,21 @@ If you have questions concerning this license or the applicable additional terms
 #include "../idlib/precompiled.h"
 #pragma hdrstop
 
+idCVar fs_resourceCompression( "fs_resourceCompression", "1", CVAR_SYSTEM | CVAR_BOOL, "compress the entries of resource files when writing them" );
+#if defined( _WIN64 )
+#define MAP_RESOURCE_FILES_DEFAULT		"1"
+#define MAP_RESOURCE_MEGS_DEFAULT		"0"
+#else
+// the whole containers don't fit in a 32 bit address space next to everything else
+#define MAP_RESOURCE_FILES_DEFAULT		"0"
+#define MAP_RESOURCE_MEGS_DEFAULT		"512"
+#endif
+
+idCVar fs_mapResourceFiles( "fs_mapResourceFiles", MAP_RESOURCE_FILES_DEFAULT, CVAR_SYSTEM | CVAR_BOOL, "memory map resource files and read their entries without copies" );
+idCVar fs_mapResourceMegs( "fs_mapResourceMegs", MAP_RESOURCE_MEGS_DEFAULT, CVAR_SYSTEM | CVAR_INTEGER, "maximum megabytes of resource files mapped at the same time, 0 = no limit" );
+
+static int64 totalMappedBytes = 0;		// address space used by all the mapped containers
+
 /*
 ================================================================================================
 
@@ -43,8 +58,136 @@ idResourceContainer::ReOpen
 ========================
 */ 
 void idResourceContainer::ReOpen() {
+	Unmap();
 	delete resourceFile;
 	resourceFile = fileSystem->OpenFileRead( fileName );
+	Map();
+}
+
+/*
+========================
+idResourceContainer::Map
+
+Maps the whole container read only, the entries are then handed out as views into the mapping.
+Containers that would take the mapped total over fs_mapResourceMegs are read as before.
+========================
+*/ 
+void idResourceContainer::Map() {
+	if ( !fs_mapResourceFiles.GetBool() || resourceFile == NULL ) {
+		return;
+	}
+	idFile_Permanent * permanentFile = dynamic_cast< idFile_Permanent * >( resourceFile );
+	if ( permanentFile == NULL ) {
+		// _ordered.resources is already in memory
+		return;
+	}
+	const int64 maxMappedBytes = (int64)fs_mapResourceMegs.GetInteger() << 20;
+	const int64 fileLength = (int64)(unsigned int)permanentFile->Length();
+	if ( maxMappedBytes > 0 && totalMappedBytes + fileLength > maxMappedBytes ) {
+		return;
+	}
+	mappedData = (const byte *)Sys_MapFile( permanentFile->GetFilePtr(), mappedLength );
+	if ( mappedData == NULL ) {
+		mappedLength = 0;
+		idLib::Warning( "Unable to memory map resource file %s, falling back to reads", fileName.c_str() );
+		return;
+	}
+	totalMappedBytes += mappedLength;
+}
+
+/*
+========================
+idResourceContainer::Unmap
+========================
+*/ 
+void idResourceContainer::Unmap() {
+	if ( mappedData != NULL ) {
+		totalMappedBytes -= mappedLength;
+	}
+	Sys_UnmapFile( mappedData );
+	mappedData = NULL;
+	mappedLength = 0;
+}
+
+/*
+========================
+idResourceContainer::OpenMappedFile
+
+Uncompressed entries are returned as a memory file pointing straight into the mapping,
+compressed entries are decompressed from the mapping without an intermediate read buffer.
+Returns NULL if the container isn't mapped.
+========================
+*/ 
+idFile * idResourceContainer::OpenMappedFile( const idResourceCacheEntry &rc ) {
+	if ( mappedData == NULL || rc.offset < 0 || rc.offset + rc.compressedLength > mappedLength ) {
+		return NULL;
+	}
+
+	const byte * src = mappedData + rc.offset;
+	if ( rc.codec == RESOURCE_CODEC_NONE ) {
+		return new (TAG_IDFILE) idFile_Memory( rc.filename, (const char *)src, rc.length );
+	}
+
+	char * buf = (char *)Mem_Alloc( rc.length, TAG_TEMP );
+	if ( !DecompressEntry( src, rc.compressedLength, (byte *)buf, rc.length ) ) {
+		idLib::Warning( "Corrupt resource %s in %s", rc.filename.c_str(), fileName.c_str() );
+		Mem_Free( buf );
+		return NULL;
+	}
+	idFile_Memory * file = new (TAG_IDFILE) idFile_Memory( rc.filename, (const char *)buf, rc.length );
+	file->TakeDataOwnership();
+	return file;
+}
+
+/*
+========================
+idResourceContainer::Prefetch
+========================
+*/ 
+void idResourceContainer::Prefetch( int64 offset, int64 length ) {
+	if ( mappedData == NULL || offset < 0 || offset >= mappedLength ) {
+		return;
+	}
+	length = Min( length, mappedLength - offset );
+	Sys_PrefetchMappedMemory( mappedData + offset, (size_t)length );
+}
+
+/*
+========================
+idResourceContainer::DecompressEntry
+========================
+*/ 
+bool idResourceContainer::DecompressEntry( const byte *src, int srcLength, byte *dest, int length ) {
+	const int numBlocks = ( length + RESOURCE_BLOCK_SIZE - 1 ) / RESOURCE_BLOCK_SIZE;
+	const int tableSize = numBlocks * sizeof( uint32 );
+	if ( srcLength < tableSize ) {
+		return false;
+	}
+
+	const byte * blockData = src + tableSize;
+	const byte * srcEnd = src + srcLength;
+	for ( int i = 0; i < numBlocks; i++ ) {
+		uint32 blockSize;
+		memcpy( &blockSize, src + i * sizeof( uint32 ), sizeof( blockSize ) );
+		idSwap::Big( blockSize );
+
+		const int size = (int)( blockSize & ~RESOURCE_BLOCK_STORED );
+		const int blockLength = Min( RESOURCE_BLOCK_SIZE, length - i * RESOURCE_BLOCK_SIZE );
+		if ( size > srcEnd - blockData ) {
+			return false;
+		}
+		byte * blockDest = dest + i * RESOURCE_BLOCK_SIZE;
+		if ( blockSize & RESOURCE_BLOCK_STORED ) {
+			if ( size != blockLength ) {
+				return false;
+			}
+			memcpy( blockDest, blockData, size );
+		} else if ( idBlockCompressor_LZ::Decompress( blockData, size, blockDest, blockLength ) != blockLength ) {
+			return false;
+		}
+		blockData += size;
+	}
+	return true;
 }
 
 /*
@@ -65,19 +208,15 @@ bool idResourceContainer::Init( const char *_fileName, uint8 containerIndex ) {
 		return false;
 	}
 
-	resourceFile->ReadBig( resourceMagic );
-	if ( resourceMagic != RESOURCE_FILE_MAGIC ) {
+	char * const buf = ReadTable( resourceFile, resourceMagic, tableOffset, tableLength );
+	if ( buf == NULL ) {
 		idLib::FatalError( "resourceFileMagic != RESOURCE_FILE_MAGIC" );
 	}
 
 	fileName = _fileName;
 
-	resourceFile->ReadBig( tableOffset );
-	resourceFile->ReadBig( tableLength );
-	// read this into a memory buffer with a single read
-	char * const buf = (char *)Mem_Alloc( tableLength, TAG_RESOURCE );
-	resourceFile->Seek( tableOffset, FS_SEEK_SET );
-	resourceFile->Read( buf, tableLength );
+	Map();
+
 	idFile_Memory memFile( "resourceHeader", (const char *)buf, tableLength );
 
 	// Parse the resourceFile header, which includes every resource used
@@ -88,7 +227,7 @@ bool idResourceContainer::Init( const char *_fileName, uint8 containerIndex ) {
 
 	for ( int i = 0; i < numFileResources; i++ ) {
 		idResourceCacheEntry &rt = cacheTable[ i ];
-		rt.Read( &memFile );
+		rt.Read( &memFile, resourceMagic );
 		rt.filename.BackSlashesToSlashes();
 		rt.filename.ToLower();
 		rt.containerIndex = containerIndex;
@@ -113,6 +252,101 @@ bool idResourceContainer::Init( const char *_fileName, uint8 containerIndex ) {
 }
 
 
+/*
+========================
+idResourceContainer::ReadTable
+
+Reads the header and returns the entry table in a buffer that must be freed with Mem_Free,
+or NULL if this is not a resource container
+========================
+*/ 
+char * idResourceContainer::ReadTable( idFile *f, uint32 &magic, int64 &tableOffset, int &tableLength ) {
+	f->ReadBig( magic );
+	if ( magic == RESOURCE_FILE_MAGIC_V2 ) {
+		f->ReadBig( tableOffset );
+	} else if ( magic == RESOURCE_FILE_MAGIC ) {
+		int tableOffset32 = 0;
+		f->ReadBig( tableOffset32 );
+		tableOffset = tableOffset32;
+	} else {
+		return NULL;
+	}
+	f->ReadBig( tableLength );
+
+	// read this into a memory buffer with a single read
+	char * const buf = (char *)Mem_Alloc( tableLength, TAG_RESOURCE );
+	f->Seek64( tableOffset, FS_SEEK_SET );
+	f->Read( buf, tableLength );
+	return buf;
+}
+
+/*
+========================
+idResourceContainer::WriteHeader
+========================
+*/ 
+void idResourceContainer::WriteHeader( idFile *f, int64 tableOffset, int tableLength ) {
+	uint32 magic = RESOURCE_FILE_MAGIC_V2;
+	f->WriteBig( magic );
+	f->WriteBig( tableOffset );
+	f->WriteBig( tableLength );
+}
+
+/*
+========================
+idResourceContainer::WriteEntryData
+
+Writes the data of an entry at the current position and sets its offset and codec.
+The entry is compressed in independent blocks when that saves enough space to be worth
+decompressing it on load.
+========================
+*/ 
+void idResourceContainer::WriteEntryData( idFile *resFile, idResourceCacheEntry &ent, const byte *data, bool compress ) {
+	ent.offset = resFile->Tell64();
+	ent.codec = RESOURCE_CODEC_NONE;
+	ent.compressedLength = ent.length;
+
+	if ( ent.length == 0 ) {
+		return;
+	}
+
+	if ( compress ) {
+		const int numBlocks = ( ent.length + RESOURCE_BLOCK_SIZE - 1 ) / RESOURCE_BLOCK_SIZE;
+		const int maxBlockSize = idBlockCompressor_LZ::MaxCompressedSize( RESOURCE_BLOCK_SIZE );
+
+		idList< uint32, TAG_TEMP > blockSizes;
+		idList< byte, TAG_TEMP > compressed;
+		blockSizes.SetNum( numBlocks );
+		compressed.SetNum( numBlocks * maxBlockSize );
+
+		int compressedSize = 0;
+		for ( int i = 0; i < numBlocks; i++ ) {
+			const int blockStart = i * RESOURCE_BLOCK_SIZE;
+			const int blockLength = Min( RESOURCE_BLOCK_SIZE, ent.length - blockStart );
+			int size = idBlockCompressor_LZ::Compress( data + blockStart, blockLength, compressed.Ptr() + compressedSize, maxBlockSize );
+			if ( size < 0 || size >= blockLength ) {
+				memcpy( compressed.Ptr() + compressedSize, data + blockStart, blockLength );
+				size = blockLength;
+				blockSizes[i] = size | RESOURCE_BLOCK_STORED;
+			} else {
+				blockSizes[i] = size;
+			}
+			compressedSize += size;
+		}
+
+		const int totalSize = numBlocks * sizeof( uint32 ) + compressedSize;
+		if ( totalSize < ent.length - ent.length / 16 ) {
+			resFile->WriteBigArray( blockSizes.Ptr(), numBlocks );
+			resFile->Write( compressed.Ptr(), compressedSize );
+			ent.codec = RESOURCE_CODEC_LZ;
+			ent.compressedLength = totalSize;
+			return;
+		}
+	}
+
+	resFile->Write( data, ent.length );
+}
+
 /*
 ========================
 idResourceContainer::WriteManifestFile 
@@ -168,46 +402,33 @@ void idResourceContainer::UpdateResourceFile( const char *_filename, const idStr
 		return;
 	}
 
+	const bool compress = fs_resourceCompression.GetBool();
 	uint32 magic = 0;
-	int _tableOffset = 0;
+	int64 _tableOffset = 0;
 	int _tableLength = 0;
 	idList< idResourceCacheEntry > entries;
 	idStrList filesToUpdate = _filesToUpdate;
 
-	idFile *inFile = fileSystem->OpenFileRead( _filename );
-	if ( inFile == NULL ) {
-		magic = RESOURCE_FILE_MAGIC;
+	// the updated file is always written as a version 2 container
+	WriteHeader( outFile, _tableOffset, _tableLength );
 
-		outFile->WriteBig( magic );
-		outFile->WriteBig( _tableOffset );
-		outFile->WriteBig( _tableLength );
-
-	} else {
-		inFile->ReadBig( magic );
-		if ( magic != RESOURCE_FILE_MAGIC ) {
+	idFile *inFile = fileSystem->OpenFileRead( _filename );
+	if ( inFile != NULL ) {
+		char * const buf = ReadTable( inFile, magic, _tableOffset, _tableLength );
+		if ( buf == NULL ) {
 			delete inFile;
+			delete outFile;
 			return;
 		}
-
-		inFile->ReadBig( _tableOffset );
-		inFile->ReadBig( _tableLength );
-		// read this into a memory buffer with a single read
-		char * const buf = (char *)Mem_Alloc( _tableLength, TAG_RESOURCE );
-		inFile->Seek( _tableOffset, FS_SEEK_SET );
-		inFile->Read( buf, _tableLength );
 		idFile_Memory memFile( "resourceHeader", (const char *)buf, _tableLength );
 
 		int _numFileResources = 0;
 		memFile.ReadBig( _numFileResources );
 
-		outFile->WriteBig( magic );
-		outFile->WriteBig( _tableOffset );
-		outFile->WriteBig( _tableLength );
-
 		entries.SetNum( _numFileResources );
 
 		for ( int i = 0; i < _numFileResources; i++ ) {
-			entries[ i ].Read( &memFile );
+			entries[ i ].Read( &memFile, magic );
 
 
 			idLib::Printf( "examining %s\n", entries[ i ].filename.c_str() );
@@ -228,13 +449,12 @@ void idResourceContainer::UpdateResourceFile( const char *_filename, const idStr
 			}
 
 			if ( fileData == NULL ) {
-				inFile->Seek( entries[ i ].offset, FS_SEEK_SET );
+				idFile_InnerResource innerFile( entries[ i ].filename, inFile, entries[ i ].offset, entries[ i ].length, entries[ i ].codec );
 				fileData = (byte *)Mem_Alloc( entries[ i ].length, TAG_TEMP );
-				inFile->Read( fileData, entries[ i ].length );
+				innerFile.Read( fileData, entries[ i ].length );
 			}
 
-			entries[ i ].offset = outFile->Tell();
-			outFile->Write( ( void* )fileData, entries[ i ].length );
+			WriteEntryData( outFile, entries[ i ], fileData, compress );
 
 			Mem_Free( fileData );
 		}
@@ -251,18 +471,15 @@ void idResourceContainer::UpdateResourceFile( const char *_filename, const idStr
 			rt.length = newFile->Length();
 			byte * fileData = (byte *)Mem_Alloc( rt.length, TAG_TEMP );
 			newFile->Read( fileData, rt.length );
-			int idx = entries.Append( rt );
-			if ( idx >= 0 ) {
-				entries[ idx ].offset = outFile->Tell();
-				outFile->Write( ( void* )fileData, entries[ idx ].length );
-			}
+			WriteEntryData( outFile, rt, fileData, compress );
+			entries.Append( rt );
 			delete newFile;
 			Mem_Free( fileData );
 		}
 		filesToUpdate.RemoveIndex( 0 );
 	}
 
-	_tableOffset = outFile->Tell();
+	_tableOffset = outFile->Tell64();
 	outFile->WriteBig( entries.Num() );
 
 	// write the individual resource entries
@@ -271,11 +488,9 @@ void idResourceContainer::UpdateResourceFile( const char *_filename, const idStr
 	}
 
 	// go back and write the header offsets again, now that we have file offsets and lengths
-	_tableLength = outFile->Tell() - _tableOffset;
+	_tableLength = (int)( outFile->Tell64() - _tableOffset );
 	outFile->Seek( 0, FS_SEEK_SET );
-	outFile->WriteBig( magic );
-	outFile->WriteBig( _tableOffset );
-	outFile->WriteBig( _tableLength );
+	WriteHeader( outFile, _tableOffset, _tableLength );
 
 	delete outFile;
 	delete inFile;
@@ -307,20 +522,13 @@ void idResourceContainer::ExtractResourceFile ( const char * _fileName, const ch
 	}
 
 	uint32 magic;
-	inFile->ReadBig( magic );
-	if ( magic != RESOURCE_FILE_MAGIC ) {
+	int64 _tableOffset;
+	int _tableLength;
+	char * const buf = ReadTable( inFile, magic, _tableOffset, _tableLength );
+	if ( buf == NULL ) {
 		delete inFile;
 		return;
 	}
-
-	int _tableOffset;
-	int _tableLength;
-	inFile->ReadBig( _tableOffset );
-	inFile->ReadBig( _tableLength );
-	// read this into a memory buffer with a single read
-	char * const buf = (char *)Mem_Alloc( _tableLength, TAG_RESOURCE );
-	inFile->Seek( _tableOffset, FS_SEEK_SET );
-	inFile->Read( buf, _tableLength );
 	idFile_Memory memFile( "resourceHeader", (const char *)buf, _tableLength );
 
 	int _numFileResources;
@@ -328,7 +536,7 @@ void idResourceContainer::ExtractResourceFile ( const char * _fileName, const ch
 
 	for ( int i = 0; i < _numFileResources; i++ ) {
 		idResourceCacheEntry rt;
-		rt.Read( &memFile );
+		rt.Read( &memFile, magic );
 		rt.filename.BackSlashesToSlashes();
 		rt.filename.ToLower();
 		byte *fbuf = NULL;
@@ -339,9 +547,9 @@ void idResourceContainer::ExtractResourceFile ( const char * _fileName, const ch
 			fbuf =  (byte *)Mem_Alloc( len, TAG_RESOURCE );
 			fileSystem->ReadFile( rt.filename, (void**)&fbuf, NULL );
 		} else {
-			inFile->Seek( rt.offset, FS_SEEK_SET );
+			idFile_InnerResource innerFile( rt.filename, inFile, rt.offset, rt.length, rt.codec );
 			fbuf =  (byte *)Mem_Alloc( rt.length, TAG_RESOURCE );
-			inFile->Read( fbuf, rt.length );
+			innerFile.Read( fbuf, rt.length );
 		}
 		idStr outName = _outPath;
 		outName.AppendPath( rt.filename );
@@ -371,6 +579,8 @@ void idResourceContainer::WriteResourceFile( const char *manifestName, const idS
 
 	idLib::Printf( "Writing resource file %s\n", manifestName );
 
+	const bool compress = fs_resourceCompression.GetBool();
+
 	// build multiple output files at 1GB each
 	idList < idStrList > outPutFiles;
 
@@ -421,14 +631,13 @@ void idResourceContainer::WriteResourceFile( const char *manifestName, const idS
 
 		idLib::Printf( "Writing resource file %s\n", fileName.c_str() );
 
-		int	tableOffset = 0;
+		int64	tableOffset = 0;
 		int	tableLength = 0;
 		int	tableNewLength = 0;
-		uint32	resourceFileMagic = RESOURCE_FILE_MAGIC;
+		int64	uncompressedSize = 0;
+		int64	storedSize = 0;
 
-		resFile->WriteBig( resourceFileMagic );
-		resFile->WriteBig( tableOffset );
-		resFile->WriteBig( tableLength );
+		WriteHeader( resFile, tableOffset, tableLength );
 
 		idList< idResourceCacheEntry > entries;
 
@@ -446,27 +655,19 @@ void idResourceContainer::WriteResourceFile( const char *manifestName, const idS
 			if ( fm == NULL ) {
 				continue;
 			}
-			// if the entry is uncompressed, align the file pointer to a 16 byte boundary
-			// so it will be usable if memory mapped
 			ent.length = fm->Length();
 
 			// always get the offset, even if the file will have zero length
-			ent.offset = resFile->Tell();
+			WriteEntryData( resFile, ent, (const byte *)fm->GetDataPtr(), compress );
+			uncompressedSize += ent.length;
+			storedSize += ent.compressedLength;
 
 			entries.Append( ent );
 
-			if ( ent.length == 0 ) {
-				ent.filename = "";
-				delete fm;
-				continue;
-			}
-
-			resFile->Write( fm->GetDataPtr(), ent.length );
-
 			delete fm;
 
 			// pacifier every ten megs
-			if ( ( ent.offset + ent.length ) / 10000000 != ent.offset / 10000000 ) {
+			if ( ( ent.offset + ent.compressedLength ) / 10000000 != ent.offset / 10000000 ) {
 				idLib::Printf( "." );
 			}
 		}
@@ -474,7 +675,8 @@ void idResourceContainer::WriteResourceFile( const char *manifestName, const idS
 		idLib::Printf( "\n" );
 
 		// write the table out now that we have all the files
-		tableOffset = resFile->Tell();
+		tableOffset = resFile->Tell64();
+		idLib::Printf( "%lld bytes of data stored in %lld bytes\n", uncompressedSize, storedSize );
 
 		// count how many we are going to write for this platform
 		int	numFileResources = entries.Num();
@@ -486,16 +688,14 @@ void idResourceContainer::WriteResourceFile( const char *manifestName, const idS
 			entries[ i ].Write( resFile );
 			if ( i + 1 == numFileResources ) {
 				// we just wrote out the last new entry
-				tableNewLength = resFile->Tell() - tableOffset;
+				tableNewLength = (int)( resFile->Tell64() - tableOffset );
 			}
 		}
 
 		// go back and write the header offsets again, now that we have file offsets and lengths
-		tableLength = resFile->Tell() - tableOffset;
+		tableLength = (int)( resFile->Tell64() - tableOffset );
 		resFile->Seek( 0, FS_SEEK_SET );
-		resFile->WriteBig( resourceFileMagic );
-		resFile->WriteBig( tableOffset );
-		resFile->WriteBig( tableLength );
+		WriteHeader( resFile, tableOffset, tableLength );
 		delete resFile;
 	}
 }
@@ -34,9 +34,26 @@ If you have questions concerning this license or the applicable additional terms
 
   Resource containers
 
+  Version 1 containers store every entry uncompressed with 32 bit offsets.
+  Version 2 containers use 64 bit offsets and can compress each entry in
+  independent RESOURCE_BLOCK_SIZE blocks. A compressed entry starts with the
+  big endian compressed size of each block, followed by the blocks. Blocks
+  that don't compress are stored as is and flagged with RESOURCE_BLOCK_STORED.
+
 ==============================================================
 */
 
+static const uint32 RESOURCE_FILE_MAGIC = 0xD000000D;
+static const uint32 RESOURCE_FILE_MAGIC_V2 = 0xD000000E;
+
+static const int RESOURCE_BLOCK_SIZE = 64 * 1024;
+static const uint32 RESOURCE_BLOCK_STORED = 0x80000000;
+
+enum resourceCodec_t {
+	RESOURCE_CODEC_NONE,
+	RESOURCE_CODEC_LZ				// idBlockCompressor_LZ
+};
+
 class idResourceCacheEntry {
 public:
 	idResourceCacheEntry() {
@@ -47,27 +64,43 @@ public:
 		//filename = NULL;
 		offset = 0;
 		length = 0;
+		compressedLength = 0;
+		codec = RESOURCE_CODEC_NONE;
 		containerIndex = 0;
 	}
-	size_t Read( idFile *f ) {
+	size_t Read( idFile *f, uint32 magic = RESOURCE_FILE_MAGIC ) {
 		size_t sz = f->ReadString( filename );
-		sz += f->ReadBig( offset );
-		sz += f->ReadBig( length );
+		if ( magic == RESOURCE_FILE_MAGIC_V2 ) {
+			sz += f->ReadBig( offset );
+			sz += f->ReadBig( length );
+			sz += f->ReadBig( compressedLength );
+			sz += f->ReadBig( codec );
+		} else {
+			int offset32 = 0;
+			sz += f->ReadBig( offset32 );
+			sz += f->ReadBig( length );
+			offset = offset32;
+			compressedLength = length;
+			codec = RESOURCE_CODEC_NONE;
+		}
 		return sz;
 	}
 	size_t Write( idFile *f ) {
 		size_t sz = f->WriteString( filename );
 		sz += f->WriteBig( offset );
 		sz += f->WriteBig( length );
+		sz += f->WriteBig( compressedLength );
+		sz += f->WriteBig( codec );
 		return sz;
 	}
 	idStrStatic< 256 >	filename;
-	int					offset;							// into the resource file
-	int 				length;
+	int64				offset;							// into the resource file
+	int 				length;							// uncompressed length
+	int					compressedLength;				// length in the resource file, including the block table
+	uint8				codec;							// resourceCodec_t
 	uint8				containerIndex;
 };
 
-static const uint32 RESOURCE_FILE_MAGIC = 0xD000000D;
 class idResourceContainer {
 	friend class	idFileSystemLocal;
 	//friend class	idReadSpawnThread;
@@ -78,8 +111,11 @@ public:
 		tableLength = 0;
 		resourceMagic = 0;
 		numFileResources = 0;
+		mappedData = NULL;
+		mappedLength = 0;
 	}
 	~idResourceContainer() {
+		Unmap();
 		delete resourceFile;
 		cacheTable.Clear();
 	}
@@ -89,19 +125,29 @@ public:
 	static int ReadManifestFile( const char *filename, idStrList &list );
 	static void ExtractResourceFile ( const char * fileName, const char * outPath, bool copyWavs );
 	static void UpdateResourceFile( const char *filename, const idStrList &filesToAdd );
+	static void WriteEntryData( idFile *resFile, idResourceCacheEntry &ent, const byte *data, bool compress );
+	static bool DecompressEntry( const byte *src, int srcLength, byte *dest, int length );
+	static char * ReadTable( idFile *f, uint32 &magic, int64 &tableOffset, int &tableLength );
+	static void WriteHeader( idFile *f, int64 tableOffset, int tableLength );
 	idFile *OpenFile( const char *fileName );
 	const char * GetFileName() const { return fileName.c_str(); }
 	void SetContainerIndex( const int & _idx );
 	void ReOpen();
+	bool IsMapped() const { return mappedData != NULL; }
+	idFile * OpenMappedFile( const idResourceCacheEntry &rc );
+	void Prefetch( int64 offset, int64 length );
 private:
+	void Map();
+	void Unmap();
+
 	idStrStatic< 256 > fileName;
 	idFile *	resourceFile;			// open file handle
-	// offset should probably be a 64 bit value for development, but 4 gigs won't fit on
-	// a DVD layer, so it isn't a retail limitation.
-	int		tableOffset;			// table offset
+	int64	tableOffset;			// table offset
 	int		tableLength;			// table length
-	int		resourceMagic;			// magic
+	uint32	resourceMagic;			// magic
 	int		numFileResources;		// number of file resources in this container
+	const byte *	mappedData;		// read only view of the whole container when memory mapped
+	int64	mappedLength;
 	idList< idResourceCacheEntry, TAG_RESOURCE>	cacheTable;
 	idHashIndex	cacheHash;
 };
@@ -128,10 +128,110 @@ idParallelJobList_Threads
 */
 
 static idCVar jobs_longJobMicroSec( "jobs_longJobMicroSec", "10000", CVAR_INTEGER, "print a warning for jobs that take more than this number of microseconds" );
+static idCVar jobs_workStealing( "jobs_workStealing", "0", CVAR_BOOL | CVAR_NOCHEAT, "distribute submitted jobs over per-thread deques and let idle threads steal instead of fetching from a shared job index" );
 
 
 const static int		MAX_THREADS	= 32;
 
+/*
+================================================
+idJobDeque
+
+Fixed capacity Chase-Lev work stealing deque of job indices. Only the
+owning thread may Push() and Pop() at the bottom, any other thread may
+Steal() from the top.
+================================================
+*/
+class idJobDeque {
+public:
+					idJobDeque() : mask( 0 ) {}
+
+	void			Init( int capacity );
+	void			Clear() { top.SetValue( 0 ); bottom.SetValue( 0 ); }
+	bool			IsEmpty() const { return bottom.GetValue() <= top.GetValue(); }
+
+	void			Push( int job );
+	int				Pop();
+	int				Steal();
+
+private:
+	idList< int, TAG_JOBLIST >	buffer;
+	int							mask;
+	idSysInterlockedInteger		top;
+	idSysInterlockedInteger		bottom;
+};
+
+/*
+========================
+idJobDeque::Init
+========================
+*/
+void idJobDeque::Init( int capacity ) {
+	capacity = idMath::CeilPowerOfTwo( Max( capacity, 16 ) );
+	if ( capacity > buffer.Num() ) {
+		buffer.SetNum( capacity );
+		mask = capacity - 1;
+	}
+	Clear();
+}
+
+/*
+========================
+idJobDeque::Push
+========================
+*/
+void idJobDeque::Push( int job ) {
+	int b = bottom.GetValue();
+	assert( b - top.GetValue() <= mask );
+	buffer[b & mask] = job;
+	SYS_MEMORYBARRIER;
+	bottom.SetValue( b + 1 );
+}
+
+/*
+========================
+idJobDeque::Pop
+========================
+*/
+int idJobDeque::Pop() {
+	int b = bottom.GetValue() - 1;
+	bottom.Exchange( b );	// full barrier so the read of 'top' below cannot move up
+	int t = top.GetValue();
+	if ( t > b ) {
+		bottom.SetValue( t );
+		return -1;
+	}
+	int job = buffer[b & mask];
+	if ( t == b ) {
+		// last job in the deque so race against the thieves
+		if ( top.CompareExchange( t, t + 1 ) != t ) {
+			job = -1;
+		}
+		bottom.SetValue( t + 1 );
+	}
+	return job;
+}
+
+/*
+========================
+idJobDeque::Steal
+========================
+*/
+int idJobDeque::Steal() {
+	int t = top.GetValue();
+	SYS_MEMORYBARRIER;
+	int b = bottom.GetValue();
+	if ( t >= b ) {
+		return -1;
+	}
+	int job = buffer[t & mask];
+	if ( top.CompareExchange( t, t + 1 ) != t ) {
+		// lost the race against the owner or another thief
+		return -1;
+	}
+	return job;
+}
+
 struct threadJobListState_t {
 								threadJobListState_t() :
 									jobList( NULL ),
@@ -195,6 +295,15 @@ public:
 
 	bool					WaitForOtherJobList();
 
+	// Called by the manager before the list is handed to the job threads.
+	void					SetupWorkStealing( int numUnits );
+
+	//------------------------
+	// These are called from a job that is executing from this list.
+	//------------------------
+	void					AddChildJob( jobRun_t function, void * data );
+	void					AddContinuation( jobRun_t function, void * data );
+
 	//------------------------
 	// This is thread safe and called from the job threads.
 	//------------------------
@@ -213,6 +322,7 @@ private:
 	bool					threaded;
 	bool					done;
 	bool					hasSignal;
+	bool					stealing;
 	jobListId_t				listId;
 	jobListPriority_t		listPriority;
 	unsigned int			maxJobs;
@@ -227,6 +337,17 @@ private:
 		jobRun_t	function;
 		void *		data;
 		int			executed;
+		int			signal;				// index of the signal this job counts towards
+		int			parent;				// job that added this child job, -1 for jobs added before the submit
+		idSysInterlockedInteger pending;	// this job plus any child jobs that are not done yet
+		jobRun_t	continuation;		// added as a child of the parent once the job and all its children are done
+		void *		continuationData;
+	};
+	// the jobs between two SYNC_SYNCHRONIZE points, only used when stealing
+	struct jobPhase_t {
+		int			firstJob;
+		int			numJobs;
+		int			waitSignal;	// signal that needs to be done before any job in this phase can run
 	};
 	idList< job_t, TAG_JOBLIST >		jobList;
 	idList< idSysInterlockedInteger, TAG_JOBLIST >	signalJobCount;
@@ -234,13 +355,38 @@ private:
 	idSysInterlockedInteger				fetchLock;
 	idSysInterlockedInteger				numThreadsExecuting;
 
+	// child jobs added by executing jobs, referenced with CHILD_JOB_BIT set in the job index
+	idList< job_t, TAG_JOBLIST >		childJobs;
+	idSysInterlockedInteger				numChildJobs;			// allocated child jobs
+	idSysInterlockedInteger				numPublishedChildJobs;	// child jobs that are ready to be fetched
+	idSysInterlockedInteger				nextChildJob;			// next child job to fetch when not stealing
+
+	// work stealing
+	int									numStealUnits;
+	idList< jobPhase_t, TAG_JOBLIST >	phases;
+	idList< idSysInterlockedInteger, TAG_JOBLIST >	chunkClaims;	// one chunk of every phase per unit
+	idSysInterlockedInteger				numStealJobsLeft;
+	idJobDeque							deques[MAX_THREADS];
+
 	threadStats_t						deferredThreadStats;
 	threadStats_t						threadStats;
 
 	int						RunJobsInternal( unsigned int threadNum, threadJobListState_t & state, bool singleJob );
+	int						RunJobsStealing( unsigned int threadNum, bool singleJob );
+	int						FetchStealJob( unsigned int threadNum );
+	bool					ClaimChunk( int phase, int unit, unsigned int threadNum );
+	int						FetchChildJob();
+	void					AddChildJobInternal( unsigned int threadNum, int parent, int signal, jobRun_t function, void * data );
+	void					ExecuteJob( unsigned int threadNum, int jobIndex );
+	void					CompleteJob( unsigned int threadNum, int jobIndex );
+
+	ID_INLINE job_t &		GetJob( int jobIndex ) { return ( jobIndex & CHILD_JOB_BIT ) ? childJobs[jobIndex & ~CHILD_JOB_BIT] : jobList[jobIndex]; }
+	ID_INLINE void			InitJob( job_t & job, jobRun_t function, void * data, int signal, int parent );
 
 	static void				Nop( void * data ) {}
 
+	static const int		CHILD_JOB_BIT = BIT( 30 );
+
 	static int				JOB_SIGNAL;
 	static int				JOB_SYNCHRONIZE;
 	static int				JOB_LIST_DONE;
@@ -259,13 +405,15 @@ idParallelJobList_Threads::idParallelJobList_Threads( jobListId_t id, jobListPri
 	threaded( true ),
 	done( true ),
 	hasSignal( false ),
+	stealing( false ),
 	listId( id ),
 	listPriority( priority ),
 	numSyncs( 0 ),
 	lastSignalJob( 0 ),
 	waitForGuard( NULL ),
 	currentDoneGuard( 0 ),
-	jobList() {
+	jobList(),
+	numStealUnits( 0 ) {
 
 	assert( listPriority != JOBLIST_PRIORITY_NONE );
 
@@ -275,6 +423,9 @@ idParallelJobList_Threads::idParallelJobList_Threads( jobListId_t id, jobListPri
 	jobList.SetNum( 0 );
 	signalJobCount.AssureSize( maxSyncs + 1 );			// need one extra for submit
 	signalJobCount.SetNum( 0 );
+	phases.AssureSize( maxSyncs + 1 );
+	phases.SetNum( 0 );
+	childJobs.SetNum( maxJobs );	// never resized because child jobs are added while the list is running
 
 	memset( &deferredThreadStats, 0, sizeof( threadStats_t ) );
 	memset( &threadStats, 0, sizeof( threadStats_t ) );
@@ -289,6 +440,22 @@ idParallelJobList_Threads::~idParallelJobList_Threads() {
 	Wait();
 }
 
+/*
+========================
+idParallelJobList_Threads::InitJob
+========================
+*/
+ID_INLINE void idParallelJobList_Threads::InitJob( job_t & job, jobRun_t function, void * data, int signal, int parent ) {
+	job.function = function;
+	job.data = data;
+	job.executed = 0;
+	job.signal = signal;
+	job.parent = parent;
+	job.pending.SetValue( 1 );
+	job.continuation = NULL;
+	job.continuationData = NULL;
+}
+
 /*
 ========================
 idParallelJobList_Threads::AddJob
@@ -305,10 +472,7 @@ ID_INLINE void idParallelJobList_Threads::AddJob( jobRun_t function, void * data
 	}
 #endif
 	if ( 1 ) { // JDC: this never worked in tech5!  !jobList.IsFull() ) {
-		job_t & job = jobList.Alloc();
-		job.function = function;
-		job.data = data;
-		job.executed = 0;
+		InitJob( jobList.Alloc(), function, data, signalJobCount.Num(), -1 );
 	} else {
 		// debug output to show us what is overflowing
 		int currentJobCount[MAX_REGISTERED_JOBS] = {};
@@ -348,18 +512,14 @@ ID_INLINE void idParallelJobList_Threads::InsertSyncPoint( jobSyncType_t syncTyp
 				signalJobCount.Alloc();
 				signalJobCount[signalJobCount.Num() - 1].SetValue( jobList.Num() - lastSignalJob );
 				lastSignalJob = jobList.Num();
-				job_t & job = jobList.Alloc();
-				job.function = Nop;
-				job.data = & JOB_SIGNAL;
+				InitJob( jobList.Alloc(), Nop, & JOB_SIGNAL, signalJobCount.Num(), -1 );
 				hasSignal = true;
 			}
 			break;
 		}
 		case SYNC_SYNCHRONIZE: {
 			if ( hasSignal ) {
-				job_t & job = jobList.Alloc();
-				job.function = Nop;
-				job.data = & JOB_SYNCHRONIZE;
+				InitJob( jobList.Alloc(), Nop, & JOB_SYNCHRONIZE, signalJobCount.Num(), -1 );
 				hasSignal = false;
 				numSyncs++;
 			}
@@ -380,7 +540,11 @@ void idParallelJobList_Threads::Submit( idParallelJobList_Threads * waitForJobLi
 	assert( fetchLock.GetValue() == 0 );
 
 	done = false;
+	stealing = false;
 	currentJob.SetValue( 0 );
+	numChildJobs.SetValue( 0 );
+	numPublishedChildJobs.SetValue( 0 );
+	nextChildJob.SetValue( 0 );
 
 	memset( &deferredThreadStats, 0, sizeof( deferredThreadStats ) );
 	deferredThreadStats.numExecutedJobs = jobList.Num() - numSyncs * 2;
@@ -406,9 +570,7 @@ void idParallelJobList_Threads::Submit( idParallelJobList_Threads * waitForJobLi
 	signalJobCount.Alloc();
 	signalJobCount[signalJobCount.Num() - 1].SetValue( jobList.Num() - lastSignalJob );
 
-	job_t & job = jobList.Alloc();
-	job.function = Nop;
-	job.data = & JOB_LIST_DONE;
+	InitJob( jobList.Alloc(), Nop, & JOB_LIST_DONE, signalJobCount.Num() - 1, -1 );
 
 	if ( threaded ) {
 		// hand over to the manager
@@ -451,6 +613,8 @@ void idParallelJobList_Threads::Wait() {
 		numSyncs = 0;
 		lastSignalJob = 0;
 
+		deferredThreadStats.numExecutedJobs += numChildJobs.GetValue();
+
 		uint64 waitEnd = Sys_Microseconds();
 		deferredThreadStats.waitTime = waited ? ( waitEnd - waitStart ) : 0;
 	}
@@ -536,6 +700,171 @@ volatile jobRun_t longJobFunc;
 volatile void * longJobData;
 #endif
 
+// the job that is executing on the current thread, used to add child jobs and continuations
+struct jobContext_t {
+	idParallelJobList_Threads *	jobList;
+	int							jobIndex;
+	int							signal;
+	unsigned int				threadNum;
+};
+static ID_TLS currentJobContext;
+
+/*
+========================
+idParallelJobList_Threads::ExecuteJob
+========================
+*/
+void idParallelJobList_Threads::ExecuteJob( unsigned int threadNum, int jobIndex ) {
+	job_t & job = GetJob( jobIndex );
+
+	jobContext_t context;
+	context.jobList = this;
+	context.jobIndex = jobIndex;
+	context.signal = job.signal;
+	context.threadNum = threadNum;
+	const ptrdiff_t prevContext = currentJobContext;
+	currentJobContext = (ptrdiff_t) & context;
+
+	uint64 jobStart = Sys_Microseconds();
+
+	job.function( job.data );
+	job.executed = 1;
+
+	uint64 jobEnd = Sys_Microseconds();
+	deferredThreadStats.threadExecTime[threadNum] += jobEnd - jobStart;
+
+	currentJobContext = prevContext;
+
+#ifndef _DEBUG
+	if ( jobs_longJobMicroSec.GetInteger() > 0 ) {
+		if ( jobEnd - jobStart > jobs_longJobMicroSec.GetInteger()
+			&& GetId() != JOBLIST_UTILITY ) {
+			longJobTime = ( jobEnd - jobStart ) * ( 1.0f / 1000.0f );
+			longJobFunc = job.function;
+			longJobData = job.data;
+			const char * jobName = GetJobName( job.function );
+			const char * jobListName = GetJobListName( GetId() );
+			idLib::Printf( "%1.1f milliseconds for a single '%s' job from job list %s on thread %d\n", longJobTime, jobName, jobListName, threadNum );
+		}
+	}
+#endif
+
+	CompleteJob( threadNum, jobIndex );
+}
+
+/*
+========================
+idParallelJobList_Threads::CompleteJob
+
+Called when a job is executed and whenever one of its children is done. The job
+is only done once all of its children are done as well, at which point the
+continuation of the job is added as a child of the parent job.
+========================
+*/
+void idParallelJobList_Threads::CompleteJob( unsigned int threadNum, int jobIndex ) {
+	while ( jobIndex >= 0 ) {
+		job_t & job = GetJob( jobIndex );
+		if ( job.pending.Decrement() != 0 ) {
+			return;
+		}
+		if ( job.continuation != NULL ) {
+			AddChildJobInternal( threadNum, job.parent, job.signal, job.continuation, job.continuationData );
+			job.continuation = NULL;
+		}
+		jobIndex = job.parent;
+	}
+}
+
+/*
+========================
+idParallelJobList_Threads::AddChildJobInternal
+
+The child job is counted towards the signal before the adding job is done so
+neither a sync point nor Wait() can pass until the child job has executed.
+========================
+*/
+void idParallelJobList_Threads::AddChildJobInternal( unsigned int threadNum, int parent, int signal, jobRun_t function, void * data ) {
+	const int childIndex = numChildJobs.Increment() - 1;
+	if ( childIndex >= childJobs.Num() ) {
+		numChildJobs.Decrement();
+		// out of child jobs so run it right here on behalf of the parent
+		jobContext_t context;
+		context.jobList = this;
+		context.jobIndex = parent;
+		context.signal = signal;
+		context.threadNum = threadNum;
+		const ptrdiff_t prevContext = currentJobContext;
+		currentJobContext = (ptrdiff_t) & context;
+		function( data );
+		currentJobContext = prevContext;
+		return;
+	}
+
+	job_t & child = childJobs[childIndex];
+	InitJob( child, function, data, signal, parent );
+	if ( parent >= 0 ) {
+		GetJob( parent ).pending.Increment();
+	}
+	signalJobCount[signal].Increment();
+
+	if ( stealing ) {
+		numStealJobsLeft.Increment();
+		deques[threadNum].Push( childIndex | CHILD_JOB_BIT );
+	} else {
+		SYS_MEMORYBARRIER;
+		// publish the child jobs in the order they were allocated
+		while ( numPublishedChildJobs.CompareExchange( childIndex, childIndex + 1 ) != childIndex ) {
+			Sys_Yield();
+		}
+	}
+}
+
+/*
+========================
+idParallelJobList_Threads::FetchChildJob
+========================
+*/
+int idParallelJobList_Threads::FetchChildJob() {
+	for ( ; ; ) {
+		const int childIndex = nextChildJob.GetValue();
+		if ( childIndex >= numPublishedChildJobs.GetValue() ) {
+			return -1;
+		}
+		if ( nextChildJob.CompareExchange( childIndex, childIndex + 1 ) == childIndex ) {
+			return ( childIndex | CHILD_JOB_BIT );
+		}
+	}
+}
+
+/*
+========================
+idParallelJobList_Threads::AddChildJob
+========================
+*/
+void idParallelJobList_Threads::AddChildJob( jobRun_t function, void * data ) {
+	const jobContext_t * context = (const jobContext_t *)(ptrdiff_t)currentJobContext;
+	if ( context == NULL || context->jobList != this ) {
+		idLib::Error( "Can't add child job '%s', not called from a job of job list %s", GetJobName( function ), GetJobListName( GetId() ) );
+	}
+	AddChildJobInternal( context->threadNum, context->jobIndex, context->signal, function, data );
+}
+
+/*
+========================
+idParallelJobList_Threads::AddContinuation
+========================
+*/
+void idParallelJobList_Threads::AddContinuation( jobRun_t function, void * data ) {
+	const jobContext_t * context = (const jobContext_t *)(ptrdiff_t)currentJobContext;
+	if ( context == NULL || context->jobList != this || context->jobIndex < 0 ) {
+		idLib::Error( "Can't add continuation '%s', not called from a job of job list %s", GetJobName( function ), GetJobListName( GetId() ) );
+	}
+	job_t & job = GetJob( context->jobIndex );
+	assert( job.continuation == NULL );
+	job.continuation = function;
+	job.continuationData = data;
+}
+
 /*
 ========================
 idParallelJobList_Threads::RunJobsInternal
@@ -553,10 +882,29 @@ int idParallelJobList_Threads::RunJobsInternal( unsigned int threadNum, threadJo
 		deferredThreadStats.startTime = Sys_Microseconds();	// first time any thread is running jobs from this list
 	}
 
+	if ( stealing ) {
+		return RunJobsStealing( threadNum, singleJob );
+	}
+
 	int result = RUN_OK;
 
 	do {
 
+		// child jobs go first so the jobs that are waiting on them can finish
+		const int childJob = FetchChildJob();
+		if ( childJob >= 0 ) {
+			ExecuteJob( threadNum, childJob );
+
+			result |= RUN_PROGRESS;
+
+			const int signal = GetJob( childJob ).signal;
+			if ( signalJobCount[signal].Decrement() == 0 && signal == signalJobCount.Num() - 1 ) {
+				deferredThreadStats.endTime = Sys_Microseconds();
+				return ( result | RUN_DONE );
+			}
+			continue;
+		}
+
 		// run through all signals and syncs before the last job that has been or is being executed
 		// this loop is really an optimization to minimize the time spent in the fetchLock section below
 		for ( ; state.lastJobIndex < (int) currentJob.GetValue() && state.lastJobIndex < jobList.Num(); state.lastJobIndex++ ) {
@@ -622,33 +970,15 @@ int idParallelJobList_Threads::RunJobsInternal( unsigned int threadNum, threadJo
 
 		// if at the end of the job list we're done
 		if ( state.nextJobIndex >= jobList.Num() ) {
+			// unless there are child jobs that may add more child jobs
+			if ( numChildJobs.GetValue() > 0 && signalJobCount[signalJobCount.Num() - 1].GetValue() > 0 ) {
+				return ( result | RUN_STALLED );
+			}
 			return ( result | RUN_DONE );
 		}
 
 		// execute the next job
-		{
-			uint64 jobStart = Sys_Microseconds();
-
-			jobList[state.nextJobIndex].function( jobList[state.nextJobIndex].data );
-			jobList[state.nextJobIndex].executed = 1;
-
-			uint64 jobEnd = Sys_Microseconds();
-			deferredThreadStats.threadExecTime[threadNum] += jobEnd - jobStart;
-
-#ifndef _DEBUG
-			if ( jobs_longJobMicroSec.GetInteger() > 0 ) {
-				if ( jobEnd - jobStart > jobs_longJobMicroSec.GetInteger()
-					&& GetId() != JOBLIST_UTILITY ) {
-					longJobTime = ( jobEnd - jobStart ) * ( 1.0f / 1000.0f );
-					longJobFunc = jobList[state.nextJobIndex].function;
-					longJobData = jobList[state.nextJobIndex].data;
-					const char * jobName = GetJobName( jobList[state.nextJobIndex].function );
-					const char * jobListName = GetJobListName( GetId() );
-					idLib::Printf( "%1.1f milliseconds for a single '%s' job from job list %s on thread %d\n", longJobTime, jobName, jobListName, threadNum );
-				}
-			}
-#endif
-		}
+		ExecuteJob( threadNum, state.nextJobIndex );
 
 		result |= RUN_PROGRESS;
 
@@ -666,6 +996,163 @@ int idParallelJobList_Threads::RunJobsInternal( unsigned int threadNum, threadJo
 	return result;
 }
 
+/*
+========================
+idParallelJobList_Threads::SetupWorkStealing
+
+Splits the submitted jobs into phases at the SYNC_SYNCHRONIZE points and each
+phase into one contiguous chunk per unit. A chunk is pushed onto the deque of
+the thread that claims it, which normally is the unit that owns the chunk, but
+idle threads will claim chunks of units that have not picked up the list yet.
+========================
+*/
+void idParallelJobList_Threads::SetupWorkStealing( int numUnits ) {
+	assert( !done );
+	assert( numUnits >= 1 && numUnits <= MAX_THREADS );
+
+	if ( jobList.Num() == 0 ) {
+		return;
+	}
+
+	// the last job is the JOB_LIST_DONE marker which is not needed when stealing
+	const int numJobs = jobList.Num() - 1;
+	assert( jobList[numJobs].data == & JOB_LIST_DONE );
+
+	phases.SetNum( 0 );
+	jobPhase_t * phase = & phases.Alloc();
+	phase->firstJob = 0;
+	phase->waitSignal = -1;
+
+	for ( int i = 0; i < numJobs; i++ ) {
+		if ( jobList[i].data == & JOB_SYNCHRONIZE ) {
+			assert( jobList[i].signal > 0 );
+			phase->numJobs = i - phase->firstJob;
+			phase = & phases.Alloc();
+			phase->firstJob = i;
+			phase->waitSignal = jobList[i].signal - 1;
+		}
+	}
+	phase->numJobs = numJobs - phase->firstJob;
+
+	numStealUnits = numUnits;
+	chunkClaims.SetNum( phases.Num() * numUnits );
+	for ( int i = 0; i < chunkClaims.Num(); i++ ) {
+		chunkClaims[i].SetValue( 0 );
+	}
+	for ( int i = 0; i < numUnits; i++ ) {
+		deques[i].Init( jobList.Num() + childJobs.Num() );
+	}
+	numStealJobsLeft.SetValue( numJobs );
+
+	// keep the last signal raised until every job is done, because when stealing
+	// jobs before the last signal may still be queued after the last signal is done
+	signalJobCount[signalJobCount.Num() - 1].Increment();
+
+	stealing = true;
+}
+
+/*
+========================
+idParallelJobList_Threads::ClaimChunk
+========================
+*/
+bool idParallelJobList_Threads::ClaimChunk( int phase, int unit, unsigned int threadNum ) {
+	if ( chunkClaims[phase * numStealUnits + unit].Increment() != 1 ) {
+		return false;
+	}
+	const jobPhase_t & p = phases[phase];
+	const int first = p.firstJob + ( p.numJobs * unit ) / numStealUnits;
+	const int last = p.firstJob + ( p.numJobs * ( unit + 1 ) ) / numStealUnits;
+	// push in reverse so the owner pops the jobs in submission order
+	for ( int i = last - 1; i >= first; i-- ) {
+		deques[threadNum].Push( i );
+	}
+	return ( last > first );
+}
+
+/*
+========================
+idParallelJobList_Threads::FetchStealJob
+========================
+*/
+int idParallelJobList_Threads::FetchStealJob( unsigned int threadNum ) {
+	idJobDeque & deque = deques[threadNum];
+
+	int jobIndex = deque.Pop();
+	if ( jobIndex >= 0 ) {
+		return jobIndex;
+	}
+
+	// claim new chunks from the phases that are no longer waiting on a signal, own chunks first
+	for ( int i = 0; i < numStealUnits; i++ ) {
+		const int unit = ( threadNum + i ) % numStealUnits;
+		for ( int phase = 0; phase < phases.Num(); phase++ ) {
+			const int waitSignal = phases[phase].waitSignal;
+			if ( waitSignal >= 0 && signalJobCount[waitSignal].GetValue() > 0 ) {
+				break;
+			}
+			if ( chunkClaims[phase * numStealUnits + unit].GetValue() == 0 && ClaimChunk( phase, unit, threadNum ) ) {
+				jobIndex = deque.Pop();
+				if ( jobIndex >= 0 ) {
+					return jobIndex;
+				}
+			}
+		}
+	}
+
+	// steal from the other units
+	for ( int i = 1; i < numStealUnits; i++ ) {
+		const int victim = ( threadNum + i ) % numStealUnits;
+		jobIndex = deques[victim].Steal();
+		if ( jobIndex >= 0 ) {
+			return jobIndex;
+		}
+	}
+	return -1;
+}
+
+/*
+========================
+idParallelJobList_Threads::RunJobsStealing
+========================
+*/
+int idParallelJobList_Threads::RunJobsStealing( unsigned int threadNum, bool singleJob ) {
+	if ( (int)threadNum >= numStealUnits ) {
+		// this thread was not part of the submit
+		return RUN_DONE;
+	}
+
+	int result = RUN_OK;
+
+	do {
+		const int jobIndex = FetchStealJob( threadNum );
+		if ( jobIndex < 0 ) {
+			if ( numStealJobsLeft.GetValue() <= 0 ) {
+				return ( result | RUN_DONE );
+			}
+			// the remaining jobs are either executing or waiting on a synchronization point
+			return ( result | RUN_STALLED );
+		}
+
+		ExecuteJob( threadNum, jobIndex );
+
+		result |= RUN_PROGRESS;
+
+		signalJobCount[GetJob( jobIndex ).signal].Decrement();
+
+		if ( numStealJobsLeft.Decrement() == 0 ) {
+			// this was the very last job of the job list
+			deferredThreadStats.endTime = Sys_Microseconds();
+			doneGuards[currentDoneGuard].Decrement();
+			signalJobCount[signalJobCount.Num() - 1].Decrement();
+			return ( result | RUN_DONE );
+		}
+
+	} while( ! singleJob );
+
+	return result;
+}
+
 /*
 ========================
 idParallelJobList_Threads::RunJobs
@@ -755,6 +1242,26 @@ void idParallelJobList::InsertSyncPoint( jobSyncType_t syncType ) {
 	jobListThreads->InsertSyncPoint( syncType );
 }
 
+/*
+========================
+idParallelJobList::AddChildJob
+========================
+*/
+void idParallelJobList::AddChildJob( jobRun_t function, void * data ) {
+	assert( IsRegisteredJob( function ) );
+	jobListThreads->AddChildJob( function, data );
+}
+
+/*
+========================
+idParallelJobList::AddContinuation
+========================
+*/
+void idParallelJobList::AddContinuation( jobRun_t function, void * data ) {
+	assert( IsRegisteredJob( function ) );
+	jobListThreads->AddContinuation( function, data );
+}
+
 /*
 ========================
 idParallelJobList::Wait
@@ -1090,9 +1597,14 @@ extern void Sys_CPUCount( int & logicalNum, int & coreNum, int & packageNum );
 //
 // Hyperthreading is not dead yet.  Intel's Core i7 Processor is quad-core with HT for 8 logicals.
 
-// DOOM3: We don't have that many jobs, so just set this fairly low so we don't spin up a ton of idle threads
-#define MAX_JOB_THREADS		2
+// DOOM3: We don't have that many jobs, so just default this fairly low, the job threads are only
+// started when jobs_numThreads or a job list asks for them so a higher maximum doesn't spin up a
+// ton of idle threads
+#define MAX_JOB_THREADS		32
 #define NUM_JOB_THREADS		"2"
+// JOBLIST_PARALLELISM_MAX_THREADS used all job threads back when there were only two of them,
+// it keeps using at least that many now that the maximum is higher
+#define NUM_MAX_PARALLELISM_THREADS	2
 #define JOB_THREAD_CORES	{	CORE_ANY, CORE_ANY, CORE_ANY, CORE_ANY,	\
 								CORE_ANY, CORE_ANY, CORE_ANY, CORE_ANY,	\
 								CORE_ANY, CORE_ANY, CORE_ANY, CORE_ANY,	\
@@ -1128,10 +1640,15 @@ public:
 private:
 	idJobThread						threads[MAX_JOB_THREADS];
 	unsigned int					maxThreads;
+	unsigned int					threadLimit;		// never start more threads than there are cores
+	volatile unsigned int			numStartedThreads;
+	idSysMutex						startThreadsMutex;
 	int								numPhysicalCpuCores;
 	int								numLogicalCpuCores;
 	int								numCpuPackages;
 	idStaticList< idParallelJobList *, MAX_JOBLISTS >	jobLists;
+
+	void						StartThreads( unsigned int numThreads );
 };
 
 idParallelJobManagerLocal parallelJobManagerLocal;
@@ -1152,16 +1669,37 @@ idParallelJobManagerLocal::Init
 ========================
 */
 void idParallelJobManagerLocal::Init() {
+	Sys_CPUCount( numPhysicalCpuCores, numLogicalCpuCores, numCpuPackages );
+
+	threadLimit = idMath::ClampInt( NUM_MAX_PARALLELISM_THREADS, MAX_JOB_THREADS, Max( numPhysicalCpuCores, numLogicalCpuCores ) );
+	numStartedThreads = 0;
+	maxThreads = idMath::ClampInt( 0, threadLimit, jobs_numThreads.GetInteger() );
+	StartThreads( maxThreads );
+}
+
+/*
+========================
+idParallelJobManagerLocal::StartThreads
+
+The job threads are started on demand, a thread keeps running until shutdown once started.
+========================
+*/
+void idParallelJobManagerLocal::StartThreads( unsigned int numThreads ) {
+	numThreads = Min( numThreads, threadLimit );
+	if ( numThreads <= numStartedThreads ) {
+		return;
+	}
+
+	idScopedCriticalSection lock( startThreadsMutex );
+
 	// on consoles this will have specific cores for the threads, but on PC they will all be CORE_ANY
 	core_t cores[] = JOB_THREAD_CORES;
 	assert( sizeof( cores ) / sizeof( cores[0] ) >= MAX_JOB_THREADS );
 
-	for ( int i = 0; i < MAX_JOB_THREADS; i++ ) {
+	for ( unsigned int i = numStartedThreads; i < numThreads; i++ ) {
 		threads[i].Start( cores[i], i );
+		numStartedThreads = i + 1;
 	}
-	maxThreads = jobs_numThreads.GetInteger();
-
-	Sys_CPUCount( numPhysicalCpuCores, numLogicalCpuCores, numCpuPackages );
 }
 
 /*
@@ -1170,7 +1708,7 @@ idParallelJobManagerLocal::Shutdown
 ========================
 */
 void idParallelJobManagerLocal::Shutdown() {
-	for ( int i = 0; i < MAX_JOB_THREADS; i++ ) {
+	for ( unsigned int i = 0; i < numStartedThreads; i++ ) {
 		threads[i].StopThread();
 	}
 }
@@ -1201,7 +1739,7 @@ void idParallelJobManagerLocal::FreeJobList( idParallelJobList * jobList ) {
 		return;
 	}
 	// wait for all job threads to finish because job list deletion is not thread safe
-	for ( unsigned int i = 0; i < maxThreads; i++ ) {
+	for ( unsigned int i = 0; i < numStartedThreads; i++ ) {
 		threads[i].WaitForThread();
 	}
 	int index = jobLists.FindIndex( jobList );
@@ -1266,7 +1804,7 @@ idParallelJobManagerLocal::Submit
 */
 void idParallelJobManagerLocal::Submit( idParallelJobList_Threads * jobList, int parallelism ) {
 	if ( jobs_numThreads.IsModified() ) {
-		maxThreads = idMath::ClampInt( 0, MAX_JOB_THREADS, jobs_numThreads.GetInteger() );
+		maxThreads = idMath::ClampInt( 0, threadLimit, jobs_numThreads.GetInteger() );
 		jobs_numThreads.ClearModified();
 	}
 
@@ -1275,15 +1813,21 @@ void idParallelJobManagerLocal::Submit( idParallelJobList_Threads * jobList, int
 	if ( parallelism == JOBLIST_PARALLELISM_DEFAULT ) {
 		numThreads = maxThreads;
 	} else if ( parallelism == JOBLIST_PARALLELISM_MAX_CORES ) {
-		numThreads = numLogicalCpuCores;
+		numThreads = Min( numLogicalCpuCores, (int)threadLimit );
 	} else if ( parallelism == JOBLIST_PARALLELISM_MAX_THREADS ) {
-		numThreads = MAX_JOB_THREADS;
-	} else if ( parallelism > MAX_JOB_THREADS ) {
-		numThreads = MAX_JOB_THREADS;
+		numThreads = Max( (int)maxThreads, NUM_MAX_PARALLELISM_THREADS );
+	} else if ( parallelism > (int)threadLimit ) {
+		numThreads = threadLimit;
 	} else {
 		numThreads = parallelism;
 	}
 
+	StartThreads( Max( numThreads, 0 ) );
+
+	if ( jobs_workStealing.GetBool() ) {
+		jobList->SetupWorkStealing( Max( numThreads, 1 ) );
+	}
+
 	if ( numThreads <= 0 ) {
 		threadJobListState_t state( jobList->GetVersion() );
 		jobList->RunJobs( 0, state, false );
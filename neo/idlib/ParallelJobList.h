@@ -60,7 +60,7 @@ enum jobListPriority_t {
 enum jobListParallelism_t {
 	JOBLIST_PARALLELISM_DEFAULT			= -1,	// use "jobs_numThreads" number of threads
 	JOBLIST_PARALLELISM_MAX_CORES		= -2,	// use a thread for each logical core (includes hyperthreads)
-	JOBLIST_PARALLELISM_MAX_THREADS		= -3	// use the maximum number of job threads, which can help if there is IO to overlap
+	JOBLIST_PARALLELISM_MAX_THREADS		= -3	// use "jobs_numThreads" but at least two threads, which can help if there is IO to overlap
 };
 
 #define assert_spu_local_store( ptr )
@@ -85,6 +85,14 @@ public:
 	CellSpursJob128 *		AddJobSPURS();
 	void					InsertSyncPoint( jobSyncType_t syncType );
 
+	// Add a job from inside a job that is executing from this list. The child job counts
+	// towards the same signal as the job that adds it, so sync points and Wait() also wait
+	// for all child jobs.
+	void					AddChildJob( jobRun_t function, void * data );
+	// Run the given function once the job that is executing from this list and all the
+	// child jobs it added (recursively) are done. Only one continuation per job.
+	void					AddContinuation( jobRun_t function, void * data );
+
 	// Submit the jobs in this list.
 	void					Submit( idParallelJobList * waitForJobList = NULL, int parallelism = JOBLIST_PARALLELISM_DEFAULT );
 	// Wait for the jobs in this list to finish. Will spin in place if any jobs are not done.
@@ -116,6 +116,13 @@ public:
 	// atomically subtracts a value from the integer and returns the new value
 	int					Sub( int v ) { return Sys_InterlockedSub( value, (interlockedInt_t) v ); }
 
+	// atomically sets a new value and returns the previous value
+	int					Exchange( int v ) { return Sys_InterlockedExchange( value, (interlockedInt_t) v ); }
+
+	// atomically sets the integer to 'v' only if the current value is equal to 'comparand'
+	// and returns the previous value
+	int					CompareExchange( int comparand, int v ) { return Sys_InterlockedCompareExchange( value, (interlockedInt_t) comparand, (interlockedInt_t) v ); }
+
 	// returns the current value of the integer
 	int					GetValue() const { return value; }
 
@@ -40,6 +40,8 @@ const float LCP_BOUND_EPSILON			= 1e-5f;
 const float LCP_ACCEL_EPSILON			= 1e-5f;
 const float LCP_DELTA_ACCEL_EPSILON		= 1e-9f;
 const float LCP_DELTA_FORCE_EPSILON		= 1e-9f;
+const float LCP_GAUSS_SEIDEL_EPSILON	= 1e-4f;
+const float LCP_GAUSS_SEIDEL_MIN_DIAGONAL	= 1e-9f;
 
 #define IGNORE_UNSATISFIABLE_VARIABLES
 
@@ -2970,6 +2972,134 @@ bool idLCP_Symmetric::Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b,
 	return true;
 }
 
+/*
+================================================================================================
+
+	idLCP_GaussSeidel
+
+================================================================================================
+*/
+
+/*
+================================================
+idLCP_GaussSeidel
+
+Projected Gauss-Seidel iteration. The non-zero off-diagonal entries of each row are gathered
+once per Solve so the iterations only touch the coupled variables, which keeps the cost close
+to linear for the sparse matrices of independent constraints.
+================================================
+*/
+class idLCP_GaussSeidel : public idLCP {
+public:
+	virtual bool	Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b, const idVecX &o_lo, const idVecX &o_hi, const int *o_boxIndex );
+
+private:
+	idList<int>		rowStart;			// first entry of each row in columns and values
+	idList<int>		columns;			// column of each non-zero off-diagonal entry
+	idList<float>	values;				// value of each non-zero off-diagonal entry
+	idList<float>	invDiagonal;		// reciprocal of the diagonal, zero for unsatisfiable variables
+	idList<int>		order;				// variables without box index first
+};
+
+/*
+========================
+idLCP_GaussSeidel::Solve
+========================
+*/
+bool idLCP_GaussSeidel::Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b, const idVecX &o_lo, const idVecX &o_hi, const int *o_boxIndex ) {
+	const int n = o_m.GetNumRows();
+
+	assert( ((n+3)&~3) == o_m.GetNumColumns() || n == o_m.GetNumColumns() );
+	assert( o_x.GetSize() == n );
+	assert( o_b.GetSize() == n );
+	assert( o_lo.GetSize() == n );
+	assert( o_hi.GetSize() == n );
+
+	numIterations = 0;
+	residual = 0.0f;
+
+	rowStart.SetNum( n + 1 );
+	columns.SetNum( n * n );
+	values.SetNum( n * n );
+	invDiagonal.SetNum( n );
+	order.SetNum( n );
+
+	// gather the non-zero off-diagonal entries
+	int numEntries = 0;
+	int numOrdered = 0;
+	for ( int i = 0; i < n; i++ ) {
+		const float * row = o_m[i];
+		rowStart[i] = numEntries;
+		for ( int j = 0; j < n; j++ ) {
+			if ( row[j] != 0.0f && j != i ) {
+				columns[numEntries] = j;
+				values[numEntries] = row[j];
+				numEntries++;
+			}
+		}
+		invDiagonal[i] = ( row[i] > LCP_GAUSS_SEIDEL_MIN_DIAGONAL ) ? 1.0f / row[i] : 0.0f;
+		if ( o_boxIndex == NULL || o_boxIndex[i] == -1 ) {
+			order[numOrdered++] = i;
+		}
+	}
+	rowStart[n] = numEntries;
+
+	// the box constrained variables come last so their bounds use the updated forces
+	if ( o_boxIndex != NULL ) {
+		for ( int i = 0; i < n; i++ ) {
+			if ( o_boxIndex[i] != -1 ) {
+				order[numOrdered++] = i;
+			}
+		}
+	}
+
+	float * x = o_x.ToFloatPtr();
+
+	while ( numIterations < maxIterations ) {
+		float maxDelta = 0.0f;
+		float maxForce = 0.0f;
+
+		for ( int k = 0; k < n; k++ ) {
+			const int i = order[k];
+
+			float s = o_b[i];
+			for ( int e = rowStart[i]; e < rowStart[i + 1]; e++ ) {
+				s -= values[e] * x[columns[e]];
+			}
+
+			float lo = o_lo[i];
+			float hi = o_hi[i];
+			if ( o_boxIndex != NULL && o_boxIndex[i] != -1 ) {
+				const float f = x[o_boxIndex[i]];
+				lo = -idMath::Fabs( lo * f );
+				hi = idMath::Fabs( hi * f );
+			}
+
+			const float f = idMath::ClampFloat( lo, hi, s * invDiagonal[i] );
+			maxDelta = Max( maxDelta, idMath::Fabs( f - x[i] ) );
+			maxForce = Max( maxForce, idMath::Fabs( f ) );
+			x[i] = f;
+		}
+
+		numIterations++;
+		residual = maxDelta;
+
+		if ( maxDelta <= LCP_GAUSS_SEIDEL_EPSILON * Max( 1.0f, maxForce ) ) {
+			break;
+		}
+	}
+
+	if ( IEEE_FLT_IS_NAN( residual ) || IEEE_FLT_IS_INF( residual ) ) {
+		if ( lcp_showFailures.GetBool() ) {
+			idLib::Printf( "idLCP_GaussSeidel::Solve: diverged\n" );
+		}
+		o_x.Zero();
+		return false;
+	}
+
+	return true;
+}
+
 /*
 ================================================================================================
 
@@ -3000,6 +3130,17 @@ idLCP *idLCP::AllocSymmetric() {
 	return lcp;
 }
 
+/*
+========================
+idLCP::AllocGaussSeidel
+========================
+*/
+idLCP *idLCP::AllocGaussSeidel() {
+	idLCP *lcp = new idLCP_GaussSeidel;
+	lcp->SetMaxIterations( 16 );
+	return lcp;
+}
+
 /*
 ========================
 idLCP::~idLCP
@@ -3026,6 +3167,111 @@ int idLCP::GetMaxIterations() {
 	return maxIterations;
 }
 
+#ifdef ENABLE_TEST_CODE
+
+#define TEST_GAUSS_SEIDEL_CONTACTS		32
+
+/*
+========================
+GaussSeidel_Test
+
+Contact-like problems with a normal row and two friction rows boxed by it. The iterative
+solver is compared against the pivoting solver when starting from zero and when warm started
+from the solution of a slightly different problem.
+========================
+*/
+static void GaussSeidel_Test() {
+	const int n = TEST_GAUSS_SEIDEL_CONTACTS * 3;
+	const int paddedSize = ( n + 3 ) & ~3;
+
+	idMatX m;
+	idVecX b, b0, lo, hi, x0, x1, x2, x3;
+	idTempArray< int > boxIndex( n );
+
+	idRandom srnd( 13 );
+
+	// every contact couples with its own rows and with the next contact
+	m.Zero( n, paddedSize );
+	for ( int i = 0; i < n; i++ ) {
+		m[i][i] = 4.0f + srnd.RandomFloat();
+		for ( int j = i + 1; j < n && j < ( i / 3 + 2 ) * 3; j++ ) {
+			const float v = srnd.CRandomFloat() * 0.5f;
+			m[i][j] = v;
+			m[j][i] = v;
+		}
+	}
+
+	b.SetSize( n );
+	b0.SetSize( n );
+	lo.SetSize( n );
+	hi.SetSize( n );
+	for ( int i = 0; i < n; i++ ) {
+		if ( ( i % 3 ) == 0 ) {
+			b[i] = srnd.RandomFloat() * 10.0f;
+			lo[i] = 0.0f;
+			hi[i] = idMath::INFINITY;
+			boxIndex[i] = -1;
+		} else {
+			b[i] = srnd.CRandomFloat() * 10.0f;
+			lo[i] = -0.5f;
+			hi[i] = 0.5f;
+			boxIndex[i] = i - ( i % 3 );
+		}
+		b0[i] = b[i] + srnd.CRandomFloat() * 0.1f;
+	}
+
+	idLCP * symmetric = idLCP::AllocSymmetric();
+	idLCP * gaussSeidel = idLCP::AllocGaussSeidel();
+	gaussSeidel->SetMaxIterations( 64 );
+
+	idTimer timer;
+
+	// solution of the previous "frame" used for warm starting
+	x0.Zero( n );
+	symmetric->Solve( m, x0, b0, lo, hi, boxIndex.Ptr() );
+
+	int64 clocksSymmetric = 0xFFFFFFFFFFFF;
+	for ( int j = 0; j < NUM_TESTS; j++ ) {
+		x1.Zero( n );
+		timer.Clear();
+		timer.Start();
+		symmetric->Solve( m, x1, b, lo, hi, boxIndex.Ptr() );
+		timer.Stop();
+		clocksSymmetric = Min( clocksSymmetric, timer.ClockTicks() );
+	}
+	PrintClocks( "idLCP_Symmetric", n, clocksSymmetric );
+
+	int64 clocksCold = 0xFFFFFFFFFFFF;
+	for ( int j = 0; j < NUM_TESTS; j++ ) {
+		x2.Zero( n );
+		timer.Clear();
+		timer.Start();
+		gaussSeidel->Solve( m, x2, b, lo, hi, boxIndex.Ptr() );
+		timer.Stop();
+		clocksCold = Min( clocksCold, timer.ClockTicks() );
+	}
+	const int coldIterations = gaussSeidel->GetNumIterations();
+	const char * result = x1.Compare( x2, 1e-2f ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "idLCP_GaussSeidel cold %2d it %s", coldIterations, result ), n, clocksCold, clocksSymmetric );
+
+	int64 clocksWarm = 0xFFFFFFFFFFFF;
+	for ( int j = 0; j < NUM_TESTS; j++ ) {
+		x3 = x0;
+		timer.Clear();
+		timer.Start();
+		gaussSeidel->Solve( m, x3, b, lo, hi, boxIndex.Ptr() );
+		timer.Stop();
+		clocksWarm = Min( clocksWarm, timer.ClockTicks() );
+	}
+	const int warmIterations = gaussSeidel->GetNumIterations();
+	result = x1.Compare( x3, 1e-2f ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "idLCP_GaussSeidel warm %2d it %s", warmIterations, result ), n, clocksWarm, clocksSymmetric );
+
+	delete symmetric;
+	delete gaussSeidel;
+}
+#endif
+
 /*
 ========================
 idLCP::Test_f
@@ -3037,5 +3283,6 @@ void idLCP::Test_f( const idCmdArgs &args ) {
 	LowerTriangularSolve_Test();
 	LowerTriangularSolveTranspose_Test();
 	LDLT_Factor_Test();
+	GaussSeidel_Test();
 #endif
 }
@@ -55,13 +55,18 @@ If boxIndex != NULL and boxIndex[i] != -1, then
 
 Before calculating any of the bounded x[i] with boxIndex[i] != -1, the solver calculates all 
 unbounded x[i] and all x[i] with boxIndex[i] == -1.
+
+The Gauss-Seidel solver is iterative and only approximates the solution. It starts from the 
+contents of 'x' instead of zero, so passing in the solution of the previous frame warm starts it.
 ================================================
 */
 class idLCP {
 public:
 	static idLCP *	AllocSquare();		// 'A' must be a square matrix
 	static idLCP *	AllocSymmetric();	// 'A' must be a symmetric matrix
+	static idLCP *	AllocGaussSeidel();	// 'A' must have a positive diagonal, 'x' is the initial guess
 
+					idLCP() : maxIterations( 0 ), numIterations( 0 ), residual( 0.0f ) {}
 	virtual			~idLCP();
 
 	virtual bool	Solve( const idMatX &A, idVecX &x, const idVecX &b, const idVecX &lo, 
@@ -70,10 +75,16 @@ public:
 	virtual void	SetMaxIterations( int max );
 	virtual int		GetMaxIterations();
 
+					// statistics of the last Solve, only set by the iterative solver
+	int				GetNumIterations() const { return numIterations; }
+	float			GetResidual() const { return residual; }
+
 	static void		Test_f( const idCmdArgs &args );
 
 protected:
 	int				maxIterations;
+	int				numIterations;		// number of iterations used by the last Solve
+	float			residual;			// largest change of a variable during the last iteration
 };
 
 #endif // !__MATH_LCP_H__
@@ -35,9 +35,31 @@ If you have questions concerning this license or the applicable additional terms
 //
 //===============================================================
 
-float	idMatX::temp[MATX_MAX_TEMP+4];
+float	idMatX::temp[MATX_MAX_TEMP*MATX_MAX_TEMP_POOLS+4];
 float *	idMatX::tempPtr = (float *) ( ( (int) idMatX::temp + 15 ) & ~15 );
-int		idMatX::tempIndex = 0;
+int		idMatX::tempIndex[MATX_MAX_TEMP_POOLS];
+ID_TLS	idMatX::tempPool;
+interlockedInt_t	idMatX::numTempPools = 0;
+
+/*
+========================
+idMatX::GetTempPool
+
+A thread claims a temporary memory pool the first time it needs one and keeps it
+for the rest of the process, the pool is not recycled when the thread exits.
+========================
+*/
+int idMatX::GetTempPool() {
+	ptrdiff_t pool = tempPool;
+	if ( pool == 0 ) {
+		pool = Sys_InterlockedIncrement( numTempPools );
+		if ( pool > MATX_MAX_TEMP_POOLS ) {
+			idLib::FatalError( "idMatX: more than %d threads use temporary memory", MATX_MAX_TEMP_POOLS );
+		}
+		tempPool = pool;
+	}
+	return (int)pool - 1;
+}
 
 
 /*
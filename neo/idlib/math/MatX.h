@@ -36,12 +36,16 @@ idMatX - arbitrary sized dense real matrix
 
 The matrix lives on 16 byte aligned and 16 byte padded memory.
 
-NOTE: due to the temporary memory pool idMatX cannot be used by multiple threads.
+Intermediate results are stored in a temporary memory pool. Every thread that uses
+idMatX gets its own pool, so at most MATX_MAX_TEMP_POOLS threads can use it. Pools
+are never given back, a thread that exits keeps its pool, so only long lived threads
+like the main and job threads should use idMatX.
 
 ===============================================================================
 */
 
 #define MATX_MAX_TEMP		1024
+#define MATX_MAX_TEMP_POOLS	40			// threads that can use temporary memory at the same time
 #define MATX_QUAD( x )		( ( ( ( x ) + 3 ) & ~3 ) * sizeof( float ) )
 #define MATX_CLEAREND()		int s = numRows * numColumns; while( s < ( ( s + 3 ) & ~3 ) ) { mat[s++] = 0.0f; }
 #define MATX_ALLOCA( n )	( (float *) _alloca16( MATX_QUAD( n ) ) )
@@ -245,9 +249,13 @@ private:
 	int				alloced;				// floats allocated, if -1 then mat points to data set with SetData
 	float *			mat;					// memory the matrix is stored
 
-	static float	temp[MATX_MAX_TEMP+4];	// used to store intermediate results
+	static float	temp[MATX_MAX_TEMP*MATX_MAX_TEMP_POOLS+4];	// used to store intermediate results
 	static float *	tempPtr;				// pointer to 16 byte aligned temporary memory
-	static int		tempIndex;				// index into memory pool, wraps around
+	static int		tempIndex[MATX_MAX_TEMP_POOLS];	// index into the memory pool of each thread, wraps around
+	static ID_TLS	tempPool;				// memory pool of the calling thread plus one, zero until first used
+	static interlockedInt_t	numTempPools;	// number of memory pools handed out
+
+	static int		GetTempPool();
 
 private:
 	void			SetTempSize( int rows, int columns );
@@ -281,7 +289,7 @@ idMatX::~idMatX
 */
 ID_INLINE idMatX::~idMatX() {
 	// if not temp memory
-	if ( mat != NULL && ( mat < idMatX::tempPtr || mat > idMatX::tempPtr + MATX_MAX_TEMP ) && alloced != -1 ) {
+	if ( mat != NULL && ( mat < idMatX::tempPtr || mat > idMatX::tempPtr + MATX_MAX_TEMP * MATX_MAX_TEMP_POOLS ) && alloced != -1 ) {
 		Mem_Free16( mat );
 	}
 }
@@ -396,7 +404,7 @@ ID_INLINE idMatX &idMatX::operator=( const idMatX &a ) {
 #else
 	memcpy( mat, a.mat, s * sizeof( float ) );
 #endif
-	idMatX::tempIndex = 0;
+	idMatX::tempIndex[ GetTempPool() ] = 0;
 	return *this;
 }
 
@@ -514,7 +522,7 @@ ID_INLINE idMatX &idMatX::operator*=( const float a ) {
 		mat[i] *= a;
 	}
 #endif
-	idMatX::tempIndex = 0;
+	idMatX::tempIndex[ GetTempPool() ] = 0;
 	return *this;
 }
 
@@ -525,7 +533,7 @@ idMatX::operator*=
 */
 ID_INLINE idMatX &idMatX::operator*=( const idMatX &a ) {
 	*this = *this * a;
-	idMatX::tempIndex = 0;
+	idMatX::tempIndex[ GetTempPool() ] = 0;
 	return *this;
 }
 
@@ -546,7 +554,7 @@ ID_INLINE idMatX &idMatX::operator+=( const idMatX &a ) {
 		mat[i] += a.mat[i];
 	}
 #endif
-	idMatX::tempIndex = 0;
+	idMatX::tempIndex[ GetTempPool() ] = 0;
 	return *this;
 }
 
@@ -567,7 +575,7 @@ ID_INLINE idMatX &idMatX::operator-=( const idMatX &a ) {
 		mat[i] -= a.mat[i];
 	}
 #endif
-	idMatX::tempIndex = 0;
+	idMatX::tempIndex[ GetTempPool() ] = 0;
 	return *this;
 }
 
@@ -658,7 +666,7 @@ idMatX::SetSize
 */
 ID_INLINE void idMatX::SetSize( int rows, int columns ) {
 	if ( rows != numRows || columns != numColumns || mat == NULL ) {
-		assert( mat < idMatX::tempPtr || mat > idMatX::tempPtr + MATX_MAX_TEMP );
+		assert( mat < idMatX::tempPtr || mat > idMatX::tempPtr + MATX_MAX_TEMP * MATX_MAX_TEMP_POOLS );
 		int alloc = ( rows * columns + 3 ) & ~3;
 		if ( alloc > alloced && alloced != -1 ) {
 			if ( mat != NULL ) {
@@ -683,11 +691,12 @@ ID_INLINE void idMatX::SetTempSize( int rows, int columns ) {
 
 	newSize = ( rows * columns + 3 ) & ~3;
 	assert( newSize < MATX_MAX_TEMP );
-	if ( idMatX::tempIndex + newSize > MATX_MAX_TEMP ) {
-		idMatX::tempIndex = 0;
+	const int pool = GetTempPool();
+	if ( idMatX::tempIndex[pool] + newSize > MATX_MAX_TEMP ) {
+		idMatX::tempIndex[pool] = 0;
 	}
-	mat = idMatX::tempPtr + idMatX::tempIndex;
-	idMatX::tempIndex += newSize;
+	mat = idMatX::tempPtr + pool * MATX_MAX_TEMP + idMatX::tempIndex[pool];
+	idMatX::tempIndex[pool] += newSize;
 	alloced = newSize;
 	numRows = rows;
 	numColumns = columns;
@@ -700,7 +709,7 @@ idMatX::SetData
 ========================
 */
 ID_INLINE void idMatX::SetData( int rows, int columns, float *data ) {
-	assert( mat < idMatX::tempPtr || mat > idMatX::tempPtr + MATX_MAX_TEMP );
+	assert( mat < idMatX::tempPtr || mat > idMatX::tempPtr + MATX_MAX_TEMP * MATX_MAX_TEMP_POOLS );
 	if ( mat != NULL && alloced != -1 ) {
 		Mem_Free16( mat );
 	}
@@ -830,6 +830,338 @@ void TestUntransformJoints() {
 	PrintClocks( va( "   simd->UntransformJoints() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
 }
 
+/*
+============
+TestTransformVertsAndTangents
+============
+*/
+void TestTransformVertsAndTangents() {
+	int i, j;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	idTempArray< idJointMat > joints( COUNT );
+	idTempArray< idDrawVert > baseVerts( COUNT );
+	idTempArray< idDrawVert > verts1( COUNT );
+	idTempArray< idDrawVert > verts2( COUNT );
+	const char *result;
+
+	idRandom srnd( RANDOM_SEED );
+
+	for ( i = 0; i < COUNT; i++ ) {
+		idAngles angles;
+		angles[0] = srnd.CRandomFloat() * 180.0f;
+		angles[1] = srnd.CRandomFloat() * 180.0f;
+		angles[2] = srnd.CRandomFloat() * 180.0f;
+		joints[i].SetRotation( angles.ToMat3() );
+		idVec3 v;
+		v[0] = srnd.CRandomFloat() * 2.0f;
+		v[1] = srnd.CRandomFloat() * 2.0f;
+		v[2] = srnd.CRandomFloat() * 2.0f;
+		joints[i].SetTranslation( v );
+	}
+
+	// runs of vertices share joints and weights like they do in real meshes
+	for ( i = 0; i < COUNT; i++ ) {
+		idDrawVert & v = baseVerts[i];
+		v.Clear();
+		v.xyz[0] = srnd.CRandomFloat() * 100.0f;
+		v.xyz[1] = srnd.CRandomFloat() * 100.0f;
+		v.xyz[2] = srnd.CRandomFloat() * 100.0f;
+		v.SetNormal( idVec3( srnd.CRandomFloat(), srnd.CRandomFloat(), srnd.CRandomFloat() ).Normalized() );
+		v.SetTangent( idVec3( srnd.CRandomFloat(), srnd.CRandomFloat(), srnd.CRandomFloat() ).Normalized() );
+		v.SetBiTangentSign( srnd.CRandomFloat() );
+		if ( i > 0 && srnd.RandomInt( 4 ) != 0 ) {
+			*(unsigned int *)v.color = *(unsigned int *)baseVerts[i - 1].color;
+			*(unsigned int *)v.color2 = *(unsigned int *)baseVerts[i - 1].color2;
+			continue;
+		}
+		int remaining = 255;
+		for ( j = 0; j < 4; j++ ) {
+			v.color[j] = (byte)srnd.RandomInt( COUNT );
+			v.color2[j] = (byte)( ( j < 3 ) ? srnd.RandomInt( remaining + 1 ) : remaining );
+			remaining -= v.color2[j];
+		}
+	}
+
+	memset( verts1.Ptr(), 0, COUNT * sizeof( idDrawVert ) );
+	memset( verts2.Ptr(), 0, COUNT * sizeof( idDrawVert ) );
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_generic->TransformVertsAndTangents( verts1.Ptr(), COUNT, baseVerts.Ptr(), joints.Ptr() );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->TransformVertsAndTangents()", COUNT, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_simd->TransformVertsAndTangents( verts2.Ptr(), COUNT, baseVerts.Ptr(), joints.Ptr() );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < COUNT; i++ ) {
+		if ( verts1[i].xyz != verts2[i].xyz ) {
+			break;
+		}
+		if ( memcmp( verts1[i].normal, verts2[i].normal, sizeof( verts1[i].normal ) ) != 0 ) {
+			break;
+		}
+		if ( memcmp( verts1[i].tangent, verts2[i].tangent, sizeof( verts1[i].tangent ) ) != 0 ) {
+			break;
+		}
+	}
+	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->TransformVertsAndTangents() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+}
+
+/*
+============
+InitTestMesh
+
+Random triangles with distinct corners, so none of them are degenerate.
+============
+*/
+static void InitTestMesh( idDrawVert *verts, triIndex_t *indexes, const int numVerts, const int numIndexes ) {
+	idRandom srnd( RANDOM_SEED );
+
+	for ( int i = 0; i < numVerts; i++ ) {
+		verts[i].Clear();
+		verts[i].xyz[0] = srnd.CRandomFloat() * 100.0f;
+		verts[i].xyz[1] = srnd.CRandomFloat() * 100.0f;
+		verts[i].xyz[2] = srnd.CRandomFloat() * 100.0f;
+		verts[i].SetTexCoord( srnd.CRandomFloat() * 2.0f, srnd.CRandomFloat() * 2.0f );
+	}
+	for ( int i = 0; i < numIndexes; i += 3 ) {
+		indexes[i + 0] = srnd.RandomInt( numVerts );
+		do {
+			indexes[i + 1] = srnd.RandomInt( numVerts );
+		} while ( indexes[i + 1] == indexes[i + 0] );
+		do {
+			indexes[i + 2] = srnd.RandomInt( numVerts );
+		} while ( indexes[i + 2] == indexes[i + 0] || indexes[i + 2] == indexes[i + 1] );
+	}
+}
+
+/*
+============
+TestDeriveTriangleTangents
+============
+*/
+void TestDeriveTriangleTangents() {
+	int i, j;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	idTempArray< idDrawVert > drawVerts( COUNT );
+	idTempArray< triIndex_t > indexes( COUNT * 3 );
+	idTempArray< idVec3 > normals1( COUNT );
+	idTempArray< idVec3 > tangents1( COUNT );
+	idTempArray< idVec3 > bitangents1( COUNT );
+	idTempArray< idVec3 > normals2( COUNT );
+	idTempArray< idVec3 > tangents2( COUNT );
+	idTempArray< idVec3 > bitangents2( COUNT );
+	const char *result;
+
+	InitTestMesh( drawVerts.Ptr(), indexes.Ptr(), COUNT, COUNT * 3 );
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		normals1.Zero();
+		tangents1.Zero();
+		bitangents1.Zero();
+		StartRecordTime( start );
+		p_generic->DeriveTriangleTangents( normals1.Ptr(), tangents1.Ptr(), bitangents1.Ptr(), drawVerts.Ptr(), indexes.Ptr(), COUNT * 3 );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->DeriveTriangleTangents()", COUNT, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		normals2.Zero();
+		tangents2.Zero();
+		bitangents2.Zero();
+		StartRecordTime( start );
+		p_simd->DeriveTriangleTangents( normals2.Ptr(), tangents2.Ptr(), bitangents2.Ptr(), drawVerts.Ptr(), indexes.Ptr(), COUNT * 3 );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	// the SIMD version does the same operations in the same order, so the results must match exactly
+	for ( j = 0; j < COUNT; j++ ) {
+		if ( !normals1[j].Compare( normals2[j] ) || !tangents1[j].Compare( tangents2[j] ) || !bitangents1[j].Compare( bitangents2[j] ) ) {
+			break;
+		}
+	}
+	result = ( j >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->DeriveTriangleTangents() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+}
+
+/*
+============
+TestDeriveTriangleNormals
+============
+*/
+void TestDeriveTriangleNormals() {
+	int i, j;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	idTempArray< idDrawVert > drawVerts( COUNT );
+	idTempArray< triIndex_t > indexes( COUNT * 3 );
+	idTempArray< idVec3 > normals1( COUNT );
+	idTempArray< idVec3 > normals2( COUNT );
+	const char *result;
+
+	InitTestMesh( drawVerts.Ptr(), indexes.Ptr(), COUNT, COUNT * 3 );
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		normals1.Zero();
+		StartRecordTime( start );
+		p_generic->DeriveTriangleNormals( normals1.Ptr(), drawVerts.Ptr(), indexes.Ptr(), COUNT * 3 );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->DeriveTriangleNormals()", COUNT, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		normals2.Zero();
+		StartRecordTime( start );
+		p_simd->DeriveTriangleNormals( normals2.Ptr(), drawVerts.Ptr(), indexes.Ptr(), COUNT * 3 );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( j = 0; j < COUNT; j++ ) {
+		if ( !normals1[j].Compare( normals2[j] ) ) {
+			break;
+		}
+	}
+	result = ( j >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->DeriveTriangleNormals() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+}
+
+/*
+============
+TestNormalizeTangents
+============
+*/
+void TestNormalizeTangents() {
+	int i, j;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	idTempArray< idVec3 > normals( COUNT );
+	idTempArray< idVec3 > tangents( COUNT );
+	idTempArray< idVec3 > bitangents( COUNT );
+	idTempArray< idVec3 > normals1( COUNT );
+	idTempArray< idVec3 > tangents1( COUNT );
+	idTempArray< idVec3 > bitangents1( COUNT );
+	idTempArray< idVec3 > normals2( COUNT );
+	idTempArray< idVec3 > tangents2( COUNT );
+	idTempArray< idVec3 > bitangents2( COUNT );
+	const char *result;
+
+	idRandom srnd( RANDOM_SEED );
+
+	for ( i = 0; i < COUNT; i++ ) {
+		for ( j = 0; j < 3; j++ ) {
+			normals[i][j] = srnd.CRandomFloat() * 10.0f;
+			tangents[i][j] = srnd.CRandomFloat() * 10.0f;
+			bitangents[i][j] = srnd.CRandomFloat() * 10.0f;
+		}
+	}
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		memcpy( normals1.Ptr(), normals.Ptr(), normals.Size() );
+		memcpy( tangents1.Ptr(), tangents.Ptr(), tangents.Size() );
+		memcpy( bitangents1.Ptr(), bitangents.Ptr(), bitangents.Size() );
+		StartRecordTime( start );
+		p_generic->NormalizeTangents( normals1.Ptr(), tangents1.Ptr(), bitangents1.Ptr(), COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->NormalizeTangents()", COUNT, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		memcpy( normals2.Ptr(), normals.Ptr(), normals.Size() );
+		memcpy( tangents2.Ptr(), tangents.Ptr(), tangents.Size() );
+		memcpy( bitangents2.Ptr(), bitangents.Ptr(), bitangents.Size() );
+		StartRecordTime( start );
+		p_simd->NormalizeTangents( normals2.Ptr(), tangents2.Ptr(), bitangents2.Ptr(), COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( j = 0; j < COUNT; j++ ) {
+		if ( !normals1[j].Compare( normals2[j] ) || !tangents1[j].Compare( tangents2[j] ) || !bitangents1[j].Compare( bitangents2[j] ) ) {
+			break;
+		}
+	}
+	result = ( j >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->NormalizeTangents() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+}
+
+/*
+============
+TestDeriveUnsmoothedTangents
+============
+*/
+void TestDeriveUnsmoothedTangents() {
+	int i, j;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	idTempArray< idDrawVert > drawVerts( COUNT );
+	idTempArray< idDrawVert > drawVerts1( COUNT );
+	idTempArray< idDrawVert > drawVerts2( COUNT );
+	idTempArray< triIndex_t > indexes( COUNT * 3 );
+	idTempArray< dominantTri_t > dominantTris( COUNT );
+	const char *result;
+
+	InitTestMesh( drawVerts.Ptr(), indexes.Ptr(), COUNT, COUNT * 3 );
+
+	idRandom srnd( RANDOM_SEED );
+
+	for ( i = 0; i < COUNT; i++ ) {
+		do {
+			dominantTris[i].v2 = srnd.RandomInt( COUNT );
+		} while ( dominantTris[i].v2 == i );
+		do {
+			dominantTris[i].v3 = srnd.RandomInt( COUNT );
+		} while ( dominantTris[i].v3 == i || dominantTris[i].v3 == dominantTris[i].v2 );
+		dominantTris[i].normalizationScale[0] = srnd.CRandomFloat();
+		dominantTris[i].normalizationScale[1] = srnd.CRandomFloat();
+		dominantTris[i].normalizationScale[2] = srnd.CRandomFloat();
+	}
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		memcpy( drawVerts1.Ptr(), drawVerts.Ptr(), drawVerts.Size() );
+		StartRecordTime( start );
+		p_generic->DeriveUnsmoothedTangents( drawVerts1.Ptr(), dominantTris.Ptr(), COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->DeriveUnsmoothedTangents()", COUNT, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		memcpy( drawVerts2.Ptr(), drawVerts.Ptr(), drawVerts.Size() );
+		StartRecordTime( start );
+		p_simd->DeriveUnsmoothedTangents( drawVerts2.Ptr(), dominantTris.Ptr(), COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( j = 0; j < COUNT; j++ ) {
+		if ( memcmp( &drawVerts1[j], &drawVerts2[j], sizeof( idDrawVert ) ) != 0 ) {
+			break;
+		}
+	}
+	result = ( j >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->DeriveUnsmoothedTangents() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+}
+
 /*
 ============
 TestMath
@@ -1257,6 +1589,14 @@ void idSIMD::Test_f( const idCmdArgs &args ) {
 	TestConvertJointMatsToJointQuats();
 	TestTransformJoints();
 	TestUntransformJoints();
+	TestTransformVertsAndTangents();
+
+	idLib::common->Printf("====================================\n" );
+
+	TestDeriveTriangleTangents();
+	TestDeriveTriangleNormals();
+	TestNormalizeTangents();
+	TestDeriveUnsmoothedTangents();
 
 	idLib::common->Printf("====================================\n" );
 
@@ -101,6 +101,13 @@ public:
 	virtual void VPCALL ConvertJointMatsToJointQuats( idJointQuat *jointQuats, const idJointMat *jointMats, const int numJoints ) = 0;
 	virtual void VPCALL TransformJoints( idJointMat *jointMats, const int *parents, const int firstJoint, const int lastJoint ) = 0;
 	virtual void VPCALL UntransformJoints( idJointMat *jointMats, const int *parents, const int firstJoint, const int lastJoint ) = 0;
+	virtual void VPCALL TransformVertsAndTangents( idDrawVert *targetVerts, const int numVerts, const idDrawVert *baseVerts, const idJointMat *joints ) = 0;
+
+	// rendering
+	virtual void VPCALL DeriveTriangleTangents( idVec3 *normals, idVec3 *tangents, idVec3 *bitangents, const idDrawVert *verts, const triIndex_t *indexes, const int numIndexes ) = 0;
+	virtual void VPCALL DeriveTriangleNormals( idVec3 *normals, const idDrawVert *verts, const triIndex_t *indexes, const int numIndexes ) = 0;
+	virtual void VPCALL NormalizeTangents( idVec3 *normals, idVec3 *tangents, idVec3 *bitangents, const int numVerts ) = 0;
+	virtual void VPCALL DeriveUnsmoothedTangents( idDrawVert *verts, const dominantTri_t *dominantTris, const int numVerts ) = 0;
 };
 
 // pointer to SIMD processor
@@ -209,3 +209,237 @@ void VPCALL idSIMD_Generic::UntransformJoints( idJointMat *jointMats, const int
 		jointMats[i] /= jointMats[parents[i]];
 	}
 }
+
+/*
+============
+idSIMD_Generic::TransformVertsAndTangents
+
+Skins the position, normal and tangent of each vertex with the four joints and weights
+stored in the vertex colors.
+============
+*/
+void VPCALL idSIMD_Generic::TransformVertsAndTangents( idDrawVert *targetVerts, const int numVerts, const idDrawVert *baseVerts, const idJointMat *joints ) {
+	for ( int i = 0; i < numVerts; i++ ) {
+		const idDrawVert & base = baseVerts[i];
+
+		const idJointMat & j0 = joints[base.color[0]];
+		const idJointMat & j1 = joints[base.color[1]];
+		const idJointMat & j2 = joints[base.color[2]];
+		const idJointMat & j3 = joints[base.color[3]];
+
+		const float w0 = base.color2[0] * ( 1.0f / 255.0f );
+		const float w1 = base.color2[1] * ( 1.0f / 255.0f );
+		const float w2 = base.color2[2] * ( 1.0f / 255.0f );
+		const float w3 = base.color2[3] * ( 1.0f / 255.0f );
+
+		idJointMat accum;
+		idJointMat::Mul( accum, j0, w0 );
+		idJointMat::Mad( accum, j1, w1 );
+		idJointMat::Mad( accum, j2, w2 );
+		idJointMat::Mad( accum, j3, w3 );
+
+		targetVerts[i].xyz = accum * idVec4( base.xyz.x, base.xyz.y, base.xyz.z, 1.0f );
+		targetVerts[i].SetNormal( accum * base.GetNormal() );
+		targetVerts[i].SetTangent( accum * base.GetTangent() );
+		targetVerts[i].tangent[3] = base.tangent[3];
+	}
+}
+
+/*
+============
+idSIMD_Generic::DeriveTriangleTangents
+
+Adds the normalized face normal, tangent and bitangent of each triangle to its three vertices.
+============
+*/
+void VPCALL idSIMD_Generic::DeriveTriangleTangents( idVec3 *normals, idVec3 *tangents, idVec3 *bitangents, const idDrawVert *verts, const triIndex_t *indexes, const int numIndexes ) {
+	for ( int i = 0; i < numIndexes; i += 3 ) {
+		const int v0 = indexes[i + 0];
+		const int v1 = indexes[i + 1];
+		const int v2 = indexes[i + 2];
+
+		const idDrawVert * a = verts + v0;
+		const idDrawVert * b = verts + v1;
+		const idDrawVert * c = verts + v2;
+
+		const idVec2 aST = a->GetTexCoord();
+		const idVec2 bST = b->GetTexCoord();
+		const idVec2 cST = c->GetTexCoord();
+
+		float d0[5];
+		d0[0] = b->xyz[0] - a->xyz[0];
+		d0[1] = b->xyz[1] - a->xyz[1];
+		d0[2] = b->xyz[2] - a->xyz[2];
+		d0[3] = bST[0] - aST[0];
+		d0[4] = bST[1] - aST[1];
+
+		float d1[5];
+		d1[0] = c->xyz[0] - a->xyz[0];
+		d1[1] = c->xyz[1] - a->xyz[1];
+		d1[2] = c->xyz[2] - a->xyz[2];
+		d1[3] = cST[0] - aST[0];
+		d1[4] = cST[1] - aST[1];
+
+		idVec3 normal;
+		normal[0] = d1[1] * d0[2] - d1[2] * d0[1];
+		normal[1] = d1[2] * d0[0] - d1[0] * d0[2];
+		normal[2] = d1[0] * d0[1] - d1[1] * d0[0];
+
+		const float f0 = idMath::InvSqrt( normal.x * normal.x + normal.y * normal.y + normal.z * normal.z );
+
+		normal.x *= f0;
+		normal.y *= f0;
+		normal.z *= f0;
+
+		// area sign bit
+		const float area = d0[3] * d1[4] - d0[4] * d1[3];
+		unsigned int signBit = ( *(unsigned int *)&area ) & ( 1 << 31 );
+
+		idVec3 tangent;
+		tangent[0] = d0[0] * d1[4] - d0[4] * d1[0];
+		tangent[1] = d0[1] * d1[4] - d0[4] * d1[1];
+		tangent[2] = d0[2] * d1[4] - d0[4] * d1[2];
+
+		const float f1 = idMath::InvSqrt( tangent.x * tangent.x + tangent.y * tangent.y + tangent.z * tangent.z );
+		*(unsigned int *)&f1 ^= signBit;
+
+		tangent.x *= f1;
+		tangent.y *= f1;
+		tangent.z *= f1;
+
+		idVec3 bitangent;
+		bitangent[0] = d0[3] * d1[0] - d0[0] * d1[3];
+		bitangent[1] = d0[3] * d1[1] - d0[1] * d1[3];
+		bitangent[2] = d0[3] * d1[2] - d0[2] * d1[3];
+
+		const float f2 = idMath::InvSqrt( bitangent.x * bitangent.x + bitangent.y * bitangent.y + bitangent.z * bitangent.z );
+		*(unsigned int *)&f2 ^= signBit;
+
+		bitangent.x *= f2;
+		bitangent.y *= f2;
+		bitangent.z *= f2;
+
+		normals[v0] += normal;
+		tangents[v0] += tangent;
+		bitangents[v0] += bitangent;
+
+		normals[v1] += normal;
+		tangents[v1] += tangent;
+		bitangents[v1] += bitangent;
+
+		normals[v2] += normal;
+		tangents[v2] += tangent;
+		bitangents[v2] += bitangent;
+	}
+}
+
+/*
+============
+idSIMD_Generic::DeriveTriangleNormals
+
+Adds the plane normal of each triangle to its three vertices.
+============
+*/
+void VPCALL idSIMD_Generic::DeriveTriangleNormals( idVec3 *normals, const idDrawVert *verts, const triIndex_t *indexes, const int numIndexes ) {
+	for ( int i = 0; i < numIndexes; i += 3 ) {
+		const int i0 = indexes[i + 0];
+		const int i1 = indexes[i + 1];
+		const int i2 = indexes[i + 2];
+
+		const idPlane plane( verts[i0].xyz, verts[i1].xyz, verts[i2].xyz );
+
+		normals[i0] += plane.Normal();
+		normals[i1] += plane.Normal();
+		normals[i2] += plane.Normal();
+	}
+}
+
+/*
+============
+idSIMD_Generic::NormalizeTangents
+
+Normalizes the summed normals and projects the summed tangent vectors onto the normal plane.
+The tangent vectors will not necessarily be orthogonal to each other.
+============
+*/
+void VPCALL idSIMD_Generic::NormalizeTangents( idVec3 *normals, idVec3 *tangents, idVec3 *bitangents, const int numVerts ) {
+	for ( int i = 0; i < numVerts; i++ ) {
+		const float normalScale = idMath::InvSqrt( normals[i].x * normals[i].x + normals[i].y * normals[i].y + normals[i].z * normals[i].z );
+		normals[i].x *= normalScale;
+		normals[i].y *= normalScale;
+		normals[i].z *= normalScale;
+
+		tangents[i] -= ( tangents[i] * normals[i] ) * normals[i];
+		bitangents[i] -= ( bitangents[i] * normals[i] ) * normals[i];
+
+		const float tangentScale = idMath::InvSqrt( tangents[i].x * tangents[i].x + tangents[i].y * tangents[i].y + tangents[i].z * tangents[i].z );
+		tangents[i].x *= tangentScale;
+		tangents[i].y *= tangentScale;
+		tangents[i].z *= tangentScale;
+
+		const float bitangentScale = idMath::InvSqrt( bitangents[i].x * bitangents[i].x + bitangents[i].y * bitangents[i].y + bitangents[i].z * bitangents[i].z );
+		bitangents[i].x *= bitangentScale;
+		bitangents[i].y *= bitangentScale;
+		bitangents[i].z *= bitangentScale;
+	}
+}
+
+/*
+============
+idSIMD_Generic::DeriveUnsmoothedTangents
+
+Derives the normal and tangent vectors of each vertex from its dominant triangle.
+============
+*/
+void VPCALL idSIMD_Generic::DeriveUnsmoothedTangents( idDrawVert *verts, const dominantTri_t *dominantTris, const int numVerts ) {
+	for ( int i = 0; i < numVerts; i++ ) {
+		float d0, d1, d2, d3, d4;
+		float d5, d6, d7, d8, d9;
+		float s0, s1, s2;
+		float n0, n1, n2;
+		float t0, t1, t2;
+		float t3, t4, t5;
+
+		const dominantTri_t &dt = dominantTris[i];
+
+		idDrawVert *a = verts + i;
+		idDrawVert *b = verts + dt.v2;
+		idDrawVert *c = verts + dt.v3;
+
+		const idVec2 aST = a->GetTexCoord();
+		const idVec2 bST = b->GetTexCoord();
+		const idVec2 cST = c->GetTexCoord();
+
+		d0 = b->xyz[0] - a->xyz[0];
+		d1 = b->xyz[1] - a->xyz[1];
+		d2 = b->xyz[2] - a->xyz[2];
+		d3 = bST[0] - aST[0];
+		d4 = bST[1] - aST[1];
+
+		d5 = c->xyz[0] - a->xyz[0];
+		d6 = c->xyz[1] - a->xyz[1];
+		d7 = c->xyz[2] - a->xyz[2];
+		d8 = cST[0] - aST[0];
+		d9 = cST[1] - aST[1];
+
+		s0 = dt.normalizationScale[0];
+		s1 = dt.normalizationScale[1];
+		s2 = dt.normalizationScale[2];
+
+		n0 = s2 * ( d6 * d2 - d7 * d1 );
+		n1 = s2 * ( d7 * d0 - d5 * d2 );
+		n2 = s2 * ( d5 * d1 - d6 * d0 );
+
+		t0 = s0 * ( d0 * d9 - d4 * d5 );
+		t1 = s0 * ( d1 * d9 - d4 * d6 );
+		t2 = s0 * ( d2 * d9 - d4 * d7 );
+
+		t3 = s1 * ( d3 * d5 - d0 * d8 );
+		t4 = s1 * ( d3 * d6 - d1 * d8 );
+		t5 = s1 * ( d3 * d7 - d2 * d8 );
+
+		a->SetNormal( n0, n1, n2 );
+		a->SetTangent( t0, t1, t2 );
+		a->SetBiTangent( t3, t4, t5 );
+	}
+}
@@ -42,6 +42,43 @@ If you have questions concerning this license or the applicable additional terms
 
 #define M_PI	3.14159265358979323846f
 
+/*
+============
+SSE_InvSqrt
+
+Same result as idMath::InvSqrt in all four lanes, a huge number for tiny inputs.
+============
+*/
+static ID_FORCE_INLINE __m128 SSE_InvSqrt( const __m128 x ) {
+	const __m128 vector_float_one		= { 1.0f, 1.0f, 1.0f, 1.0f };
+	const __m128 vector_float_tiny		= { idMath::FLT_SMALLEST_NON_DENORMAL, idMath::FLT_SMALLEST_NON_DENORMAL, idMath::FLT_SMALLEST_NON_DENORMAL, idMath::FLT_SMALLEST_NON_DENORMAL };
+	const __m128 vector_float_infinity	= { idMath::INFINITY, idMath::INFINITY, idMath::INFINITY, idMath::INFINITY };
+
+	const __m128 r = _mm_sqrt_ps( _mm_div_ps( vector_float_one, x ) );
+	return _mm_sel_ps( vector_float_infinity, r, _mm_cmpgt_ps( x, vector_float_tiny ) );
+}
+
+/*
+============
+SSE_LoadDrawVertPositions
+
+Loads the positions of four draw verts as x, y and z vectors.
+============
+*/
+static ID_FORCE_INLINE void SSE_LoadDrawVertPositions( const idDrawVert *verts, const int *index, __m128 &x, __m128 &y, __m128 &z ) {
+	// each load picks up the first texture coordinate pair as the fourth component
+	__m128 v0 = _mm_loadu_ps( verts[index[0]].xyz.ToFloatPtr() );
+	__m128 v1 = _mm_loadu_ps( verts[index[1]].xyz.ToFloatPtr() );
+	__m128 v2 = _mm_loadu_ps( verts[index[2]].xyz.ToFloatPtr() );
+	__m128 v3 = _mm_loadu_ps( verts[index[3]].xyz.ToFloatPtr() );
+
+	_MM_TRANSPOSE4_PS( v0, v1, v2, v3 );
+
+	x = v0;
+	y = v1;
+	z = v2;
+}
+
 /*
 ============
 idSIMD_SSE::GetName
@@ -932,3 +969,459 @@ void VPCALL idSIMD_SSE::UntransformJoints( idJointMat *jointMats, const int *par
 	}
 }
 
+
+/*
+============
+idSIMD_SSE::TransformVertsAndTangents
+
+The blended joint is kept in registers as four columns. Consecutive vertices
+in a mesh usually share joints and weights, in which case the blend is reused.
+The columns are applied in the same order as idJointMat::operator*, so the
+result is identical to the generic code.
+============
+*/
+void VPCALL idSIMD_SSE::TransformVertsAndTangents( idDrawVert *targetVerts, const int numVerts, const idDrawVert *baseVerts, const idJointMat *joints ) {
+
+	assert_16_byte_aligned( joints );
+
+	const __m128 vector_float_zero = _mm_setzero_ps();
+
+	ALIGN16( float out[4] );
+
+	__m128 c0 = vector_float_zero;
+	__m128 c1 = vector_float_zero;
+	__m128 c2 = vector_float_zero;
+	__m128 c3 = vector_float_zero;
+
+	unsigned int lastJoints = 0;
+	unsigned int lastWeights = 0;
+
+	for ( int i = 0; i < numVerts; i++ ) {
+		const idDrawVert & base = baseVerts[i];
+
+		const unsigned int vertJoints = *(const unsigned int *)base.color;
+		const unsigned int vertWeights = *(const unsigned int *)base.color2;
+
+		if ( i == 0 || vertJoints != lastJoints || vertWeights != lastWeights ) {
+			lastJoints = vertJoints;
+			lastWeights = vertWeights;
+
+			const float * j0 = joints[base.color[0]].ToFloatPtr();
+			const float * j1 = joints[base.color[1]].ToFloatPtr();
+			const float * j2 = joints[base.color[2]].ToFloatPtr();
+			const float * j3 = joints[base.color[3]].ToFloatPtr();
+
+			const __m128 w0 = _mm_set1_ps( base.color2[0] * ( 1.0f / 255.0f ) );
+			const __m128 w1 = _mm_set1_ps( base.color2[1] * ( 1.0f / 255.0f ) );
+			const __m128 w2 = _mm_set1_ps( base.color2[2] * ( 1.0f / 255.0f ) );
+			const __m128 w3 = _mm_set1_ps( base.color2[3] * ( 1.0f / 255.0f ) );
+
+			__m128 r0 = _mm_mul_ps( w0, _mm_load_ps( j0 + 0 ) );
+			__m128 r1 = _mm_mul_ps( w0, _mm_load_ps( j0 + 4 ) );
+			__m128 r2 = _mm_mul_ps( w0, _mm_load_ps( j0 + 8 ) );
+
+			r0 = _mm_add_ps( r0, _mm_mul_ps( w1, _mm_load_ps( j1 + 0 ) ) );
+			r1 = _mm_add_ps( r1, _mm_mul_ps( w1, _mm_load_ps( j1 + 4 ) ) );
+			r2 = _mm_add_ps( r2, _mm_mul_ps( w1, _mm_load_ps( j1 + 8 ) ) );
+
+			r0 = _mm_add_ps( r0, _mm_mul_ps( w2, _mm_load_ps( j2 + 0 ) ) );
+			r1 = _mm_add_ps( r1, _mm_mul_ps( w2, _mm_load_ps( j2 + 4 ) ) );
+			r2 = _mm_add_ps( r2, _mm_mul_ps( w2, _mm_load_ps( j2 + 8 ) ) );
+
+			r0 = _mm_add_ps( r0, _mm_mul_ps( w3, _mm_load_ps( j3 + 0 ) ) );
+			r1 = _mm_add_ps( r1, _mm_mul_ps( w3, _mm_load_ps( j3 + 4 ) ) );
+			r2 = _mm_add_ps( r2, _mm_mul_ps( w3, _mm_load_ps( j3 + 8 ) ) );
+
+			__m128 r3 = vector_float_zero;
+			_MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+
+			c0 = r0;
+			c1 = r1;
+			c2 = r2;
+			c3 = r3;
+		}
+
+		const idVec3 normal = base.GetNormal();
+		const idVec3 tangent = base.GetTangent();
+
+		__m128 p = _mm_mul_ps( c0, _mm_load1_ps( &base.xyz.x ) );
+		p = _mm_add_ps( p, _mm_mul_ps( c1, _mm_load1_ps( &base.xyz.y ) ) );
+		p = _mm_add_ps( p, _mm_mul_ps( c2, _mm_load1_ps( &base.xyz.z ) ) );
+		p = _mm_add_ps( p, c3 );
+
+		_mm_store_ps( out, p );
+		targetVerts[i].xyz.x = out[0];
+		targetVerts[i].xyz.y = out[1];
+		targetVerts[i].xyz.z = out[2];
+
+		__m128 n = _mm_mul_ps( c0, _mm_load1_ps( &normal.x ) );
+		n = _mm_add_ps( n, _mm_mul_ps( c1, _mm_load1_ps( &normal.y ) ) );
+		n = _mm_add_ps( n, _mm_mul_ps( c2, _mm_load1_ps( &normal.z ) ) );
+
+		_mm_store_ps( out, n );
+		targetVerts[i].SetNormal( out[0], out[1], out[2] );
+
+		__m128 t = _mm_mul_ps( c0, _mm_load1_ps( &tangent.x ) );
+		t = _mm_add_ps( t, _mm_mul_ps( c1, _mm_load1_ps( &tangent.y ) ) );
+		t = _mm_add_ps( t, _mm_mul_ps( c2, _mm_load1_ps( &tangent.z ) ) );
+
+		_mm_store_ps( out, t );
+		targetVerts[i].SetTangent( out[0], out[1], out[2] );
+		targetVerts[i].tangent[3] = base.tangent[3];
+	}
+}
+
+/*
+============
+idSIMD_SSE::DeriveTriangleTangents
+
+Derives the face vectors of four triangles at a time. The sums are added
+to the vertices in triangle order, so the result is identical to the
+generic code.
+============
+*/
+void VPCALL idSIMD_SSE::DeriveTriangleTangents( idVec3 *normals, idVec3 *tangents, idVec3 *bitangents, const idDrawVert *verts, const triIndex_t *indexes, const int numIndexes ) {
+
+	const __m128 vector_float_sign_bit	= __m128c( _mm_set_epi32( 0x80000000, 0x80000000, 0x80000000, 0x80000000 ) );
+
+	ALIGN16( float st[6][4] );
+	ALIGN16( float n[3][4] );
+	ALIGN16( float t[3][4] );
+	ALIGN16( float b[3][4] );
+	int v[3][4];
+
+	const int numTris = numIndexes / 3;
+
+	for ( int i = 0; i < numTris; i += 4 ) {
+		const int count = Min( numTris - i, 4 );
+
+		// pad a partial batch by repeating the last triangle
+		for ( int j = 0; j < 4; j++ ) {
+			const triIndex_t * tri = indexes + ( i + Min( j, count - 1 ) ) * 3;
+			v[0][j] = tri[0];
+			v[1][j] = tri[1];
+			v[2][j] = tri[2];
+
+			const idVec2 aST = verts[v[0][j]].GetTexCoord();
+			const idVec2 bST = verts[v[1][j]].GetTexCoord();
+			const idVec2 cST = verts[v[2][j]].GetTexCoord();
+			st[0][j] = aST[0];
+			st[1][j] = aST[1];
+			st[2][j] = bST[0];
+			st[3][j] = bST[1];
+			st[4][j] = cST[0];
+			st[5][j] = cST[1];
+		}
+
+		__m128 aX, aY, aZ;
+		__m128 bX, bY, bZ;
+		__m128 cX, cY, cZ;
+		SSE_LoadDrawVertPositions( verts, v[0], aX, aY, aZ );
+		SSE_LoadDrawVertPositions( verts, v[1], bX, bY, bZ );
+		SSE_LoadDrawVertPositions( verts, v[2], cX, cY, cZ );
+
+		const __m128 aS = _mm_load_ps( st[0] );
+		const __m128 aT = _mm_load_ps( st[1] );
+
+		const __m128 d00 = _mm_sub_ps( bX, aX );
+		const __m128 d01 = _mm_sub_ps( bY, aY );
+		const __m128 d02 = _mm_sub_ps( bZ, aZ );
+		const __m128 d03 = _mm_sub_ps( _mm_load_ps( st[2] ), aS );
+		const __m128 d04 = _mm_sub_ps( _mm_load_ps( st[3] ), aT );
+
+		const __m128 d10 = _mm_sub_ps( cX, aX );
+		const __m128 d11 = _mm_sub_ps( cY, aY );
+		const __m128 d12 = _mm_sub_ps( cZ, aZ );
+		const __m128 d13 = _mm_sub_ps( _mm_load_ps( st[4] ), aS );
+		const __m128 d14 = _mm_sub_ps( _mm_load_ps( st[5] ), aT );
+
+		__m128 nX = _mm_sub_ps( _mm_mul_ps( d11, d02 ), _mm_mul_ps( d12, d01 ) );
+		__m128 nY = _mm_sub_ps( _mm_mul_ps( d12, d00 ), _mm_mul_ps( d10, d02 ) );
+		__m128 nZ = _mm_sub_ps( _mm_mul_ps( d10, d01 ), _mm_mul_ps( d11, d00 ) );
+
+		const __m128 f0 = SSE_InvSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( nX, nX ), _mm_mul_ps( nY, nY ) ), _mm_mul_ps( nZ, nZ ) ) );
+
+		nX = _mm_mul_ps( nX, f0 );
+		nY = _mm_mul_ps( nY, f0 );
+		nZ = _mm_mul_ps( nZ, f0 );
+
+		// area sign bit
+		const __m128 area = _mm_sub_ps( _mm_mul_ps( d03, d14 ), _mm_mul_ps( d04, d13 ) );
+		const __m128 signBit = _mm_and_ps( area, vector_float_sign_bit );
+
+		__m128 tX = _mm_sub_ps( _mm_mul_ps( d00, d14 ), _mm_mul_ps( d04, d10 ) );
+		__m128 tY = _mm_sub_ps( _mm_mul_ps( d01, d14 ), _mm_mul_ps( d04, d11 ) );
+		__m128 tZ = _mm_sub_ps( _mm_mul_ps( d02, d14 ), _mm_mul_ps( d04, d12 ) );
+
+		__m128 f1 = SSE_InvSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( tX, tX ), _mm_mul_ps( tY, tY ) ), _mm_mul_ps( tZ, tZ ) ) );
+		f1 = _mm_xor_ps( f1, signBit );
+
+		tX = _mm_mul_ps( tX, f1 );
+		tY = _mm_mul_ps( tY, f1 );
+		tZ = _mm_mul_ps( tZ, f1 );
+
+		__m128 bX = _mm_sub_ps( _mm_mul_ps( d03, d10 ), _mm_mul_ps( d00, d13 ) );
+		__m128 bY = _mm_sub_ps( _mm_mul_ps( d03, d11 ), _mm_mul_ps( d01, d13 ) );
+		__m128 bZ = _mm_sub_ps( _mm_mul_ps( d03, d12 ), _mm_mul_ps( d02, d13 ) );
+
+		__m128 f2 = SSE_InvSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( bX, bX ), _mm_mul_ps( bY, bY ) ), _mm_mul_ps( bZ, bZ ) ) );
+		f2 = _mm_xor_ps( f2, signBit );
+
+		_mm_store_ps( n[0], nX );
+		_mm_store_ps( n[1], nY );
+		_mm_store_ps( n[2], nZ );
+		_mm_store_ps( t[0], tX );
+		_mm_store_ps( t[1], tY );
+		_mm_store_ps( t[2], tZ );
+		_mm_store_ps( b[0], _mm_mul_ps( bX, f2 ) );
+		_mm_store_ps( b[1], _mm_mul_ps( bY, f2 ) );
+		_mm_store_ps( b[2], _mm_mul_ps( bZ, f2 ) );
+
+		// the scatter stays scalar, vertices are shared between the triangles in a batch
+		for ( int j = 0; j < count; j++ ) {
+			for ( int k = 0; k < 3; k++ ) {
+				const int vertNum = v[k][j];
+				normals[vertNum].x += n[0][j];
+				normals[vertNum].y += n[1][j];
+				normals[vertNum].z += n[2][j];
+				tangents[vertNum].x += t[0][j];
+				tangents[vertNum].y += t[1][j];
+				tangents[vertNum].z += t[2][j];
+				bitangents[vertNum].x += b[0][j];
+				bitangents[vertNum].y += b[1][j];
+				bitangents[vertNum].z += b[2][j];
+			}
+		}
+	}
+}
+
+/*
+============
+idSIMD_SSE::DeriveTriangleNormals
+============
+*/
+void VPCALL idSIMD_SSE::DeriveTriangleNormals( idVec3 *normals, const idDrawVert *verts, const triIndex_t *indexes, const int numIndexes ) {
+
+	ALIGN16( float n[3][4] );
+	int v[3][4];
+
+	const int numTris = numIndexes / 3;
+
+	for ( int i = 0; i < numTris; i += 4 ) {
+		const int count = Min( numTris - i, 4 );
+
+		for ( int j = 0; j < 4; j++ ) {
+			const triIndex_t * tri = indexes + ( i + Min( j, count - 1 ) ) * 3;
+			v[0][j] = tri[0];
+			v[1][j] = tri[1];
+			v[2][j] = tri[2];
+		}
+
+		__m128 aX, aY, aZ;
+		__m128 bX, bY, bZ;
+		__m128 cX, cY, cZ;
+		SSE_LoadDrawVertPositions( verts, v[0], aX, aY, aZ );
+		SSE_LoadDrawVertPositions( verts, v[1], bX, bY, bZ );
+		SSE_LoadDrawVertPositions( verts, v[2], cX, cY, cZ );
+
+		// same as idPlane::FromPoints
+		const __m128 d0X = _mm_sub_ps( aX, bX );
+		const __m128 d0Y = _mm_sub_ps( aY, bY );
+		const __m128 d0Z = _mm_sub_ps( aZ, bZ );
+		const __m128 d1X = _mm_sub_ps( cX, bX );
+		const __m128 d1Y = _mm_sub_ps( cY, bY );
+		const __m128 d1Z = _mm_sub_ps( cZ, bZ );
+
+		const __m128 nX = _mm_sub_ps( _mm_mul_ps( d0Y, d1Z ), _mm_mul_ps( d0Z, d1Y ) );
+		const __m128 nY = _mm_sub_ps( _mm_mul_ps( d0Z, d1X ), _mm_mul_ps( d0X, d1Z ) );
+		const __m128 nZ = _mm_sub_ps( _mm_mul_ps( d0X, d1Y ), _mm_mul_ps( d0Y, d1X ) );
+
+		const __m128 s = SSE_InvSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( nX, nX ), _mm_mul_ps( nY, nY ) ), _mm_mul_ps( nZ, nZ ) ) );
+
+		_mm_store_ps( n[0], _mm_mul_ps( nX, s ) );
+		_mm_store_ps( n[1], _mm_mul_ps( nY, s ) );
+		_mm_store_ps( n[2], _mm_mul_ps( nZ, s ) );
+
+		for ( int j = 0; j < count; j++ ) {
+			for ( int k = 0; k < 3; k++ ) {
+				const int vertNum = v[k][j];
+				normals[vertNum].x += n[0][j];
+				normals[vertNum].y += n[1][j];
+				normals[vertNum].z += n[2][j];
+			}
+		}
+	}
+}
+
+// x0 y0 z0 x1, y1 z1 x2 y2, z2 x3 y3 z3 -> x0 x1 x2 x3, y0 y1 y2 y3, z0 z1 z2 z3
+#define LOAD_VEC3_X4( p, x, y, z ) {																\
+	const __m128 r0 = _mm_loadu_ps( (p) + 0 );												\
+	const __m128 r1 = _mm_loadu_ps( (p) + 4 );												\
+	const __m128 r2 = _mm_loadu_ps( (p) + 8 );												\
+	const __m128 rx = _mm_shuffle_ps( r1, r2, _MM_SHUFFLE( 0, 1, 0, 2 ) );					\
+	const __m128 ry0 = _mm_shuffle_ps( r0, r1, _MM_SHUFFLE( 0, 0, 1, 1 ) );				\
+	const __m128 ry1 = _mm_shuffle_ps( r1, r2, _MM_SHUFFLE( 2, 2, 3, 3 ) );				\
+	const __m128 rz = _mm_shuffle_ps( r0, r1, _MM_SHUFFLE( 1, 1, 2, 2 ) );					\
+	x = _mm_shuffle_ps( r0, rx, _MM_SHUFFLE( 2, 0, 3, 0 ) );								\
+	y = _mm_shuffle_ps( ry0, ry1, _MM_SHUFFLE( 2, 0, 2, 0 ) );								\
+	z = _mm_shuffle_ps( rz, r2, _MM_SHUFFLE( 3, 0, 2, 0 ) );								\
+}
+
+// x0 x1 x2 x3, y0 y1 y2 y3, z0 z1 z2 z3 -> x0 y0 z0 x1, y1 z1 x2 y2, z2 x3 y3 z3
+#define STORE_VEC3_X4( p, x, y, z ) {																\
+	const __m128 xy01 = _mm_unpacklo_ps( x, y );											\
+	const __m128 xy23 = _mm_unpackhi_ps( x, y );											\
+	const __m128 zx01 = _mm_shuffle_ps( z, x, _MM_SHUFFLE( 1, 1, 0, 0 ) );					\
+	const __m128 yz11 = _mm_shuffle_ps( y, z, _MM_SHUFFLE( 1, 1, 1, 1 ) );					\
+	const __m128 zx23 = _mm_shuffle_ps( z, x, _MM_SHUFFLE( 3, 3, 2, 2 ) );					\
+	const __m128 yz33 = _mm_shuffle_ps( y, z, _MM_SHUFFLE( 3, 3, 3, 3 ) );					\
+	_mm_storeu_ps( (p) + 0, _mm_shuffle_ps( xy01, zx01, _MM_SHUFFLE( 2, 0, 1, 0 ) ) );		\
+	_mm_storeu_ps( (p) + 4, _mm_shuffle_ps( yz11, xy23, _MM_SHUFFLE( 1, 0, 2, 0 ) ) );		\
+	_mm_storeu_ps( (p) + 8, _mm_shuffle_ps( zx23, yz33, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );		\
+}
+
+/*
+============
+idSIMD_SSE::NormalizeTangents
+============
+*/
+void VPCALL idSIMD_SSE::NormalizeTangents( idVec3 *normals, idVec3 *tangents, idVec3 *bitangents, const int numVerts ) {
+
+	int i = 0;
+	for ( ; i + 3 < numVerts; i += 4 ) {
+		float * np = normals[i].ToFloatPtr();
+		float * tp = tangents[i].ToFloatPtr();
+		float * bp = bitangents[i].ToFloatPtr();
+
+		__m128 nX, nY, nZ;
+		__m128 tX, tY, tZ;
+		__m128 bX, bY, bZ;
+
+		LOAD_VEC3_X4( np, nX, nY, nZ );
+		LOAD_VEC3_X4( tp, tX, tY, tZ );
+		LOAD_VEC3_X4( bp, bX, bY, bZ );
+
+		const __m128 normalScale = SSE_InvSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( nX, nX ), _mm_mul_ps( nY, nY ) ), _mm_mul_ps( nZ, nZ ) ) );
+		nX = _mm_mul_ps( nX, normalScale );
+		nY = _mm_mul_ps( nY, normalScale );
+		nZ = _mm_mul_ps( nZ, normalScale );
+
+		const __m128 tDotN = _mm_add_ps( _mm_add_ps( _mm_mul_ps( tX, nX ), _mm_mul_ps( tY, nY ) ), _mm_mul_ps( tZ, nZ ) );
+		tX = _mm_sub_ps( tX, _mm_mul_ps( nX, tDotN ) );
+		tY = _mm_sub_ps( tY, _mm_mul_ps( nY, tDotN ) );
+		tZ = _mm_sub_ps( tZ, _mm_mul_ps( nZ, tDotN ) );
+
+		const __m128 bDotN = _mm_add_ps( _mm_add_ps( _mm_mul_ps( bX, nX ), _mm_mul_ps( bY, nY ) ), _mm_mul_ps( bZ, nZ ) );
+		bX = _mm_sub_ps( bX, _mm_mul_ps( nX, bDotN ) );
+		bY = _mm_sub_ps( bY, _mm_mul_ps( nY, bDotN ) );
+		bZ = _mm_sub_ps( bZ, _mm_mul_ps( nZ, bDotN ) );
+
+		const __m128 tangentScale = SSE_InvSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( tX, tX ), _mm_mul_ps( tY, tY ) ), _mm_mul_ps( tZ, tZ ) ) );
+		tX = _mm_mul_ps( tX, tangentScale );
+		tY = _mm_mul_ps( tY, tangentScale );
+		tZ = _mm_mul_ps( tZ, tangentScale );
+
+		const __m128 bitangentScale = SSE_InvSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( bX, bX ), _mm_mul_ps( bY, bY ) ), _mm_mul_ps( bZ, bZ ) ) );
+		bX = _mm_mul_ps( bX, bitangentScale );
+		bY = _mm_mul_ps( bY, bitangentScale );
+		bZ = _mm_mul_ps( bZ, bitangentScale );
+
+		STORE_VEC3_X4( np, nX, nY, nZ );
+		STORE_VEC3_X4( tp, tX, tY, tZ );
+		STORE_VEC3_X4( bp, bX, bY, bZ );
+	}
+
+	// the last few vertices
+	idSIMD_Generic::NormalizeTangents( normals + i, tangents + i, bitangents + i, numVerts - i );
+}
+
+#undef LOAD_VEC3_X4
+#undef STORE_VEC3_X4
+
+/*
+============
+idSIMD_SSE::DeriveUnsmoothedTangents
+============
+*/
+void VPCALL idSIMD_SSE::DeriveUnsmoothedTangents( idDrawVert *verts, const dominantTri_t *dominantTris, const int numVerts ) {
+
+	ALIGN16( float st[6][4] );
+	ALIGN16( float scale[3][4] );
+	ALIGN16( float n[3][4] );
+	ALIGN16( float t[6][4] );
+	int v[3][4];
+
+	for ( int i = 0; i < numVerts; i += 4 ) {
+		const int count = Min( numVerts - i, 4 );
+
+		// pad a partial batch by repeating the last vertex
+		for ( int j = 0; j < 4; j++ ) {
+			const int vertNum = i + Min( j, count - 1 );
+			const dominantTri_t &dt = dominantTris[vertNum];
+
+			v[0][j] = vertNum;
+			v[1][j] = dt.v2;
+			v[2][j] = dt.v3;
+
+			scale[0][j] = dt.normalizationScale[0];
+			scale[1][j] = dt.normalizationScale[1];
+			scale[2][j] = dt.normalizationScale[2];
+
+			const idVec2 aST = verts[v[0][j]].GetTexCoord();
+			const idVec2 bST = verts[v[1][j]].GetTexCoord();
+			const idVec2 cST = verts[v[2][j]].GetTexCoord();
+			st[0][j] = aST[0];
+			st[1][j] = aST[1];
+			st[2][j] = bST[0];
+			st[3][j] = bST[1];
+			st[4][j] = cST[0];
+			st[5][j] = cST[1];
+		}
+
+		__m128 aX, aY, aZ;
+		__m128 bX, bY, bZ;
+		__m128 cX, cY, cZ;
+		SSE_LoadDrawVertPositions( verts, v[0], aX, aY, aZ );
+		SSE_LoadDrawVertPositions( verts, v[1], bX, bY, bZ );
+		SSE_LoadDrawVertPositions( verts, v[2], cX, cY, cZ );
+
+		const __m128 aS = _mm_load_ps( st[0] );
+		const __m128 aT = _mm_load_ps( st[1] );
+
+		const __m128 d0 = _mm_sub_ps( bX, aX );
+		const __m128 d1 = _mm_sub_ps( bY, aY );
+		const __m128 d2 = _mm_sub_ps( bZ, aZ );
+		const __m128 d3 = _mm_sub_ps( _mm_load_ps( st[2] ), aS );
+		const __m128 d4 = _mm_sub_ps( _mm_load_ps( st[3] ), aT );
+
+		const __m128 d5 = _mm_sub_ps( cX, aX );
+		const __m128 d6 = _mm_sub_ps( cY, aY );
+		const __m128 d7 = _mm_sub_ps( cZ, aZ );
+		const __m128 d8 = _mm_sub_ps( _mm_load_ps( st[4] ), aS );
+		const __m128 d9 = _mm_sub_ps( _mm_load_ps( st[5] ), aT );
+
+		const __m128 s0 = _mm_load_ps( scale[0] );
+		const __m128 s1 = _mm_load_ps( scale[1] );
+		const __m128 s2 = _mm_load_ps( scale[2] );
+
+		_mm_store_ps( n[0], _mm_mul_ps( s2, _mm_sub_ps( _mm_mul_ps( d6, d2 ), _mm_mul_ps( d7, d1 ) ) ) );
+		_mm_store_ps( n[1], _mm_mul_ps( s2, _mm_sub_ps( _mm_mul_ps( d7, d0 ), _mm_mul_ps( d5, d2 ) ) ) );
+		_mm_store_ps( n[2], _mm_mul_ps( s2, _mm_sub_ps( _mm_mul_ps( d5, d1 ), _mm_mul_ps( d6, d0 ) ) ) );
+
+		_mm_store_ps( t[0], _mm_mul_ps( s0, _mm_sub_ps( _mm_mul_ps( d0, d9 ), _mm_mul_ps( d4, d5 ) ) ) );
+		_mm_store_ps( t[1], _mm_mul_ps( s0, _mm_sub_ps( _mm_mul_ps( d1, d9 ), _mm_mul_ps( d4, d6 ) ) ) );
+		_mm_store_ps( t[2], _mm_mul_ps( s0, _mm_sub_ps( _mm_mul_ps( d2, d9 ), _mm_mul_ps( d4, d7 ) ) ) );
+
+		_mm_store_ps( t[3], _mm_mul_ps( s1, _mm_sub_ps( _mm_mul_ps( d3, d5 ), _mm_mul_ps( d0, d8 ) ) ) );
+		_mm_store_ps( t[4], _mm_mul_ps( s1, _mm_sub_ps( _mm_mul_ps( d3, d6 ), _mm_mul_ps( d1, d8 ) ) ) );
+		_mm_store_ps( t[5], _mm_mul_ps( s1, _mm_sub_ps( _mm_mul_ps( d3, d7 ), _mm_mul_ps( d2, d8 ) ) ) );
+
+		// the vertices are only written after all four have been read
+		for ( int j = 0; j < count; j++ ) {
+			idDrawVert *a = verts + i + j;
+			a->SetNormal( n[0][j], n[1][j], n[2][j] );
+			a->SetTangent( t[0][j], t[1][j], t[2][j] );
+			a->SetBiTangent( t[3][j], t[4][j], t[5][j] );
+		}
+	}
+}
@@ -47,6 +47,12 @@ public:
 	virtual void VPCALL ConvertJointMatsToJointQuats( idJointQuat *jointQuats, const idJointMat *jointMats, const int numJoints );
 	virtual void VPCALL TransformJoints( idJointMat *jointMats, const int *parents, const int firstJoint, const int lastJoint );
 	virtual void VPCALL UntransformJoints( idJointMat *jointMats, const int *parents, const int firstJoint, const int lastJoint );
+	virtual void VPCALL TransformVertsAndTangents( idDrawVert *targetVerts, const int numVerts, const idDrawVert *baseVerts, const idJointMat *joints );
+
+	virtual void VPCALL DeriveTriangleTangents( idVec3 *normals, idVec3 *tangents, idVec3 *bitangents, const idDrawVert *verts, const triIndex_t *indexes, const int numIndexes );
+	virtual void VPCALL DeriveTriangleNormals( idVec3 *normals, const idDrawVert *verts, const triIndex_t *indexes, const int numIndexes );
+	virtual void VPCALL NormalizeTangents( idVec3 *normals, idVec3 *tangents, idVec3 *bitangents, const int numVerts );
+	virtual void VPCALL DeriveUnsmoothedTangents( idDrawVert *verts, const dominantTri_t *dominantTris, const int numVerts );
 };
 
 #endif /* !__MATH_SIMD_SSE_H__ */
@@ -35,9 +35,31 @@ If you have questions concerning this license or the applicable additional terms
 //
 //===============================================================
 
-float	idVecX::temp[VECX_MAX_TEMP+4];
+float	idVecX::temp[VECX_MAX_TEMP*VECX_MAX_TEMP_POOLS+4];
 float *	idVecX::tempPtr = (float *) ( ( (int) idVecX::temp + 15 ) & ~15 );
-int		idVecX::tempIndex = 0;
+int		idVecX::tempIndex[VECX_MAX_TEMP_POOLS];
+ID_TLS	idVecX::tempPool;
+interlockedInt_t	idVecX::numTempPools = 0;
+
+/*
+========================
+idVecX::GetTempPool
+
+A thread claims a temporary memory pool the first time it needs one and keeps it
+for the rest of the process, the pool is not recycled when the thread exits.
+========================
+*/
+int idVecX::GetTempPool() {
+	ptrdiff_t pool = tempPool;
+	if ( pool == 0 ) {
+		pool = Sys_InterlockedIncrement( numTempPools );
+		if ( pool > VECX_MAX_TEMP_POOLS ) {
+			idLib::FatalError( "idVecX: more than %d threads use temporary memory", VECX_MAX_TEMP_POOLS );
+		}
+		tempPool = pool;
+	}
+	return (int)pool - 1;
+}
 
 /*
 =============
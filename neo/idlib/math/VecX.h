@@ -36,12 +36,16 @@ idVecX - arbitrary sized vector
 
 The vector lives on 16 byte aligned and 16 byte padded memory.
 
-NOTE: due to the temporary memory pool idVecX cannot be used by multiple threads
+Intermediate results are stored in a temporary memory pool. Every thread that uses
+idVecX gets its own pool, so at most VECX_MAX_TEMP_POOLS threads can use it. Pools
+are never given back, a thread that exits keeps its pool, so only long lived threads
+like the main and job threads should use idVecX.
 
 ===============================================================================
 */
 
 #define VECX_MAX_TEMP		1024
+#define VECX_MAX_TEMP_POOLS	40			// threads that can use temporary memory at the same time
 #define VECX_QUAD( x )		( ( ( ( x ) + 3 ) & ~3 ) * sizeof( float ) )
 #define VECX_CLEAREND()		int s = size; while( s < ( ( s + 3) & ~3 ) ) { p[s++] = 0.0f; }
 #define VECX_ALLOCA( n )	( (float *) _alloca16( VECX_QUAD( n ) ) )
@@ -114,9 +118,13 @@ private:
 	int				alloced;				// if -1 p points to data set with SetData
 	float *			p;						// memory the vector is stored
 
-	static float	temp[VECX_MAX_TEMP+4];	// used to store intermediate results
+	static float	temp[VECX_MAX_TEMP*VECX_MAX_TEMP_POOLS+4];	// used to store intermediate results
 	static float *	tempPtr;				// pointer to 16 byte aligned temporary memory
-	static int		tempIndex;				// index into memory pool, wraps around
+	static int		tempIndex[VECX_MAX_TEMP_POOLS];	// index into the memory pool of each thread, wraps around
+	static ID_TLS	tempPool;				// memory pool of the calling thread plus one, zero until first used
+	static interlockedInt_t	numTempPools;	// number of memory pools handed out
+
+	static int		GetTempPool();
 
 	ID_INLINE void	SetTempSize( int size );
 };
@@ -161,7 +169,7 @@ idVecX::~idVecX
 */
 ID_INLINE idVecX::~idVecX() {
 	// if not temp memory
-	if ( p && ( p < idVecX::tempPtr || p >= idVecX::tempPtr + VECX_MAX_TEMP ) && alloced != -1 ) {
+	if ( p && ( p < idVecX::tempPtr || p >= idVecX::tempPtr + VECX_MAX_TEMP * VECX_MAX_TEMP_POOLS ) && alloced != -1 ) {
 		Mem_Free16( p );
 	}
 }
@@ -240,7 +248,7 @@ ID_INLINE idVecX &idVecX::operator=( const idVecX &a ) {
 #else
 	memcpy( p, a.p, a.size * sizeof( float ) );
 #endif
-	idVecX::tempIndex = 0;
+	idVecX::tempIndex[ GetTempPool() ] = 0;
 	return *this;
 }
 
@@ -304,7 +312,7 @@ ID_INLINE idVecX &idVecX::operator+=( const idVecX &a ) {
 		p[i] += a.p[i];
 	}
 #endif
-	idVecX::tempIndex = 0;
+	idVecX::tempIndex[ GetTempPool() ] = 0;
 	return *this;
 }
 
@@ -324,7 +332,7 @@ ID_INLINE idVecX &idVecX::operator-=( const idVecX &a ) {
 		p[i] -= a.p[i];
 	}
 #endif
-	idVecX::tempIndex = 0;
+	idVecX::tempIndex[ GetTempPool() ] = 0;
 	return *this;
 }
 
@@ -467,7 +475,7 @@ idVecX::SetSize
 ========================
 */
 ID_INLINE void idVecX::SetSize( int newSize ) {
-	//assert( p < idVecX::tempPtr || p > idVecX::tempPtr + VECX_MAX_TEMP );
+	//assert( p < idVecX::tempPtr || p > idVecX::tempPtr + VECX_MAX_TEMP * VECX_MAX_TEMP_POOLS );
 	if ( newSize != size || p == NULL ) {
 		int alloc = ( newSize + 3 ) & ~3;
 		if ( alloc > alloced && alloced != -1 ) {
@@ -521,11 +529,12 @@ ID_INLINE void idVecX::SetTempSize( int newSize ) {
 	size = newSize;
 	alloced = ( newSize + 3 ) & ~3;
 	assert( alloced < VECX_MAX_TEMP );
-	if ( idVecX::tempIndex + alloced > VECX_MAX_TEMP ) {
-		idVecX::tempIndex = 0;
+	const int pool = GetTempPool();
+	if ( idVecX::tempIndex[pool] + alloced > VECX_MAX_TEMP ) {
+		idVecX::tempIndex[pool] = 0;
 	}
-	p = idVecX::tempPtr + idVecX::tempIndex;
-	idVecX::tempIndex += alloced;
+	p = idVecX::tempPtr + pool * VECX_MAX_TEMP + idVecX::tempIndex[pool];
+	idVecX::tempIndex[pool] += alloced;
 	VECX_CLEAREND();
 }
 
@@ -535,7 +544,7 @@ idVecX::SetData
 ========================
 */
 ID_INLINE void idVecX::SetData( int length, float *data ) {
-	if ( p != NULL && ( p < idVecX::tempPtr || p >= idVecX::tempPtr + VECX_MAX_TEMP ) && alloced != -1 ) {
+	if ( p != NULL && ( p < idVecX::tempPtr || p >= idVecX::tempPtr + VECX_MAX_TEMP * VECX_MAX_TEMP_POOLS ) && alloced != -1 ) {
 		Mem_Free16( p );
 	}
 	assert_16_byte_aligned( data ); // data must be 16 byte aligned
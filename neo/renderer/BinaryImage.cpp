@@ -42,12 +42,106 @@ If you have questions concerning this license or the applicable additional terms
 
 idCVar image_highQualityCompression( "image_highQualityCompression", "0", CVAR_BOOL, "Use high quality (slow) compression" );
 
+/*
+========================
+DXT compression work
+
+The DXT encoders compress each 4x4 block independently, so an image can be split into
+bands of block rows that are compressed on different threads and still produce exactly
+the same output.
+========================
+*/
+enum dxtCompressMode_t {
+	DXT_COMPRESS_DXT1_HQ,
+	DXT_COMPRESS_DXT1_FAST,
+	DXT_COMPRESS_DXT5_HQ,
+	DXT_COMPRESS_DXT5_FAST,
+	DXT_COMPRESS_NORMAL_DXT5_HQ,
+	DXT_COMPRESS_NORMAL_DXT5_FAST,
+	DXT_COMPRESS_YCOCG_DXT5_HQ,
+	DXT_COMPRESS_YCOCG_DXT5_FAST
+};
+
+struct dxtCompressParms_t {
+	const byte *	src;
+	byte *			dest;
+	int				width;
+	int				height;
+	int				mode;		// dxtCompressMode_t
+};
+
+static const int DXT_BAND_ROWS = 64;			// rows of pixels compressed by a single job
+
+idCVar image_parallelCompression( "image_parallelCompression", "1", CVAR_BOOL, "compress the mip levels of an image in bands over the job threads" );
+
+/*
+========================
+DXT_CompressJob
+========================
+*/
+void DXT_CompressJob( dxtCompressParms_t * parms ) {
+	idDxtEncoder dxt;
+	switch ( parms->mode ) {
+		case DXT_COMPRESS_DXT1_HQ:				dxt.CompressImageDXT1HQ( parms->src, parms->dest, parms->width, parms->height ); break;
+		case DXT_COMPRESS_DXT1_FAST:			dxt.CompressImageDXT1Fast( parms->src, parms->dest, parms->width, parms->height ); break;
+		case DXT_COMPRESS_DXT5_HQ:				dxt.CompressImageDXT5HQ( parms->src, parms->dest, parms->width, parms->height ); break;
+		case DXT_COMPRESS_DXT5_FAST:			dxt.CompressImageDXT5Fast( parms->src, parms->dest, parms->width, parms->height ); break;
+		case DXT_COMPRESS_NORMAL_DXT5_HQ:		dxt.CompressNormalMapDXT5HQ( parms->src, parms->dest, parms->width, parms->height ); break;
+		case DXT_COMPRESS_NORMAL_DXT5_FAST:		dxt.CompressNormalMapDXT5Fast( parms->src, parms->dest, parms->width, parms->height ); break;
+		case DXT_COMPRESS_YCOCG_DXT5_HQ:		dxt.CompressYCoCgDXT5HQ( parms->src, parms->dest, parms->width, parms->height ); break;
+		case DXT_COMPRESS_YCOCG_DXT5_FAST:		dxt.CompressYCoCgDXT5Fast( parms->src, parms->dest, parms->width, parms->height ); break;
+	}
+}
+REGISTER_PARALLEL_JOB( DXT_CompressJob, "DXT_CompressJob" );
+
+/*
+========================
+AddCompressWork
+
+Splits the image in bands of whole block rows when it's compressed over the job threads.
+========================
+*/
+static void AddCompressWork( idList< dxtCompressParms_t > & work, const byte * src, byte * dest, int width, int height, dxtCompressMode_t mode, bool split ) {
+	const int blockBytes = ( mode == DXT_COMPRESS_DXT1_HQ || mode == DXT_COMPRESS_DXT1_FAST ) ? 8 : 16;
+	const int bandRows = ( split && width >= 4 && height > DXT_BAND_ROWS ) ? DXT_BAND_ROWS : height;
+	for ( int y = 0; y < height; y += bandRows ) {
+		dxtCompressParms_t & parms = work.Alloc();
+		parms.src = src + y * width * 4;
+		parms.dest = dest + ( y / 4 ) * ( width / 4 ) * blockBytes;
+		parms.width = width;
+		parms.height = Min( bandRows, height - y );
+		parms.mode = mode;
+	}
+}
+
+/*
+========================
+RunCompressWork
+========================
+*/
+static void RunCompressWork( idList< dxtCompressParms_t > & work, idParallelJobList * jobList ) {
+	if ( jobList == NULL || work.Num() <= 1 ) {
+		for ( int i = 0; i < work.Num(); i++ ) {
+			DXT_CompressJob( &work[i] );
+		}
+		return;
+	}
+	for ( int i = 0; i < work.Num(); i++ ) {
+		jobList->AddJob( (jobRun_t)DXT_CompressJob, &work[i] );
+	}
+	jobList->Submit();
+	jobList->Wait();
+}
+
 /*
 ========================
 idBinaryImage::Load2DFromMemory
+
+The levels are generated first and then compressed together, over the job threads when
+a job list is given.
 ========================
 */
-void idBinaryImage::Load2DFromMemory( int width, int height, const byte * pic_const, int numLevels, textureFormat_t & textureFormat, textureColor_t & colorFormat, bool gammaMips ) {
+void idBinaryImage::Load2DFromMemory( int width, int height, const byte * pic_const, int numLevels, textureFormat_t & textureFormat, textureColor_t & colorFormat, bool gammaMips, idParallelJobList * jobList ) {
 	fileData.textureType = TT_2D;
 	fileData.format = textureFormat;
 	fileData.colorFormat = colorFormat;
@@ -79,6 +173,16 @@ void idBinaryImage::Load2DFromMemory( int width, int height, const byte * pic_co
 		}
 	}
 
+	if ( jobList != NULL && !image_parallelCompression.GetBool() ) {
+		jobList = NULL;
+	}
+
+	// the source of each level has to stay around until it is compressed
+	idList< byte * > buffers;
+	idList< dxtCompressParms_t > work;
+	buffers.SetGranularity( 32 );
+	work.SetGranularity( 64 );
+
 	int	scaledWidth = width;
 	int scaledHeight = height;
 	images.SetNum( numLevels );
@@ -110,37 +214,22 @@ void idBinaryImage::Load2DFromMemory( int width, int height, const byte * pic_co
 		img.width = scaledWidth;
 		img.height = scaledHeight;
 
+		const bool hq = image_highQualityCompression.GetBool();
+		const bool split = ( jobList != NULL );
+
 		// compress data or convert floats as necessary
 		if ( textureFormat == FMT_DXT1 ) {
-			idDxtEncoder dxt;
 			img.Alloc( dxtWidth * dxtHeight / 2 );
-			if ( image_highQualityCompression.GetBool() ) {
-				dxt.CompressImageDXT1HQ( dxtPic, img.data, dxtWidth, dxtHeight );
-			} else {
-				dxt.CompressImageDXT1Fast( dxtPic, img.data, dxtWidth, dxtHeight );
-			}
+			AddCompressWork( work, dxtPic, img.data, dxtWidth, dxtHeight, hq ? DXT_COMPRESS_DXT1_HQ : DXT_COMPRESS_DXT1_FAST, split );
 		} else if ( textureFormat == FMT_DXT5 ) {
-			idDxtEncoder dxt;
 			img.Alloc( dxtWidth * dxtHeight );
 			if ( colorFormat == CFM_NORMAL_DXT5 ) {
-				if ( image_highQualityCompression.GetBool() ) {
-					dxt.CompressNormalMapDXT5HQ( dxtPic, img.data, dxtWidth, dxtHeight );
-				} else {
-					dxt.CompressNormalMapDXT5Fast( dxtPic, img.data, dxtWidth, dxtHeight );
-				}
+				AddCompressWork( work, dxtPic, img.data, dxtWidth, dxtHeight, hq ? DXT_COMPRESS_NORMAL_DXT5_HQ : DXT_COMPRESS_NORMAL_DXT5_FAST, split );
 			} else if ( colorFormat == CFM_YCOCG_DXT5 ) {
-				if ( image_highQualityCompression.GetBool() ) {
-					dxt.CompressYCoCgDXT5HQ( dxtPic, img.data, dxtWidth, dxtHeight );
-				} else {
-					dxt.CompressYCoCgDXT5Fast( dxtPic, img.data, dxtWidth, dxtHeight );
-				}
+				AddCompressWork( work, dxtPic, img.data, dxtWidth, dxtHeight, hq ? DXT_COMPRESS_YCOCG_DXT5_HQ : DXT_COMPRESS_YCOCG_DXT5_FAST, split );
 			} else {
 				fileData.colorFormat = colorFormat = CFM_DEFAULT;
-				if ( image_highQualityCompression.GetBool() ) {
-					dxt.CompressImageDXT5HQ( dxtPic, img.data, dxtWidth, dxtHeight );
-				} else {
-					dxt.CompressImageDXT5Fast( dxtPic, img.data, dxtWidth, dxtHeight );
-				}
+				AddCompressWork( work, dxtPic, img.data, dxtWidth, dxtHeight, hq ? DXT_COMPRESS_DXT5_HQ : DXT_COMPRESS_DXT5_FAST, split );
 			}
 		} else if ( textureFormat == FMT_LUM8 || textureFormat == FMT_INT8 ) {
 			// LUM8 and INT8 just read the red channel
@@ -176,10 +265,9 @@ void idBinaryImage::Load2DFromMemory( int width, int height, const byte * pic_co
 			}
 		}
 
-		// if we had to pad to quads, free the padded version
+		// if we had to pad to quads, free the padded version after compression
 		if ( pic != dxtPic ) {
-			Mem_Free( dxtPic );
-			dxtPic = NULL;
+			buffers.Append( dxtPic );
 		}
 
 		// downsample for the next level
@@ -189,13 +277,18 @@ void idBinaryImage::Load2DFromMemory( int width, int height, const byte * pic_co
 		} else {
 			shrunk = R_MipMap( pic, scaledWidth, scaledHeight );
 		}
-		Mem_Free( pic );
+		buffers.Append( pic );
 		pic = shrunk;
 
 		scaledWidth = Max( 1, scaledWidth >> 1 );
 		scaledHeight = Max( 1, scaledHeight >> 1 );
 	}
 
+	RunCompressWork( work, ( work.Num() <= MAX_IMAGE_COMPRESS_JOBS ) ? jobList : NULL );
+
+	for ( int i = 0; i < buffers.Num(); i++ ) {
+		Mem_Free( buffers[i] );
+	}
 	Mem_Free( pic );
 }
 
@@ -229,13 +322,23 @@ static void PadImageTo4x4( const byte *src, int width, int height, byte dest[64]
 idBinaryImage::LoadCubeFromMemory
 ========================
 */
-void idBinaryImage::LoadCubeFromMemory( int width, const byte * pics[6], int numLevels, textureFormat_t & textureFormat, bool gammaMips ) {
+void idBinaryImage::LoadCubeFromMemory( int width, const byte * pics[6], int numLevels, textureFormat_t & textureFormat, bool gammaMips, idParallelJobList * jobList ) {
 	fileData.textureType = TT_CUBIC;
 	fileData.format = textureFormat;
 	fileData.colorFormat = CFM_DEFAULT;
 	fileData.height = fileData.width = width;
 	fileData.numLevels = numLevels;
 
+	if ( jobList != NULL && !image_parallelCompression.GetBool() ) {
+		jobList = NULL;
+	}
+
+	// the down sampled sides have to stay around until they are compressed
+	idList< byte * > buffers;
+	idList< dxtCompressParms_t > work;
+	buffers.SetGranularity( 64 );
+	work.SetGranularity( 64 );
+
 	images.SetNum( fileData.numLevels * 6 );
 
 	for ( int side = 0; side < 6; side++ ) {
@@ -247,11 +350,12 @@ void idBinaryImage::LoadCubeFromMemory( int width, const byte * pics[6], int num
 			idBinaryImageData &img = images[ level * 6 + side ];
 
 			// handle padding blocks less than 4x4 for the DXT compressors
-			ALIGN16( byte padBlock[64] );
 			int		padSize;
 			const byte *padSrc;
 			if ( scaledWidth < 4 && ( textureFormat == FMT_DXT1 || textureFormat == FMT_DXT5 ) ) {
+				byte * padBlock = (byte *)Mem_Alloc( 64, TAG_TEMP );
 				PadImageTo4x4( pic, scaledWidth, scaledWidth, padBlock );
+				buffers.Append( padBlock );
 				padSize = 4;
 				padSrc = padBlock;
 			} else {
@@ -265,12 +369,10 @@ void idBinaryImage::LoadCubeFromMemory( int width, const byte * pics[6], int num
 			img.height = padSize;
 			if ( textureFormat == FMT_DXT1 ) {
 				img.Alloc( padSize * padSize / 2 );
-				idDxtEncoder dxt;
-				dxt.CompressImageDXT1Fast( padSrc, img.data, padSize, padSize );
+				AddCompressWork( work, padSrc, img.data, padSize, padSize, DXT_COMPRESS_DXT1_FAST, jobList != NULL );
 			} else if ( textureFormat == FMT_DXT5 ) {
 				img.Alloc( padSize * padSize );
-				idDxtEncoder dxt;
-				dxt.CompressImageDXT5Fast( padSrc, img.data, padSize, padSize );
+				AddCompressWork( work, padSrc, img.data, padSize, padSize, DXT_COMPRESS_DXT5_FAST, jobList != NULL );
 			} else {
 				fileData.format = textureFormat = FMT_RGBA8;
 				img.Alloc( padSize * padSize * 4 );
@@ -285,8 +387,7 @@ void idBinaryImage::LoadCubeFromMemory( int width, const byte * pics[6], int num
 				shrunk = R_MipMap( pic, scaledWidth, scaledWidth );
 			}
 			if ( pic != orig ) {
-				Mem_Free( (void *)pic );
-				pic = NULL;
+				buffers.Append( (byte *)pic );
 			}
 			pic = shrunk;
 
@@ -298,6 +399,12 @@ void idBinaryImage::LoadCubeFromMemory( int width, const byte * pics[6], int num
 			pic = NULL;
 		}
 	}
+
+	RunCompressWork( work, ( work.Num() <= MAX_IMAGE_COMPRESS_JOBS ) ? jobList : NULL );
+
+	for ( int i = 0; i < buffers.Num(); i++ ) {
+		Mem_Free( buffers[i] );
+	}
 }
 
 /*
@@ -446,4 +553,111 @@ void idBinaryImage::GetGeneratedFileName( idStr & gfn, const char *name ) {
 	gfn.Replace( " ", "" );
 }
 
+/*
+==========================
+R_FillDXTTestImage
+==========================
+*/
+static void R_FillDXTTestImage( byte * pic, int size, int pattern, idRandom & random ) {
+	for ( int y = 0; y < size; y++ ) {
+		for ( int x = 0; x < size; x++ ) {
+			byte * color = pic + ( y * size + x ) * 4;
+			for ( int k = 0; k < 4; k++ ) {
+				switch ( pattern ) {
+					case 0:		color[k] = (byte)random.RandomInt( 256 ); break;								// noise
+					case 1:		color[k] = (byte)( x * ( k + 1 ) + y * ( 4 - k ) + random.RandomInt( 16 ) ); break;	// noisy gradients
+					default:	color[k] = (byte)( 124 + random.RandomInt( 9 ) ); break;						// small range around the center
+				}
+			}
+			// the YCoCg encoders expect a constant scale per 4x4 block in the third channel
+			color[2] = (byte)( ( ( ( y >> 2 ) * 7 + ( x >> 2 ) * 13 ) & 3 ) << 3 );
+		}
+	}
+}
+
+/*
+==========================
+R_TestDXT_f
+
+Compresses synthetic images with the generic and the SIMD fast DXT encoders, verifies
+the output is identical and reports the throughput of both.
+
+testDXT [size] [iterations]
+==========================
+*/
+void R_TestDXT_f( const idCmdArgs &args ) {
+#ifdef ID_WIN_X86_SSE2_INTRIN
+	typedef void ( idDxtEncoder::*compressFunc_t )( const byte *inBuf, byte *outBuf, int width, int height );
+	struct dxtTestEncoder_t {
+		const char *	name;
+		compressFunc_t	generic;
+		compressFunc_t	simd;
+		int				blockBytes;
+	};
+	static const dxtTestEncoder_t encoders[] = {
+		{ "DXT1",			&idDxtEncoder::CompressImageDXT1Fast_Generic,			&idDxtEncoder::CompressImageDXT1Fast_SSE2,			8 },
+		{ "DXT1Alpha",		&idDxtEncoder::CompressImageDXT1AlphaFast_Generic,		&idDxtEncoder::CompressImageDXT1AlphaFast_SSE2,		8 },
+		{ "DXT5",			&idDxtEncoder::CompressImageDXT5Fast_Generic,			&idDxtEncoder::CompressImageDXT5Fast_SSE2,			16 },
+		{ "DXN1",			&idDxtEncoder::CompressImageDXN1Fast_Generic,			&idDxtEncoder::CompressImageDXN1Fast_SSE2,			8 },
+		{ "YCoCgDXT5",		&idDxtEncoder::CompressYCoCgDXT5Fast_Generic,			&idDxtEncoder::CompressYCoCgDXT5Fast_SSE2,			16 },
+		{ "YCoCgCTX1DXT5A",	&idDxtEncoder::CompressYCoCgCTX1DXT5AFast_Generic,		&idDxtEncoder::CompressYCoCgCTX1DXT5AFast_SSE2,		16 },
+		{ "NormalMapDXT5",	&idDxtEncoder::CompressNormalMapDXT5Fast_Generic,		&idDxtEncoder::CompressNormalMapDXT5Fast_SSE2,		16 },
+		{ "NormalMapDXN2",	&idDxtEncoder::CompressNormalMapDXN2Fast_Generic,		&idDxtEncoder::CompressNormalMapDXN2Fast_SSE2,		16 },
+	};
+	const int numPatterns = 3;
+
+	int size = ( args.Argc() > 1 ) ? atoi( args.Argv( 1 ) ) : 512;
+	int iterations = ( args.Argc() > 2 ) ? atoi( args.Argv( 2 ) ) : 4;
+	size = idMath::ClampInt( 16, 4096, size ) & ~3;
+	iterations = idMath::ClampInt( 1, 100, iterations );
+
+	byte * pic = (byte *)Mem_Alloc16( size * size * 4, TAG_TEMP );
+	byte * genericOut = (byte *)Mem_Alloc16( size * size, TAG_TEMP );
+	byte * simdOut = (byte *)Mem_Alloc16( size * size, TAG_TEMP );
+
+	const float megaPixels = (float)size * size * numPatterns * iterations / ( 1024.0f * 1024.0f );
+
+	idLib::Printf( "%dx%d images, %d patterns, %d iterations\n", size, size, numPatterns, iterations );
+	idLib::Printf( "encoder           generic MP/s   SSE2 MP/s   result\n" );
+	for ( int i = 0; i < ARRAY_COUNT( encoders ); i++ ) {
+		const dxtTestEncoder_t & test = encoders[i];
+		const int numBlocks = ( size / 4 ) * ( size / 4 );
+		uint64 genericTime = 0;
+		uint64 simdTime = 0;
+		int badBlocks = 0;
+
+		for ( int pattern = 0; pattern < numPatterns; pattern++ ) {
+			idRandom random( pattern );
+			R_FillDXTTestImage( pic, size, pattern, random );
+
+			idDxtEncoder encoder;
+			for ( int j = 0; j < iterations; j++ ) {
+				uint64 start = Sys_Microseconds();
+				( encoder.*test.generic )( pic, genericOut, size, size );
+				uint64 middle = Sys_Microseconds();
+				( encoder.*test.simd )( pic, simdOut, size, size );
+				uint64 end = Sys_Microseconds();
+				genericTime += middle - start;
+				simdTime += end - middle;
+			}
+
+			for ( int j = 0; j < numBlocks; j++ ) {
+				if ( memcmp( genericOut + j * test.blockBytes, simdOut + j * test.blockBytes, test.blockBytes ) != 0 ) {
+					badBlocks++;
+				}
+			}
+		}
+
+		idLib::Printf( "%-16s %12.1f %11.1f   %s\n", test.name,
+						megaPixels / Max( genericTime * 0.000001f, 0.000001f ),
+						megaPixels / Max( simdTime * 0.000001f, 0.000001f ),
+						badBlocks == 0 ? "bit exact" : va( "%d of %d blocks differ", badBlocks, numBlocks * numPatterns ) );
+	}
 
+	Mem_Free16( pic );
+	Mem_Free16( genericOut );
+	Mem_Free16( simdOut );
+#else
+	idLib::Printf( "testDXT: this build has no SIMD DXT encoders\n" );
+#endif
+}
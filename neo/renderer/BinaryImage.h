@@ -30,6 +30,10 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "BinaryImageData.h"
 
+// largest number of compression jobs a single image is split in, the job list passed to
+// Load2DFromMemory / LoadCubeFromMemory has to be allocated for at least this many jobs
+const int MAX_IMAGE_COMPRESS_JOBS = 1024;
+
 /*
 ================================================
 idBinaryImage is used by the idImage class for constructing mipmapped 
@@ -45,8 +49,8 @@ public:
 	const char *		GetName() const { return imgName.c_str(); }
 	void				SetName( const char *_name ) { imgName = _name; }
 
-	void				Load2DFromMemory( int width, int height, const byte * pic_const, int numLevels, textureFormat_t & textureFormat, textureColor_t & colorFormat, bool gammaMips );
-	void				LoadCubeFromMemory( int width, const byte * pics[6], int numLevels, textureFormat_t & textureFormat, bool gammaMips );
+	void				Load2DFromMemory( int width, int height, const byte * pic_const, int numLevels, textureFormat_t & textureFormat, textureColor_t & colorFormat, bool gammaMips, idParallelJobList * jobList = NULL );
+	void				LoadCubeFromMemory( int width, const byte * pics[6], int numLevels, textureFormat_t & textureFormat, bool gammaMips, idParallelJobList * jobList = NULL );
 
 	ID_TIME_T			LoadFromGeneratedFile( ID_TIME_T sourceFileTime );
 	ID_TIME_T			WriteGeneratedFile( ID_TIME_T sourceFileTime );
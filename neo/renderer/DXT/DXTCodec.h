@@ -97,7 +97,7 @@ public:
 	// fast single channel compression into, DXN1 (aka DXT5A or ATI1N) format, for real-time use
 	void	CompressImageDXN1Fast( const byte *inBuf, byte *outBuf, int width, int height );
 	void	CompressImageDXN1Fast_Generic( const byte *inBuf, byte *outBuf, int width, int height );
-	void	CompressImageDXN1Fast_SSE2( const byte *inBuf, byte *outBuf, int width, int height ) { /* not implemented */ assert( 0 ); }
+	void	CompressImageDXN1Fast_SSE2( const byte *inBuf, byte *outBuf, int width, int height );
 
 	// high quality YCoCg DXT5 compression, uses exhaustive search to find a line through color space and is very slow
 	void	CompressYCoCgDXT5HQ( const byte *inBuf, byte *outBuf, int width, int height );
@@ -116,7 +116,7 @@ public:
 	// fast YCoCg CTX1 + DXT5A compression for real-time use (the input is expected to be in CoCg_Y format)
 	void	CompressYCoCgCTX1DXT5AFast( const byte *inBuf, byte *outBuf, int width, int height );
 	void	CompressYCoCgCTX1DXT5AFast_Generic( const byte *inBuf, byte *outBuf, int width, int height );
-	void	CompressYCoCgCTX1DXT5AFast_SSE2( const byte *inBuf, byte *outBuf, int width, int height ) { /* not implemented */ assert( 0 ); }
+	void	CompressYCoCgCTX1DXT5AFast_SSE2( const byte *inBuf, byte *outBuf, int width, int height );
 
 	// high quality tangent space NxNyNz normal map compression into DXT1 format (Nz is not used)
 	void	CompressNormalMapDXT1HQ( const byte *inBuf, byte *outBuf, int width, int height );
@@ -142,7 +142,7 @@ public:
 	// fast tangent space NxNy_ normal map compression into DXN2 (3Dc, ATI2N) format, for real-time use
 	void	CompressNormalMapDXN2Fast( const byte *inBuf, byte *outBuf, int width, int height );
 	void	CompressNormalMapDXN2Fast_Generic( const byte *inBuf, byte *outBuf, int width, int height );
-	void	CompressNormalMapDXN2Fast_SSE2( const byte *inBuf, byte *outBuf, int width, int height ) { /* not implemented */ assert( 0 ); }
+	void	CompressNormalMapDXN2Fast_SSE2( const byte *inBuf, byte *outBuf, int width, int height );
 
 	// fast single channel conversion from DXN1 (aka DXT5A or ATI1N) to DXT1, reasonably fast (also works in-place)
 	void	ConvertImageDXN1_DXT1( const byte *inBuf, byte *outBuf, int width, int height );
@@ -230,15 +230,18 @@ private:
 	void				GetMinMaxBBox_SSE2( const byte *colorBlock, byte *minColor, byte *maxColor ) const;
 	void				InsetColorsBBox_SSE2( byte *minColor, byte *maxColor ) const;
 	void				InsetNormalsBBoxDXT5_SSE2( byte *minNormal, byte *maxNormal ) const;
+	void				InsetNormalsBBox3Dc_SSE2( byte *minNormal, byte *maxNormal ) const;
 	void				EmitColorIndices_SSE2( const byte *colorBlock, const byte *minColor, const byte *maxColor );
 	void				EmitColorAlphaIndices_SSE2( const byte *colorBlock, const byte *minColor, const byte *maxColor );
 	void				EmitCoCgIndices_SSE2( const byte *colorBlock, const byte *minColor, const byte *maxColor );
+	void				EmitCTX1Indices_SSE2( const byte *colorBlock, const byte *minColor, const byte *maxColor );
 	void				EmitAlphaIndices_SSE2( const byte *colorBlock, const int minAlpha, const int maxAlpha );
 	void				EmitAlphaIndices_SSE2( const byte *colorBlock, const int channelBitOffset, const int minAlpha, const int maxAlpha );
 	void				EmitGreenIndices_SSE2( const byte *block, const int channelBitOffset, const int minGreen, const int maxGreen );
 	void				ScaleYCoCg_SSE2( byte *colorBlock, byte *minColor, byte *maxColor ) const;
 	void				InsetYCoCgBBox_SSE2( byte *minColor, byte *maxColor ) const;
 	void				SelectYCoCgDiagonal_SSE2( const byte *colorBlock, byte *minColor, byte *maxColor ) const;
+	void				InsetCTX1BBox_SSE2( byte *minColor, byte *maxColor ) const;
 
 
 
@@ -297,7 +300,11 @@ idDxtEncoder::CompressImageDXN1Fast
 ========================
 */
 ID_INLINE void idDxtEncoder::CompressImageDXN1Fast( const byte *inBuf, byte *outBuf, int width, int height ) {
+#ifdef ID_WIN_X86_SSE2_INTRIN
+	CompressImageDXN1Fast_SSE2( inBuf, outBuf, width, height );
+#else
 	CompressImageDXN1Fast_Generic( inBuf, outBuf, width, height );
+#endif
 }
 
 /*
@@ -319,7 +326,11 @@ idDxtEncoder::CompressYCoCgCTX1DXT5AFast
 ========================
 */
 ID_INLINE void idDxtEncoder::CompressYCoCgCTX1DXT5AFast( const byte *inBuf, byte *outBuf, int width, int height ) {
+#ifdef ID_WIN_X86_SSE2_INTRIN
+	CompressYCoCgCTX1DXT5AFast_SSE2( inBuf, outBuf, width, height );
+#else
 	CompressYCoCgCTX1DXT5AFast_Generic( inBuf, outBuf, width, height );
+#endif
 }
 
 /*
@@ -341,7 +352,11 @@ idDxtEncoder::CompressNormalMapDXN2Fast
 ========================
 */
 ID_INLINE void idDxtEncoder::CompressNormalMapDXN2Fast( const byte *inBuf, byte *outBuf, int width, int height ) {
+#ifdef ID_WIN_X86_SSE2_INTRIN
+	CompressNormalMapDXN2Fast_SSE2( inBuf, outBuf, width, height );
+#else
 	CompressNormalMapDXN2Fast_Generic( inBuf, outBuf, width, height );
+#endif
 }
 
 /*
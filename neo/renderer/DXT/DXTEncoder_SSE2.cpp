@@ -2410,6 +2410,174 @@ void idDxtEncoder::CompressYCoCgDXT5Fast_SSE2( const byte *inBuf, byte *outBuf,
 #endif
 }
 
+/*
+========================
+idDxtEncoder::InsetCTX1BBox_SSE2
+
+Same as InsetColorsBBox. After SelectYCoCgDiagonal the max of the second channel can be
+below the min, InsetColorsBBox then wraps the inset to a byte and saturates the colors.
+========================
+*/
+ID_INLINE void idDxtEncoder::InsetCTX1BBox_SSE2( byte *minColor, byte *maxColor ) const {
+#if defined ( ID_WIN_X86_SSE2_INTRIN )
+	__m128i min = _mm_cvtsi32_si128( *(int *)minColor );
+	__m128i max = _mm_cvtsi32_si128( *(int *)maxColor );
+
+	__m128i temp0 = _mm_unpacklo_epi8( min, *(__m128i *)SIMD_SSE2_byte_0 );
+	__m128i temp1 = _mm_unpacklo_epi8( max, *(__m128i *)SIMD_SSE2_byte_0 );
+
+	__m128i inset = _mm_sub_epi16( temp1, temp0 );
+	inset = _mm_mulhi_epi16( inset, *(__m128i *)SIMD_SSE2_word_insetShift );
+	inset = _mm_and_si128( inset, *(__m128i *)SIMD_SSE2_word_255 );
+	inset = _mm_packus_epi16( inset, inset );
+
+	min = _mm_adds_epu8( min, inset );
+	max = _mm_subs_epu8( max, inset );
+
+	*((int *)minColor) = _mm_cvtsi128_si32( min );
+	*((int *)maxColor) = _mm_cvtsi128_si32( max );
+#else
+	assert( false );
+#endif
+}
+
+/*
+========================
+idDxtEncoder::EmitCTX1Indices_SSE2
+
+params:	colorBlock	- 16 pixel block for which to find color indices
+paramO:	minColor	- Min color found
+paramO:	maxColor	- Max color found
+return: 4 byte color index block
+========================
+*/
+void idDxtEncoder::EmitCTX1Indices_SSE2( const byte *colorBlock, const byte *minColor, const byte *maxColor ) {
+#if defined ( ID_WIN_X86_SSE2_INTRIN )
+	ALIGN16( word colors[4][2] );
+
+	colors[0][0] = maxColor[0];
+	colors[0][1] = maxColor[1];
+	colors[1][0] = minColor[0];
+	colors[1][1] = minColor[1];
+	colors[2][0] = ( 2 * colors[0][0] + 1 * colors[1][0] ) / 3;
+	colors[2][1] = ( 2 * colors[0][1] + 1 * colors[1][1] ) / 3;
+	colors[3][0] = ( 1 * colors[0][0] + 2 * colors[1][0] ) / 3;
+	colors[3][1] = ( 1 * colors[0][1] + 2 * colors[1][1] ) / 3;
+
+	__m128c block0 = *((__m128i *)(&colorBlock[ 0]));
+	__m128c block1 = *((__m128i *)(&colorBlock[16]));
+	__m128c block2 = *((__m128i *)(&colorBlock[32]));
+	__m128c block3 = *((__m128i *)(&colorBlock[48]));
+
+	// the first two channels of pixels 0-7 and 8-15 as words
+	__m128c c0[2], c1[2];
+	c0[0] = _mm_packs_epi32( _mm_and_si128( block0, (const __m128i &)SIMD_SSE2_dword_byte_mask ), _mm_and_si128( block1, (const __m128i &)SIMD_SSE2_dword_byte_mask ) );
+	c0[1] = _mm_packs_epi32( _mm_and_si128( block2, (const __m128i &)SIMD_SSE2_dword_byte_mask ), _mm_and_si128( block3, (const __m128i &)SIMD_SSE2_dword_byte_mask ) );
+	c1[0] = _mm_packs_epi32( _mm_and_si128( _mm_srli_epi32( block0, 8 ), (const __m128i &)SIMD_SSE2_dword_byte_mask ), _mm_and_si128( _mm_srli_epi32( block1, 8 ), (const __m128i &)SIMD_SSE2_dword_byte_mask ) );
+	c1[1] = _mm_packs_epi32( _mm_and_si128( _mm_srli_epi32( block2, 8 ), (const __m128i &)SIMD_SSE2_dword_byte_mask ), _mm_and_si128( _mm_srli_epi32( block3, 8 ), (const __m128i &)SIMD_SSE2_dword_byte_mask ) );
+
+	__m128c indices[2];
+	for ( int i = 0; i < 2; i++ ) {
+		__m128c d[4];
+		for ( int j = 0; j < 4; j++ ) {
+			// sum of the absolute differences, the words are unsigned bytes so saturation gives the absolute value
+			__m128c color0 = _mm_set1_epi16( colors[j][0] );
+			__m128c color1 = _mm_set1_epi16( colors[j][1] );
+			__m128c dist0 = _mm_or_si128( _mm_subs_epu16( color0, c0[i] ), _mm_subs_epu16( c0[i], color0 ) );
+			__m128c dist1 = _mm_or_si128( _mm_subs_epu16( color1, c1[i] ), _mm_subs_epu16( c1[i], color1 ) );
+			d[j] = _mm_add_epi16( dist0, dist1 );
+		}
+
+		__m128c b0 = _mm_cmpgt_epi16( d[0], d[3] );
+		__m128c b1 = _mm_cmpgt_epi16( d[1], d[2] );
+		__m128c b2 = _mm_cmpgt_epi16( d[0], d[2] );
+		__m128c b3 = _mm_cmpgt_epi16( d[1], d[3] );
+		__m128c b4 = _mm_cmpgt_epi16( d[2], d[3] );
+
+		__m128c x0 = _mm_and_si128( b1, b2 );
+		__m128c x1 = _mm_and_si128( b0, b3 );
+		__m128c x2 = _mm_and_si128( b0, b4 );
+
+		indices[i] = _mm_or_si128( _mm_and_si128( x2, (const __m128i &)SIMD_SSE2_word_1 ), _mm_and_si128( _mm_or_si128( x0, x1 ), (const __m128i &)SIMD_SSE2_word_2 ) );
+	}
+
+	// one index per byte, then merge neighbouring indices until there are 4 bytes with 4 indices each
+	__m128c temp = _mm_packus_epi16( indices[0], indices[1] );
+	temp = _mm_or_si128( _mm_and_si128( temp, (const __m128i &)SIMD_SSE2_word_255 ), _mm_srli_epi16( temp, 8 - 2 ) );
+	temp = _mm_or_si128( _mm_and_si128( temp, (const __m128i &)SIMD_SSE2_dword_word_mask ), _mm_srli_epi32( temp, 16 - 4 ) );
+	temp = _mm_packs_epi32( temp, temp );
+	temp = _mm_packus_epi16( temp, temp );
+
+	unsigned int result = _mm_cvtsi128_si32( temp );
+	EmitUInt( result );
+#else
+	assert( false );
+#endif
+}
+
+/*
+========================
+idDxtEncoder::CompressYCoCgCTX1DXT5AFast_SSE2
+
+params:	inBuf		- image to compress
+paramO:	outBuf		- result of compression
+params:	width		- width of image
+params:	height		- height of image
+========================
+*/
+void idDxtEncoder::CompressYCoCgCTX1DXT5AFast_SSE2( const byte *inBuf, byte *outBuf, int width, int height ) {
+	ALIGN16( byte block[64] );
+	ALIGN16( byte minColor[4] );
+	ALIGN16( byte maxColor[4] );
+
+	assert( width >= 4 && ( width & 3 ) == 0 );
+	assert( height >= 4 && ( height & 3 ) == 0 );
+
+	this->width = width;
+	this->height = height;
+	this->outData = outBuf;
+
+	for ( int j = 0; j < height; j += 4, inBuf += width * 4*4 ) {
+		for ( int i = 0; i < width; i += 4 ) {
+			ExtractBlock_SSE2( inBuf + i * 4, width, block );
+			GetMinMaxBBox_SSE2( block, minColor, maxColor );
+			SelectYCoCgDiagonal_SSE2( block, minColor, maxColor );
+			InsetCTX1BBox_SSE2( minColor, maxColor );
+
+			EmitByte( maxColor[3] );
+			EmitByte( minColor[3] );
+
+			EmitAlphaIndices_SSE2( block, 3*8, minColor[3], maxColor[3] );
+
+			EmitByte( maxColor[0] );
+			EmitByte( maxColor[1] );
+			EmitByte( minColor[0] );
+			EmitByte( minColor[1] );
+
+			EmitCTX1Indices_SSE2( block, minColor, maxColor );
+		}
+		outData += dstPadding;
+		inBuf += srcPadding;
+	}
+
+#ifdef TEST_COMPRESSION
+	int tmpDstPadding = dstPadding;
+	dstPadding = 0;
+	byte * testOutBuf = (byte *) _alloca16( width * height );
+	CompressYCoCgCTX1DXT5AFast_Generic( inBuf, testOutBuf, width, height );
+	for ( int j = 0; j < height / 4; j++ ) {
+		for ( int i = 0; i < width / 4; i++ ) {
+			byte * ptr1 = outBuf + ( j * width/4 + i ) * 16 + j * tmpDstPadding;
+			byte * ptr2 = testOutBuf + ( j * width/4 + i ) * 16;
+			for ( int k = 0; k < 16; k++ ) {
+				assert( ptr1[k] == ptr2[k] );
+			}
+		}
+	}
+	dstPadding = tmpDstPadding;
+#endif
+}
+
 /*
 ========================
 idDxtEncoder::EmitGreenIndices_SSE2
@@ -2775,4 +2943,161 @@ void idDxtEncoder::CompressNormalMapDXT5Fast_SSE2( const byte *inBuf, byte *outB
 #endif
 }
 
+/*
+========================
+idDxtEncoder::InsetNormalsBBox3Dc_SSE2
+========================
+*/
+void idDxtEncoder::InsetNormalsBBox3Dc_SSE2( byte *minNormal, byte *maxNormal ) const {
+#if defined ( ID_WIN_X86_SSE2_INTRIN )
+	__m128i temp0, temp1, temp2;
+
+	temp0 = _mm_cvtsi32_si128( *(int *)minNormal );
+	temp1 = _mm_cvtsi32_si128( *(int *)maxNormal );
+
+	temp0 = _mm_unpacklo_epi8( temp0, (const __m128i &)SIMD_SSE2_byte_0 );
+	temp1 = _mm_unpacklo_epi8( temp1, (const __m128i &)SIMD_SSE2_byte_0 );
+
+	temp2 = _mm_sub_epi16( temp1, temp0 );
+	temp2 = _mm_sub_epi16( temp2, (const __m128i &)SIMD_SSE2_word_insetNormal3DcRound );
+	temp2 = _mm_and_si128( temp2, (const __m128i &)SIMD_SSE2_word_insetNormal3DcMask );		// temp2 = inset (0 & 1)
+
+	temp0 = _mm_mullo_epi16( temp0, (const __m128i &)SIMD_SSE2_word_insetNormal3DcShiftUp );
+	temp1 = _mm_mullo_epi16( temp1, (const __m128i &)SIMD_SSE2_word_insetNormal3DcShiftUp );
+	temp0 = _mm_add_epi16( temp0, temp2 );
+	temp1 = _mm_sub_epi16( temp1, temp2 );
+	temp0 = _mm_mulhi_epi16( temp0, (const __m128i &)SIMD_SSE2_word_insetNormal3DcShiftDown );	// temp0 = mini
+	temp1 = _mm_mulhi_epi16( temp1, (const __m128i &)SIMD_SSE2_word_insetNormal3DcShiftDown );	// temp1 = maxi
+
+	// mini and maxi must be >= 0 and <= 255
+	temp0 = _mm_max_epi16( temp0, (const __m128i &)SIMD_SSE2_word_0 );
+	temp1 = _mm_max_epi16( temp1, (const __m128i &)SIMD_SSE2_word_0 );
+	temp0 = _mm_min_epi16( temp0, (const __m128i &)SIMD_SSE2_word_255 );
+	temp1 = _mm_min_epi16( temp1, (const __m128i &)SIMD_SSE2_word_255 );
+
+	temp0 = _mm_packus_epi16( temp0, temp0 );
+	temp1 = _mm_packus_epi16( temp1, temp1 );
+
+	*(int *)minNormal = _mm_cvtsi128_si32( temp0 );
+	*(int *)maxNormal = _mm_cvtsi128_si32( temp1 );
+#else
+	assert( false );
+#endif
+}
+
+/*
+========================
+idDxtEncoder::CompressImageDXN1Fast_SSE2
+
+params:	inBuf		- image to compress
+paramO:	outBuf		- result of compression
+params:	width		- width of image
+params:	height		- height of image
+========================
+*/
+void idDxtEncoder::CompressImageDXN1Fast_SSE2( const byte *inBuf, byte *outBuf, int width, int height ) {
+	ALIGN16( byte block[64] );
+	ALIGN16( byte min[4] );
+	ALIGN16( byte max[4] );
+
+	assert( width >= 4 && ( width & 3 ) == 0 );
+	assert( height >= 4 && ( height & 3 ) == 0 );
+
+	this->width = width;
+	this->height = height;
+	this->outData = outBuf;
+
+	for ( int j = 0; j < height; j += 4, inBuf += width * 4*4 ) {
+		for ( int i = 0; i < width; i += 4 ) {
+			ExtractBlock_SSE2( inBuf + i * 4, width, block );
+			GetMinMaxBBox_SSE2( block, min, max );
+			InsetNormalsBBox3Dc_SSE2( min, max );
+
+			// Write out an alpha channel.
+			EmitByte( max[0] );
+			EmitByte( min[0] );
+			EmitAlphaIndices_SSE2( block, 0*8, min[0], max[0] );
+		}
+		outData += dstPadding;
+		inBuf += srcPadding;
+	}
+
+#ifdef TEST_COMPRESSION
+	int tmpDstPadding = dstPadding;
+	dstPadding = 0;
+	byte * testOutBuf = (byte *) _alloca16( width * height / 2 );
+	CompressImageDXN1Fast_Generic( inBuf, testOutBuf, width, height );
+	for ( int j = 0; j < height / 4; j++ ) {
+		for ( int i = 0; i < width / 4; i++ ) {
+			byte * ptr1 = outBuf + ( j * width/4 + i ) * 8 + j * tmpDstPadding;
+			byte * ptr2 = testOutBuf + ( j * width/4 + i ) * 8;
+			for ( int k = 0; k < 8; k++ ) {
+				assert( ptr1[k] == ptr2[k] );
+			}
+		}
+	}
+	dstPadding = tmpDstPadding;
+#endif
+}
+
+/*
+========================
+idDxtEncoder::CompressNormalMapDXN2Fast_SSE2
+
+params:	inBuf		- image to compress in NxNy__ component order
+paramO:	outBuf		- result of compression
+params:	width		- width of image
+params:	height		- height of image
+========================
+*/
+void idDxtEncoder::CompressNormalMapDXN2Fast_SSE2( const byte *inBuf, byte *outBuf, int width, int height ) {
+	ALIGN16( byte block[64] );
+	ALIGN16( byte normal1[4] );
+	ALIGN16( byte normal2[4] );
+
+	assert( width >= 4 && ( width & 3 ) == 0 );
+	assert( height >= 4 && ( height & 3 ) == 0 );
+
+	this->width = width;
+	this->height = height;
+	this->outData = outBuf;
+
+	for ( int j = 0; j < height; j += 4, inBuf += width * 4*4 ) {
+		for ( int i = 0; i < width; i += 4 ) {
+			ExtractBlock_SSE2( inBuf + i * 4, width, block );
+			GetMinMaxBBox_SSE2( block, normal1, normal2 );
+			InsetNormalsBBox3Dc_SSE2( normal1, normal2 );
+
+			// Write out Nx as an alpha channel.
+			EmitByte( normal2[0] );
+			EmitByte( normal1[0] );
+			EmitAlphaIndices_SSE2( block, 0*8, normal1[0], normal2[0] );
+
+			// Write out Ny as an alpha channel.
+			EmitByte( normal2[1] );
+			EmitByte( normal1[1] );
+			EmitAlphaIndices_SSE2( block, 1*8, normal1[1], normal2[1] );
+		}
+		outData += dstPadding;
+		inBuf += srcPadding;
+	}
+
+#ifdef TEST_COMPRESSION
+	int tmpDstPadding = dstPadding;
+	dstPadding = 0;
+	byte * testOutBuf = (byte *) _alloca16( width * height );
+	CompressNormalMapDXN2Fast_Generic( inBuf, testOutBuf, width, height );
+	for ( int j = 0; j < height / 4; j++ ) {
+		for ( int i = 0; i < width / 4; i++ ) {
+			byte * ptr1 = outBuf + ( j * width/4 + i ) * 16 + j * tmpDstPadding;
+			byte * ptr2 = testOutBuf + ( j * width/4 + i ) * 16;
+			for ( int k = 0; k < 16; k++ ) {
+				assert( ptr1[k] == ptr2[k] );
+			}
+		}
+	}
+	dstPadding = tmpDstPadding;
+#endif
+}
+
 #endif
@@ -115,6 +115,10 @@ public:
 	void		SetReferencedOutsideLevelLoad() { referencedOutsideLevelLoad = true; }
 	void		SetReferencedInsideLevelLoad() { levelLoadReferenced = true; }
 	void		ActuallyLoadImage( bool fromBackEnd );
+
+	// Loads the source pictures and derives the options of the generated file, without
+	// changing the loaded image. Used to rebuild generated files off the render path.
+	bool		LoadBuildSource( byte * pics[6], idImageOpts & buildOpts, idStr & generatedName, ID_TIME_T & buildSourceTime ) const;
 	//---------------------------------------------
 	// Platform specific implementations
 	//---------------------------------------------
@@ -224,6 +228,7 @@ public:
 	{
 		insideLevelLoad = false;
 		preloadingMapImages = false;
+		compressJobList = NULL;
 	}
 
 	void				Init();
@@ -275,6 +280,10 @@ public:
 	// Loads unloaded level images
 	int					LoadLevelImages( bool pacifier );
 
+	// Rebuilds the generated files of the images loaded from files, in batches built
+	// over the job threads. Only the images used by the level unless all is set.
+	void				BuildGeneratedImages( bool all );
+
 	// used to clear and then write the dds conversion batch file
 	void				StartBuild();
 	void				FinishBuild( bool removeDups = false );
@@ -312,6 +321,8 @@ public:
 
 	bool				insideLevelLoad;			// don't actually load images now
 	bool				preloadingMapImages;		// unless this is set
+
+	idParallelJobList *	compressJobList;			// compresses images generated on the main thread
 };
 
 extern idImageManager	*globalImages;		// pointer to global list for the rest of the system
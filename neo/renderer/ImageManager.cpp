@@ -37,7 +37,11 @@ If you have questions concerning this license or the applicable additional terms
 idImageManager	imageManager;
 idImageManager * globalImages = &imageManager;
 
+extern idCVar image_parallelCompression;
+
 idCVar preLoad_Images( "preLoad_Images", "1", CVAR_SYSTEM | CVAR_BOOL, "preload images during beginlevelload" );
+idCVar image_buildBatchSize( "image_buildBatchSize", "64", CVAR_INTEGER, "maximum number of images built at the same time by buildImages", 1, MAX_IMAGE_COMPRESS_JOBS );
+idCVar image_buildBatchMegaPixels( "image_buildBatchMegaPixels", "64", CVAR_INTEGER, "maximum number of source mega pixels kept in memory by buildImages", 1, 1024 );
 
 /*
 ===============
@@ -66,6 +70,31 @@ void R_ReloadImages_f( const idCmdArgs &args ) {
 	globalImages->ReloadImages( all );
 }
 
+/*
+===============
+R_BuildImages_f
+
+Rebuilds the generated image files, so they can be timed or refreshed without
+going through the renderer. Use reloadImages afterwards to upload them.
+
+buildImages <all>
+===============
+*/
+void R_BuildImages_f( const idCmdArgs &args ) {
+	bool all = false;
+
+	if ( args.Argc() == 2 ) {
+		if ( !idStr::Icmp( args.Argv(1), "all" ) ) {
+			all = true;
+		} else {
+			common->Printf( "USAGE: buildImages <all>\n" );
+			return;
+		}
+	}
+
+	globalImages->BuildGeneratedImages( all );
+}
+
 typedef struct {
 	idImage	*image;
 	int		size;
@@ -675,6 +704,9 @@ void idImageManager::Init() {
 	cmdSystem->AddCommand( "reloadImages", R_ReloadImages_f, CMD_FL_RENDERER, "reloads images" );
 	cmdSystem->AddCommand( "listImages", R_ListImages_f, CMD_FL_RENDERER, "lists images" );
 	cmdSystem->AddCommand( "combineCubeImages", R_CombineCubeImages_f, CMD_FL_RENDERER, "combines six images for roq compression" );
+	cmdSystem->AddCommand( "buildImages", R_BuildImages_f, CMD_FL_RENDERER, "rebuilds the generated files of the level images" );
+
+	compressJobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, MAX_IMAGE_COMPRESS_JOBS, 0, NULL );
 
 	// should forceLoadImages be here?
 }
@@ -688,6 +720,11 @@ void idImageManager::Shutdown() {
 	images.DeleteContents( true );
 	imageHash.Clear();
 
+	if ( compressJobList != NULL ) {
+		parallelJobManager->FreeJobList( compressJobList );
+		compressJobList = NULL;
+	}
+
 }
 
 /*
@@ -752,7 +789,29 @@ void idImageManager::Preload( const idPreloadManifest &manifest, const bool & ma
 		int	start = Sys_Milliseconds();
 		int numLoaded = 0;
 
-		//fileSystem->StartPreload( preloadImageFiles );
+		idStrList preloadImageFiles;
+		idStr generatedName;
+		idStr generatedFileName;
+		for ( int i = 0; i < manifest.NumResources(); i++ ) {
+			const preloadEntry_s & p = manifest.GetPreloadByIndex( i );
+			if ( p.resType == PRELOAD_IMAGE && !ExcludePreloadImage( p.resourceName ) ) {
+				// mirror the name and usage fixups ImageFromFile does
+				textureUsage_t usage = ( textureUsage_t )p.imgData.usage;
+				if ( idStr::Icmpn( p.resourceName, "fonts", 5 ) == 0 || idStr::Icmpn( p.resourceName, "newfonts", 8 ) == 0 ) {
+					usage = TD_FONT;
+				} else if ( idStr::Icmpn( p.resourceName, "lights", 6 ) == 0 ) {
+					usage = TD_LIGHT;
+				}
+				generatedName = p.resourceName;
+				generatedName.Replace( ".tga", "" );
+				generatedName.BackSlashesToSlashes();
+				idImage::GetGeneratedName( generatedName, usage, ( cubeFiles_t )p.imgData.cubeMap );
+				idBinaryImage::GetGeneratedFileName( generatedFileName, generatedName );
+				preloadImageFiles.Append( generatedFileName );
+			}
+		}
+
+		fileSystem->StartPreload( preloadImageFiles );
 		for ( int i = 0; i < manifest.NumResources(); i++ ) {
 			const preloadEntry_s & p = manifest.GetPreloadByIndex( i );
 			if ( p.resType == PRELOAD_IMAGE && !ExcludePreloadImage( p.resourceName ) ) {
@@ -760,7 +819,7 @@ void idImageManager::Preload( const idPreloadManifest &manifest, const bool & ma
 				numLoaded++;
 			}
 		}
-		//fileSystem->StopPreload();
+		fileSystem->StopPreload();
 		int	end = Sys_Milliseconds();
 		common->Printf( "%05d images preloaded ( or were already loaded ) in %5.1f seconds\n", numLoaded, ( end - start ) * 0.001 );
 		common->Printf( "----------------------------------------\n" );
@@ -793,6 +852,149 @@ int idImageManager::LoadLevelImages( bool pacifier ) {
 	return loadCount;
 }
 
+/*
+===============
+BuildImageJob
+===============
+*/
+struct imageBuildParms_t {
+	idBinaryImage *		binary;
+	byte *				pics[6];		// only the first one is used for 2D images
+	bool				cube;
+	int					width;
+	int					height;
+	int					numLevels;
+	textureFormat_t		format;
+	textureColor_t		colorFormat;
+	bool				gammaMips;
+	ID_TIME_T			sourceFileTime;
+};
+
+void BuildImageJob( imageBuildParms_t * parms ) {
+	// the levels of a single image are compressed serially, the images are spread over the jobs
+	if ( parms->cube ) {
+		parms->binary->LoadCubeFromMemory( parms->width, (const byte **)parms->pics, parms->numLevels, parms->format, parms->gammaMips );
+	} else {
+		parms->binary->Load2DFromMemory( parms->width, parms->height, parms->pics[0], parms->numLevels, parms->format, parms->colorFormat, parms->gammaMips );
+	}
+}
+REGISTER_PARALLEL_JOB( BuildImageJob, "BuildImageJob" );
+
+/*
+===============
+idImageManager::BuildGeneratedImages
+
+The source images are loaded and the generated files are written on the main thread,
+only the mip map generation and compression are done by the jobs.
+===============
+*/
+void idImageManager::BuildGeneratedImages( bool all ) {
+	if ( com_productionMode.GetInteger() != 0 ) {
+		common->Warning( "buildImages: the source images aren't available in production mode" );
+		return;
+	}
+
+	idList< idImage * > sources;
+	for ( int i = 0; i < images.Num(); i++ ) {
+		idImage * image = images[i];
+		if ( image->generatorFunction ) {
+			continue;
+		}
+		if ( !all && !image->levelLoadReferenced && !image->IsLoaded() ) {
+			continue;
+		}
+		sources.Append( image );
+	}
+
+	common->Printf( "----- idImageManager::BuildGeneratedImages -----\n" );
+
+	const int maxBatchImages = image_buildBatchSize.GetInteger();
+	const int64 maxBatchPixels = (int64)image_buildBatchMegaPixels.GetInteger() << 20;
+
+	idList< imageBuildParms_t > batch;
+	batch.Resize( maxBatchImages );
+
+	int numBuilt = 0;
+	int numFailed = 0;
+	int64 numPixels = 0;
+	int64 numBytes = 0;
+	const int64 start = Sys_Microseconds();
+
+	for ( int next = 0; next < sources.Num(); ) {
+		batch.SetNum( 0 );
+		int64 batchPixels = 0;
+
+		// load the sources, image programs and the file system are not thread safe
+		while ( next < sources.Num() && batch.Num() < maxBatchImages && batchPixels < maxBatchPixels ) {
+			const idImage * source = sources[next++];
+
+			imageBuildParms_t parms;
+			memset( &parms, 0, sizeof( parms ) );
+
+			idImageOpts buildOpts;
+			idStrStatic< MAX_OSPATH > generatedName;
+			if ( !source->LoadBuildSource( parms.pics, buildOpts, generatedName, parms.sourceFileTime ) ) {
+				numFailed++;
+				continue;
+			}
+
+			parms.binary = new (TAG_IMAGE) idBinaryImage( generatedName );
+			parms.cube = ( buildOpts.textureType == TT_CUBIC );
+			parms.width = buildOpts.width;
+			parms.height = buildOpts.height;
+			parms.numLevels = buildOpts.numLevels;
+			parms.format = buildOpts.format;
+			parms.colorFormat = buildOpts.colorFormat;
+			parms.gammaMips = buildOpts.gammaMips;
+			batch.Append( parms );
+
+			const int64 pixels = (int64)parms.width * parms.height * ( parms.cube ? 6 : 1 );
+			batchPixels += pixels;
+			numPixels += pixels;
+		}
+
+		// build the mip maps and compress them
+		if ( compressJobList != NULL && image_parallelCompression.GetBool() && batch.Num() > 1 ) {
+			for ( int i = 0; i < batch.Num(); i++ ) {
+				compressJobList->AddJob( (jobRun_t)BuildImageJob, &batch[i] );
+			}
+			compressJobList->Submit();
+			compressJobList->Wait();
+		} else {
+			for ( int i = 0; i < batch.Num(); i++ ) {
+				BuildImageJob( &batch[i] );
+			}
+		}
+
+		// write the generated files
+		for ( int i = 0; i < batch.Num(); i++ ) {
+			imageBuildParms_t & parms = batch[i];
+			parms.binary->WriteGeneratedFile( parms.sourceFileTime );
+			for ( int j = 0; j < parms.binary->NumImages(); j++ ) {
+				numBytes += parms.binary->GetImageHeader( j ).dataSize;
+			}
+			numBuilt++;
+
+			for ( int j = 0; j < 6; j++ ) {
+				if ( parms.pics[j] != NULL ) {
+					Mem_Free( parms.pics[j] );
+				}
+			}
+			delete parms.binary;
+		}
+	}
+
+	const float seconds = ( Sys_Microseconds() - start ) * 0.000001f;
+	const float megaPixels = numPixels / ( 1024.0f * 1024.0f );
+	common->Printf( "%5i images built, %i failed, in %5.2f seconds\n", numBuilt, numFailed, seconds );
+	common->Printf( "%7.1f MP source, %7.1f MB generated\n", megaPixels, numBytes / ( 1024.0f * 1024.0f ) );
+	if ( seconds > 0.0f ) {
+		common->Printf( "%7.1f MP/s, %7.1f images/s\n", megaPixels / seconds, numBuilt / seconds );
+	}
+	common->Printf( "use reloadImages to upload the generated images\n" );
+	common->Printf( "------------------------------------------------\n" );
+}
+
 /*
 ===============
 idImageManager::EndLevelLoad
@@ -356,6 +356,9 @@ void idImage::ActuallyLoadImage( bool fromBackEnd ) {
 			fileSystem->AddImagePreload( GetName(), filter, repeat, usage, cubeFiles );
 		}
 	} else {
+		// the job list is only used from the main thread, the back end may load images on demand
+		idParallelJobList * jobList = idLib::IsMainThread() ? globalImages->compressJobList : NULL;
+
 		if ( cubeFiles != CF_2D ) {
 			int size;
 			byte * pics[6];
@@ -371,7 +374,7 @@ void idImage::ActuallyLoadImage( bool fromBackEnd ) {
 			opts.height = size;
 			opts.numLevels = 0;
 			DeriveOpts();
-			im.LoadCubeFromMemory( size, (const byte **)pics, opts.numLevels, opts.format, opts.gammaMips );
+			im.LoadCubeFromMemory( size, (const byte **)pics, opts.numLevels, opts.format, opts.gammaMips, jobList );
 			repeat = TR_CLAMP;
 
 			for ( int i = 0; i < 6; i++ ) {
@@ -409,7 +412,7 @@ void idImage::ActuallyLoadImage( bool fromBackEnd ) {
 			opts.height = height;
 			opts.numLevels = 0;
 			DeriveOpts();
-			im.Load2DFromMemory( opts.width, opts.height, pic, opts.numLevels, opts.format, opts.colorFormat, opts.gammaMips );
+			im.Load2DFromMemory( opts.width, opts.height, pic, opts.numLevels, opts.format, opts.colorFormat, opts.gammaMips, jobList );
 
 			Mem_Free( pic );
 		}
@@ -426,6 +429,52 @@ void idImage::ActuallyLoadImage( bool fromBackEnd ) {
 	}
 }
 
+/*
+===============
+LoadBuildSource
+
+Follows the generation path of ActuallyLoadImage on a copy of the image parameters.
+The pictures are allocated with Mem_Alloc, only pics[0] is set for 2D images.
+===============
+*/
+bool idImage::LoadBuildSource( byte * pics[6], idImageOpts & buildOpts, idStr & generatedName, ID_TIME_T & buildSourceTime ) const {
+	idImage image( GetName() );
+	image.cubeFiles = cubeFiles;
+	image.usage = usage;
+
+	for ( int i = 0; i < 6; i++ ) {
+		pics[i] = NULL;
+	}
+
+	int width = 0;
+	int height = 0;
+	if ( image.cubeFiles != CF_2D ) {
+		if ( !R_LoadCubeImages( image.GetName(), image.cubeFiles, pics, &width, &buildSourceTime ) || width == 0 ) {
+			idLib::Warning( "Couldn't load cube image: %s", image.GetName() );
+			return false;
+		}
+		height = width;
+		image.opts.textureType = TT_CUBIC;
+	} else {
+		R_LoadImageProgram( image.GetName(), &pics[0], &width, &height, &buildSourceTime, &image.usage );
+		if ( pics[0] == NULL ) {
+			idLib::Warning( "Couldn't load image: %s", image.GetName() );
+			return false;
+		}
+		image.opts.textureType = TT_2D;
+	}
+	image.opts.width = width;
+	image.opts.height = height;
+	image.opts.numLevels = 0;
+	image.DeriveOpts();
+
+	generatedName = image.GetName();
+	GetGeneratedName( generatedName, image.usage, image.cubeFiles );
+
+	buildOpts = image.opts;
+	return true;
+}
+
 /*
 ==============
 Bind
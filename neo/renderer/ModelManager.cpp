@@ -72,6 +72,7 @@ private:
 	static void				ListModels_f( const idCmdArgs &args );
 	static void				ReloadModels_f( const idCmdArgs &args );
 	static void				TouchModel_f( const idCmdArgs &args );
+	static void				BenchmarkSkinning_f( const idCmdArgs &args );
 };
 
 
@@ -112,6 +113,28 @@ void idRenderModelManagerLocal::PrintModel_f( const idCmdArgs &args ) {
 	model->Print();
 }
 
+/*
+==============
+idRenderModelManagerLocal::BenchmarkSkinning_f
+==============
+*/
+void idRenderModelManagerLocal::BenchmarkSkinning_f( const idCmdArgs &args ) {
+	if ( args.Argc() < 2 ) {
+		common->Printf( "usage: benchmarkSkinning <modelName> [iterations]\n" );
+		return;
+	}
+
+	idRenderModel * model = renderModelManager->FindModel( args.Argv( 1 ) );
+	idRenderModelMD5 * md5 = dynamic_cast< idRenderModelMD5 * >( model );
+	if ( md5 == NULL || md5->IsDefaultModel() ) {
+		common->Printf( "model \"%s\" is not an md5 mesh\n", args.Argv( 1 ) );
+		return;
+	}
+
+	const int iterations = ( args.Argc() > 2 ) ? Max( 1, atoi( args.Argv( 2 ) ) ) : 100;
+	md5->BenchmarkSkinning( iterations );
+}
+
 /*
 ==============
 idRenderModelManagerLocal::ListModels_f
@@ -212,6 +235,7 @@ void idRenderModelManagerLocal::Init() {
 	cmdSystem->AddCommand( "printModel", PrintModel_f, CMD_FL_RENDERER, "prints model info", idCmdSystem::ArgCompletion_ModelName );
 	cmdSystem->AddCommand( "reloadModels", ReloadModels_f, CMD_FL_RENDERER|CMD_FL_CHEAT, "reloads models" );
 	cmdSystem->AddCommand( "touchModel", TouchModel_f, CMD_FL_RENDERER, "touches a model", idCmdSystem::ArgCompletion_ModelName );
+	cmdSystem->AddCommand( "benchmarkSkinning", BenchmarkSkinning_f, CMD_FL_RENDERER, "times generic and SIMD skinning of an md5 mesh", idCmdSystem::ArgCompletion_ModelName );
 
 	insideLevelLoad = false;
 
@@ -559,6 +583,7 @@ void idRenderModelManagerLocal::Preload( const idPreloadManifest &manifest  ) {
 		int numLoaded = 0;
 		idList< preloadSort_t > preloadSort;
 		preloadSort.Resize( manifest.NumResources() );
+		idStrList preloadFiles;
 		for ( int i = 0; i < manifest.NumResources(); i++ ) {
 			const preloadEntry_s & p = manifest.GetPreloadByIndex( i );
 			idResourceCacheEntry rc;
@@ -581,12 +606,15 @@ void idRenderModelManagerLocal::Preload( const idPreloadManifest &manifest  ) {
 					ps.idx = i;
 					ps.ofs = rc.offset;
 					preloadSort.Append( ps );
+					preloadFiles.Append( filename.c_str() );
 				}
 			}
 		}
 		
 		preloadSort.SortWithTemplate( idSort_Preload() );
 
+		fileSystem->StartPreload( preloadFiles );
+
 		for ( int i = 0; i < preloadSort.Num(); i++ ) {
 			const preloadSort_t & ps = preloadSort[ i ];
 			const preloadEntry_s & p = manifest.GetPreloadByIndex( ps.idx );
@@ -600,6 +628,7 @@ void idRenderModelManagerLocal::Preload( const idPreloadManifest &manifest  ) {
 			}
 			numLoaded++;
 		}
+		fileSystem->StopPreload();
 
 		int	end = Sys_Milliseconds();
 		common->Printf( "%05d models preloaded ( or were already loaded ) in %5.1f seconds\n", numLoaded, ( end - start ) * 0.001 );
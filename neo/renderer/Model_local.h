@@ -202,6 +202,8 @@ public:
 
 	virtual bool				SupportsBinaryModel() { return true; }
 
+	void						BenchmarkSkinning( int iterations ) const;
+
 private:
 	idList<idMD5Joint, TAG_MODEL>	joints;
 	idList<idJointQuat, TAG_MODEL>	defaultPose;
@@ -31,6 +31,7 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "tr_local.h"
 #include "Model_local.h"
+#include "../idlib/math/Simd_Generic.h"
 
 #ifdef ID_WIN_X86_SSE2_INTRIN
 
@@ -399,38 +400,6 @@ void idMD5Mesh::ParseMesh( idLexer &parser, int numJoints, const idJointMat *joi
 	Mem_Free( basePose );
 }
 
-/*
-============
-TransformVertsAndTangents
-============
-*/
-void TransformVertsAndTangents( idDrawVert * targetVerts, const int numVerts, const idDrawVert *baseVerts, const idJointMat *joints ) {
-	for( int i = 0; i < numVerts; i++ ) {
-		const idDrawVert & base = baseVerts[i];
-
-		const idJointMat & j0 = joints[base.color[0]];
-		const idJointMat & j1 = joints[base.color[1]];
-		const idJointMat & j2 = joints[base.color[2]];
-		const idJointMat & j3 = joints[base.color[3]];
-
-		const float w0 = base.color2[0] * ( 1.0f / 255.0f );
-		const float w1 = base.color2[1] * ( 1.0f / 255.0f );
-		const float w2 = base.color2[2] * ( 1.0f / 255.0f );
-		const float w3 = base.color2[3] * ( 1.0f / 255.0f );
-
-		idJointMat accum;
-		idJointMat::Mul( accum, j0, w0 );
-		idJointMat::Mad( accum, j1, w1 );
-		idJointMat::Mad( accum, j2, w2 );
-		idJointMat::Mad( accum, j3, w3 );
-
-		targetVerts[i].xyz = accum * idVec4( base.xyz.x, base.xyz.y, base.xyz.z, 1.0f );
-		targetVerts[i].SetNormal( accum * base.GetNormal() );
-		targetVerts[i].SetTangent( accum * base.GetTangent() );
-		targetVerts[i].tangent[3] = base.tangent[3];
-	}
-}
-
 /*
 ====================
 idMD5Mesh::UpdateSurface
@@ -489,7 +458,7 @@ void idMD5Mesh::UpdateSurface( const struct renderEntity_s *ent, const idJointMa
 			assert( tri->verts != NULL );	// quiet analyze warning
 			memcpy( tri->verts, deformInfo->verts, deformInfo->numOutputVerts * sizeof( deformInfo->verts[0] ) );	// copy over the texture coordinates
 		}
-		TransformVertsAndTangents( tri->verts, deformInfo->numOutputVerts, deformInfo->verts, entJointsInverted );
+		SIMDProcessor->TransformVertsAndTangents( tri->verts, deformInfo->numOutputVerts, deformInfo->verts, entJointsInverted );
 		tri->referencedVerts = false;
 	}
 	tri->tangentsCalculated = true;
@@ -1429,3 +1398,71 @@ int	idRenderModelMD5::Memory() const {
 	}
 	return total;
 }
+
+/*
+===================
+idRenderModelMD5::BenchmarkSkinning
+
+Skins every mesh in the default pose with the generic and the active SIMD
+processor and compares the timings and results.
+===================
+*/
+void idRenderModelMD5::BenchmarkSkinning( int iterations ) const {
+	if ( meshes.Num() == 0 || joints.Num() == 0 ) {
+		common->Printf( "%s: no meshes\n", Name() );
+		return;
+	}
+
+	idSIMD_Generic genericProcessor;
+
+	idTempArray< idJointMat > poseMat( SIMD_ROUND_JOINTS( joints.Num() ) );
+	idTempArray< idJointMat > skinJoints( SIMD_ROUND_JOINTS( joints.Num() ) );
+	SIMDProcessor->ConvertJointQuatsToJointMats( poseMat.Ptr(), defaultPose.Ptr(), joints.Num() );
+	SIMD_INIT_LAST_JOINT( poseMat.Ptr(), joints.Num() );
+	TransformJoints( skinJoints.Ptr(), joints.Num(), poseMat.Ptr(), invertedDefaultPose.Ptr() );
+
+	int totalVerts = 0;
+	int mismatches = 0;
+	uint64 genericMicroseconds = 0;
+	uint64 simdMicroseconds = 0;
+
+	for ( int i = 0; i < meshes.Num(); i++ ) {
+		const deformInfo_t * deform = meshes[i].deformInfo;
+		if ( deform == NULL || deform->numOutputVerts == 0 ) {
+			continue;
+		}
+		const int numVerts = deform->numOutputVerts;
+
+		idTempArray< idDrawVert > genericVerts( numVerts );
+		idTempArray< idDrawVert > simdVerts( numVerts );
+		memcpy( genericVerts.Ptr(), deform->verts, numVerts * sizeof( idDrawVert ) );
+		memcpy( simdVerts.Ptr(), deform->verts, numVerts * sizeof( idDrawVert ) );
+
+		uint64 start = Sys_Microseconds();
+		for ( int j = 0; j < iterations; j++ ) {
+			genericProcessor.TransformVertsAndTangents( genericVerts.Ptr(), numVerts, deform->verts, skinJoints.Ptr() );
+		}
+		genericMicroseconds += Sys_Microseconds() - start;
+
+		start = Sys_Microseconds();
+		for ( int j = 0; j < iterations; j++ ) {
+			SIMDProcessor->TransformVertsAndTangents( simdVerts.Ptr(), numVerts, deform->verts, skinJoints.Ptr() );
+		}
+		simdMicroseconds += Sys_Microseconds() - start;
+
+		for ( int j = 0; j < numVerts; j++ ) {
+			if ( memcmp( &genericVerts[j], &simdVerts[j], sizeof( idDrawVert ) ) != 0 ) {
+				mismatches++;
+			}
+		}
+		totalVerts += numVerts;
+	}
+
+	common->Printf( "%s: %d meshes, %d verts, %d iterations\n", Name(), meshes.Num(), totalVerts, iterations );
+	common->Printf( "  generic: %6d usec\n", (int)genericMicroseconds );
+	common->Printf( "  %s: %6d usec (%.2fx)\n", SIMDProcessor->GetName(), (int)simdMicroseconds,
+		simdMicroseconds > 0 ? (float)genericMicroseconds / (float)simdMicroseconds : 0.0f );
+	if ( mismatches != 0 ) {
+		common->Printf( S_COLOR_RED "  %d verts differ from the generic code\n", mismatches );
+	}
+}
@@ -504,7 +504,7 @@ void R_AddLights() {
 	// Add jobs to setup pre-light shadow volumes.
 	//-------------------------------------------------
 
-	if ( r_useParallelAddShadows.GetInteger() == 1 ) {
+	if ( r_useParallelAddShadows.GetInteger() > 0 ) {
 		for ( viewLight_t * vLight = tr.viewDef->viewLights; vLight != NULL; vLight = vLight->next ) {
 			for ( preLightShadowVolumeParms_t * shadowParms = vLight->preLightShadowVolumes; shadowParms != NULL; shadowParms = shadowParms->next ) {
 				tr.frontEndJobList->AddJob( (jobRun_t)PreLightShadowVolumeJob, shadowParms );
@@ -35,7 +35,7 @@ If you have questions concerning this license or the applicable additional terms
 idCVar r_skipStaticShadows( "r_skipStaticShadows", "0", CVAR_RENDERER | CVAR_BOOL, "skip static shadows" );
 idCVar r_skipDynamicShadows( "r_skipDynamicShadows", "0", CVAR_RENDERER | CVAR_BOOL, "skip dynamic shadows" );
 idCVar r_useParallelAddModels( "r_useParallelAddModels", "1", CVAR_RENDERER | CVAR_BOOL, "add all models in parallel with jobs" );
-idCVar r_useParallelAddShadows( "r_useParallelAddShadows", "1", CVAR_RENDERER | CVAR_INTEGER, "0 = off, 1 = threaded", 0, 1 );
+idCVar r_useParallelAddShadows( "r_useParallelAddShadows", "1", CVAR_RENDERER | CVAR_INTEGER, "0 = off, 1 = threaded, 2 = threaded as child jobs of the model jobs", 0, 2 );
 idCVar r_useShadowPreciseInsideTest( "r_useShadowPreciseInsideTest", "1", CVAR_RENDERER | CVAR_BOOL, "use a precise and more expensive test to determine whether the view is inside a shadow volume" );
 idCVar r_cullDynamicShadowTriangles( "r_cullDynamicShadowTriangles", "1", CVAR_RENDERER | CVAR_BOOL, "cull occluder triangles that are outside the light frustum so they do not contribute to the dynamic shadow volume" );
 idCVar r_cullDynamicLightTriangles( "r_cullDynamicLightTriangles", "1", CVAR_RENDERER | CVAR_BOOL, "cull surface triangles that are outside the light frustum so they do not get rendered for interactions" );
@@ -991,6 +991,74 @@ void R_LinkDrawSurfToView( drawSurf_t * drawSurf, viewDef_t * viewDef ) {
 	viewDef->numDrawSurfs++;
 }
 
+/*
+===================
+R_LinkModelsToView
+
+Moves the draw surfs of all view entities to the view and the light link chains.
+===================
+*/
+static void R_LinkModelsToView( viewDef_t * viewDef ) {
+	viewDef->numDrawSurfs = 0;	// clear the ambient surface list
+	viewDef->maxDrawSurfs = 0;	// will be set to INITIAL_DRAWSURFS on R_LinkDrawSurfToView
+
+	for ( viewEntity_t * vEntity = viewDef->viewEntitys; vEntity != NULL; vEntity = vEntity->next ) {
+		for ( drawSurf_t * ds = vEntity->drawSurfs; ds != NULL; ) {
+			drawSurf_t * next = ds->nextOnLight;
+			if ( ds->linkChain == NULL ) {
+				R_LinkDrawSurfToView( ds, viewDef );
+			} else {
+				ds->nextOnLight = *ds->linkChain;
+				*ds->linkChain = ds;
+			}
+			ds = next;
+		}
+		vEntity->drawSurfs = NULL;
+	}
+}
+
+REGISTER_PARALLEL_JOB( R_LinkModelsToView, "R_LinkModelsToView" );
+
+/*
+===================
+R_AddSingleModelAndShadows
+
+Adds the model and kicks off the shadow volume jobs of the entity as child jobs
+so they can start while other models are still being added.
+===================
+*/
+static void R_AddSingleModelAndShadows( viewEntity_t * vEntity ) {
+	R_AddSingleModel( vEntity );
+
+	for ( staticShadowVolumeParms_t * shadowParms = vEntity->staticShadowVolumes; shadowParms != NULL; shadowParms = shadowParms->next ) {
+		tr.frontEndJobList->AddChildJob( (jobRun_t)StaticShadowVolumeJob, shadowParms );
+	}
+	for ( dynamicShadowVolumeParms_t * shadowParms = vEntity->dynamicShadowVolumes; shadowParms != NULL; shadowParms = shadowParms->next ) {
+		tr.frontEndJobList->AddChildJob( (jobRun_t)DynamicShadowVolumeJob, shadowParms );
+	}
+	vEntity->staticShadowVolumes = NULL;
+	vEntity->dynamicShadowVolumes = NULL;
+}
+
+REGISTER_PARALLEL_JOB( R_AddSingleModelAndShadows, "R_AddSingleModelAndShadows" );
+
+/*
+===================
+R_AddModelsAndShadows
+
+Root of the model -> shadow volume -> link to view job graph. The link to the
+view runs as a continuation once all models and shadow volumes are done.
+===================
+*/
+static void R_AddModelsAndShadows( viewDef_t * viewDef ) {
+	for ( viewEntity_t * vEntity = viewDef->viewEntitys; vEntity != NULL; vEntity = vEntity->next ) {
+		tr.frontEndJobList->AddChildJob( (jobRun_t)R_AddSingleModelAndShadows, vEntity );
+	}
+	tr.frontEndJobList->AddContinuation( (jobRun_t)R_LinkModelsToView, viewDef );
+}
+
+REGISTER_PARALLEL_JOB( R_AddModelsAndShadows, "R_AddModelsAndShadows" );
+
 /*
 ===================
 R_AddModels
@@ -1005,6 +1073,19 @@ void R_AddModels() {
 
 	tr.viewDef->viewEntitys = R_SortViewEntities( tr.viewDef->viewEntitys );
 
+	//-------------------------------------------------
+	// Run the models, shadow volumes and linking as a single job graph
+	// so the host doesn't have to wait in between.
+	//-------------------------------------------------
+
+	if ( r_useParallelAddModels.GetBool() && r_useParallelAddShadows.GetInteger() == 2 ) {
+		tr.frontEndJobList->AddJob( (jobRun_t)R_AddModelsAndShadows, tr.viewDef );
+		tr.frontEndJobList->Submit();
+		// wait here otherwise the shadow volume index buffer may be unmapped before all shadow volumes have been constructed
+		tr.frontEndJobList->Wait();
+		return;
+	}
+
 	//-------------------------------------------------
 	// Go through each view entity that is either visible to the view, or to
 	// any light that intersects the view (for shadows).
@@ -1026,7 +1107,7 @@ void R_AddModels() {
 	// Kick off jobs to setup static and dynamic shadow volumes.
 	//-------------------------------------------------
 
-	if ( r_useParallelAddShadows.GetInteger() == 1 ) {
+	if ( r_useParallelAddShadows.GetInteger() > 0 ) {
 		for ( viewEntity_t * vEntity = tr.viewDef->viewEntitys; vEntity != NULL; vEntity = vEntity->next ) {
 			for ( staticShadowVolumeParms_t * shadowParms = vEntity->staticShadowVolumes; shadowParms != NULL; shadowParms = shadowParms->next ) {
 				tr.frontEndJobList->AddJob( (jobRun_t)StaticShadowVolumeJob, shadowParms );
@@ -1062,20 +1143,5 @@ void R_AddModels() {
 	// Move the draw surfs to the view.
 	//-------------------------------------------------
 
-	tr.viewDef->numDrawSurfs = 0;	// clear the ambient surface list
-	tr.viewDef->maxDrawSurfs = 0;	// will be set to INITIAL_DRAWSURFS on R_LinkDrawSurfToView
-
-	for ( viewEntity_t * vEntity = tr.viewDef->viewEntitys; vEntity != NULL; vEntity = vEntity->next ) {
-		for ( drawSurf_t * ds = vEntity->drawSurfs; ds != NULL; ) {
-			drawSurf_t * next = ds->nextOnLight;
-			if ( ds->linkChain == NULL ) {
-				R_LinkDrawSurfToView( ds, tr.viewDef );
-			} else {
-				ds->nextOnLight = *ds->linkChain;
-				*ds->linkChain = ds;
-			}
-			ds = next;
-		}
-		vEntity->drawSurfs = NULL;
-	}
+	R_LinkModelsToView( tr.viewDef );
 }
@@ -42,17 +42,132 @@ FRAME MEMORY ALLOCATION
 static const unsigned int NUM_FRAME_DATA = 2;
 static const unsigned int FRAME_ALLOC_ALIGNMENT = 128;
 static const unsigned int MAX_FRAME_MEMORY = 64 * 1024 * 1024;	// larger so that we can noclip on PC for dev purposes
+static const unsigned int MAX_FRAME_MEMORY_LIMIT = 512 * 1024 * 1024;	// the frame memory grows up to this size when a frame overflows
+static const unsigned int FRAME_MEMORY_GROWTH = 16 * 1024 * 1024;
+static const int FRAME_ALLOC_CHUNK_SIZE = 64 * 1024;					// carved out of the frame memory by each thread with one atomic add
+static const int FRAME_ALLOC_DIRECT_SIZE = FRAME_ALLOC_CHUNK_SIZE / 4;	// larger allocations go straight to the frame memory
+static const int MAX_FRAME_ALLOC_ARENAS = 32;
 
 idFrameData		smpFrameData[NUM_FRAME_DATA];
 idFrameData *	frameData;
 unsigned int	smpFrame;
 
-//#define TRACK_FRAME_ALLOCS
+static unsigned int frameMemoryTargetSize = MAX_FRAME_MEMORY;
 
-#if defined( TRACK_FRAME_ALLOCS )
-idSysInterlockedInteger frameAllocTypeCount[FRAME_ALLOC_MAX];
-int frameHighWaterTypeCount[FRAME_ALLOC_MAX];
-#endif
+/*
+================================================
+Each thread that allocates frame memory bumps through its own chunk, so the
+front end jobs don't all hit the frameMemoryAllocated cache line.  The arena
+is reset lazily the first time it's used in a new frame.
+================================================
+*/
+struct frameAllocArena_t {
+	unsigned int	frameCount;			// smpFrame this arena was last used in
+	byte *			current;
+	byte *			end;
+	int				numChunks;
+	int				typeBytes[FRAME_ALLOC_MAX];
+};
+
+union frameAllocArenaSlot_t {
+	frameAllocArena_t	arena;
+	byte				pad[CACHE_LINE_SIZE];	// keep every arena on its own cache line
+};
+compile_time_assert( sizeof( frameAllocArena_t ) <= CACHE_LINE_SIZE );
+
+static ALIGNTYPE128 frameAllocArenaSlot_t	frameAllocArenas[MAX_FRAME_ALLOC_ARENAS];
+static idSysInterlockedInteger				numFrameAllocArenas;
+static ID_TLS								frameAllocArenaIndex;	// arena + 1, or -1 when the arenas ran out
+static idSysInterlockedInteger				frameAllocSharedTypeBytes[FRAME_ALLOC_MAX];	// threads without an arena
+
+static int		frameAllocTypeBytes[FRAME_ALLOC_MAX];		// last completed frame
+static int		frameHighWaterTypeBytes[FRAME_ALLOC_MAX];
+
+static const char * frameAllocTypeNames[] = {
+	"viewDef",
+	"viewEntity",
+	"viewLight",
+	"surfaceTriangles",
+	"drawSurface",
+	"interactionState",
+	"shadowOnlyEntity",
+	"shadowVolumeParms",
+	"shaderRegister",
+	"drawSurfacePointer",
+	"drawCommand",
+	"unknown"
+};
+compile_time_assert( sizeof( frameAllocTypeNames ) / sizeof( frameAllocTypeNames[0] ) == FRAME_ALLOC_MAX );
+
+/*
+====================
+R_GetFrameAllocArena
+====================
+*/
+static frameAllocArena_t * R_GetFrameAllocArena() {
+	ptrdiff_t index = frameAllocArenaIndex;
+	if ( index == 0 ) {
+		index = numFrameAllocArenas.Increment();
+		if ( index > MAX_FRAME_ALLOC_ARENAS ) {
+			index = -1;
+		}
+		frameAllocArenaIndex = index;
+	}
+	if ( index < 0 ) {
+		return NULL;
+	}
+
+	frameAllocArena_t * arena = &frameAllocArenas[index - 1].arena;
+	if ( arena->frameCount != smpFrame ) {
+		arena->frameCount = smpFrame;
+		arena->current = NULL;
+		arena->end = NULL;
+		arena->numChunks = 0;
+		memset( arena->typeBytes, 0, sizeof( arena->typeBytes ) );
+	}
+	return arena;
+}
+
+/*
+====================
+R_GatherFrameAllocs
+
+Only valid while no other thread is allocating.
+====================
+*/
+static int R_GatherFrameAllocs( int typeBytes[FRAME_ALLOC_MAX] ) {
+	for ( int i = 0; i < FRAME_ALLOC_MAX; i++ ) {
+		typeBytes[i] = frameAllocSharedTypeBytes[i].GetValue();
+	}
+	const int numArenas = Min( numFrameAllocArenas.GetValue(), MAX_FRAME_ALLOC_ARENAS );
+	for ( int j = 0; j < numArenas; j++ ) {
+		const frameAllocArena_t & arena = frameAllocArenas[j].arena;
+		if ( arena.frameCount != smpFrame ) {
+			continue;
+		}
+		for ( int i = 0; i < FRAME_ALLOC_MAX; i++ ) {
+			typeBytes[i] += arena.typeBytes[i];
+		}
+	}
+	int total = 0;
+	for ( int i = 0; i < FRAME_ALLOC_MAX; i++ ) {
+		total += typeBytes[i];
+	}
+	return total;
+}
+
+/*
+====================
+R_FreeFrameOverflow
+====================
+*/
+static void R_FreeFrameOverflow( idFrameData * data ) {
+	for ( int i = 0; i < data->overflowBlocks.Num(); i++ ) {
+		Mem_Free16( data->overflowBlocks[i] );
+	}
+	data->overflowBlocks.Clear();
+	data->overflowBytes = 0;
+}
 
 /*
 ====================
@@ -60,32 +175,47 @@ R_ToggleSmpFrame
 ====================
 */
 void R_ToggleSmpFrame() {
+	// gather the allocations of the frame that was just built
+	const int used = R_GatherFrameAllocs( frameAllocTypeBytes );
+	frameData->frameMemoryUsed.SetValue( used );
+	for ( int i = 0; i < FRAME_ALLOC_MAX; i++ ) {
+		frameHighWaterTypeBytes[i] = Max( frameHighWaterTypeBytes[i], frameAllocTypeBytes[i] );
+		frameAllocSharedTypeBytes[i].SetValue( 0 );
+	}
+
 	// update the highwater mark
 	if ( frameData->frameMemoryAllocated.GetValue() > frameData->highWaterAllocated ) {
 		frameData->highWaterAllocated = frameData->frameMemoryAllocated.GetValue();
-#if defined( TRACK_FRAME_ALLOCS )
-		frameData->highWaterUsed = frameData->frameMemoryUsed.GetValue();
-		for ( int i = 0; i < FRAME_ALLOC_MAX; i++ ) {
-			frameHighWaterTypeCount[i] = frameAllocTypeCount[i].GetValue();
+		frameData->highWaterUsed = used;
+	}
+
+	// grow the frame memory if this frame didn't fit
+	if ( frameData->overflowBytes > 0 ) {
+		const unsigned int needed = frameData->frameMemorySize + frameData->overflowBytes;
+		const unsigned int newSize = Min( ( needed + FRAME_MEMORY_GROWTH - 1 ) & ~( FRAME_MEMORY_GROWTH - 1 ), MAX_FRAME_MEMORY_LIMIT );
+		if ( newSize > frameMemoryTargetSize ) {
+			idLib::Warning( "frame memory overflowed by %d kB, growing to %d MB", frameData->overflowBytes >> 10, newSize >> 20 );
+			frameMemoryTargetSize = newSize;
 		}
-#endif
 	}
 
 	// switch to the next frame
 	smpFrame++;
 	frameData = &smpFrameData[smpFrame % NUM_FRAME_DATA];
 
+	// the back end is done with this frame data
+	R_FreeFrameOverflow( frameData );
+	if ( (unsigned int)frameData->frameMemorySize < frameMemoryTargetSize ) {
+		Mem_Free16( frameData->frameMemory );
+		frameData->frameMemory = (byte *) Mem_Alloc16( frameMemoryTargetSize, TAG_RENDER );
+		frameData->frameMemorySize = frameMemoryTargetSize;
+	}
+
 	// reset the memory allocation
 	const unsigned int bytesNeededForAlignment = FRAME_ALLOC_ALIGNMENT - ( (unsigned int)frameData->frameMemory & ( FRAME_ALLOC_ALIGNMENT - 1 ) );
 	frameData->frameMemoryAllocated.SetValue( bytesNeededForAlignment );
 	frameData->frameMemoryUsed.SetValue( 0 );
 
-#if defined( TRACK_FRAME_ALLOCS )
-	for ( int i = 0; i < FRAME_ALLOC_MAX; i++ ) {
-		frameAllocTypeCount[i].SetValue( 0 );
-	}
-#endif
-
 	// clear the command chain and make a RC_NOP command the only thing on the list
 	frameData->cmdHead = frameData->cmdTail = (emptyCommand_t *)R_FrameAlloc( sizeof( *frameData->cmdHead ), FRAME_ALLOC_DRAW_COMMAND );
 	frameData->cmdHead->commandId = RC_NOP;
@@ -100,8 +230,10 @@ R_ShutdownFrameData
 void R_ShutdownFrameData() {
 	frameData = NULL;
 	for ( int i = 0; i < NUM_FRAME_DATA; i++ ) {
+		R_FreeFrameOverflow( &smpFrameData[i] );
 		Mem_Free16( smpFrameData[i].frameMemory );
 		smpFrameData[i].frameMemory = NULL;
+		smpFrameData[i].frameMemorySize = 0;
 	}
 }
 
@@ -114,7 +246,8 @@ void R_InitFrameData() {
 	R_ShutdownFrameData();
 
 	for ( int i = 0; i < NUM_FRAME_DATA; i++ ) {
-		smpFrameData[i].frameMemory = (byte *) Mem_Alloc16( MAX_FRAME_MEMORY, TAG_RENDER );
+		smpFrameData[i].frameMemory = (byte *) Mem_Alloc16( frameMemoryTargetSize, TAG_RENDER );
+		smpFrameData[i].frameMemorySize = frameMemoryTargetSize;
 	}
 
 	// must be set before calling R_ToggleSmpFrame()
@@ -123,6 +256,37 @@ void R_InitFrameData() {
 	R_ToggleSmpFrame();
 }
 
+/*
+====================
+R_FrameAllocOverflow
+
+The frame memory is exhausted, so take a block from the heap instead.
+====================
+*/
+static byte * R_FrameAllocOverflow( int bytes ) {
+	byte * block = (byte *) Mem_Alloc16( bytes + FRAME_ALLOC_ALIGNMENT, TAG_RENDER );
+	{
+		idScopedCriticalSection lock( frameData->overflowMutex );
+		frameData->overflowBlocks.Append( block );
+		frameData->overflowBytes += bytes;
+	}
+	return (byte *)( ( (UINT_PTR)block + FRAME_ALLOC_ALIGNMENT - 1 ) & ~(UINT_PTR)( FRAME_ALLOC_ALIGNMENT - 1 ) );
+}
+
+/*
+====================
+R_FrameAllocShared
+====================
+*/
+static byte * R_FrameAllocShared( int bytes ) {
+	// thread safe add
+	int	end = frameData->frameMemoryAllocated.Add( bytes );
+	if ( end > frameData->frameMemorySize ) {
+		return R_FrameAllocOverflow( bytes );
+	}
+	return frameData->frameMemory + end - bytes;
+}
+
 /*
 ================
 R_FrameAlloc
@@ -140,21 +304,29 @@ All memory is cache-line-cleared for the best performance.
 ================
 */
 void *R_FrameAlloc( int bytes, frameAllocType_t type ) {
-#if defined( TRACK_FRAME_ALLOCS )
-	frameData->frameMemoryUsed.Add( bytes );
-	frameAllocTypeCount[type].Add( bytes );
-#endif
+	frameAllocArena_t * arena = R_GetFrameAllocArena();
+	if ( arena != NULL ) {
+		arena->typeBytes[type] += bytes;
+	} else {
+		frameAllocSharedTypeBytes[type].Add( bytes );
+	}
 
 	bytes = ( bytes + FRAME_ALLOC_ALIGNMENT - 1 ) & ~ ( FRAME_ALLOC_ALIGNMENT - 1 );
 
-	// thread safe add
-	int	end = frameData->frameMemoryAllocated.Add( bytes );
-	if ( end > MAX_FRAME_MEMORY ) {
-		idLib::Error( "R_FrameAlloc ran out of memory. bytes = %d, end = %d, highWaterAllocated = %d\n", bytes, end, frameData->highWaterAllocated );
+	byte * ptr;
+	if ( arena == NULL || bytes > FRAME_ALLOC_DIRECT_SIZE ) {
+		ptr = R_FrameAllocShared( bytes );
+	} else {
+		if ( arena->current + bytes > arena->end ) {
+			// the rest of the old chunk is wasted
+			arena->current = R_FrameAllocShared( FRAME_ALLOC_CHUNK_SIZE );
+			arena->end = arena->current + FRAME_ALLOC_CHUNK_SIZE;
+			arena->numChunks++;
+		}
+		ptr = arena->current;
+		arena->current += bytes;
 	}
 
-	byte * ptr = frameData->frameMemory + end - bytes;
-
 	// cache line clear the memory
 	for ( int offset = 0; offset < bytes; offset += CACHE_LINE_SIZE ) {
 		ZeroCacheLine( ptr, offset );
@@ -163,6 +335,20 @@ void *R_FrameAlloc( int bytes, frameAllocType_t type ) {
 	return ptr;
 }
 
+/*
+====================
+R_ListFrameAllocs_f
+====================
+*/
+void R_ListFrameAllocs_f( const idCmdArgs &args ) {
+	common->Printf( "%-20s %10s %10s\n", "type", "last kB", "peak kB" );
+	for ( int i = 0; i < FRAME_ALLOC_MAX; i++ ) {
+		common->Printf( "%-20s %10d %10d\n", frameAllocTypeNames[i], frameAllocTypeBytes[i] >> 10, frameHighWaterTypeBytes[i] >> 10 );
+	}
+	common->Printf( "%d kB frame memory, %d kB allocated on the peak frame, %d kB of it used\n", frameData->frameMemorySize >> 10, frameData->highWaterAllocated >> 10, frameData->highWaterUsed >> 10 );
+	common->Printf( "%d allocation arenas\n", Min( numFrameAllocArenas.GetValue(), MAX_FRAME_ALLOC_ARENAS ) );
+}
+
 /*
 ==================
 R_ClearedFrameAlloc
@@ -227,22 +413,41 @@ FONT-END RENDERING
 ==========================================================================================
 */
 
+static idCVar r_useParallelSortDrawSurfs( "r_useParallelSortDrawSurfs", "1", CVAR_RENDERER | CVAR_BOOL, "build the draw surface sort keys in parallel with jobs" );
+
+static const int SORT_KEY_BITS			= 48;		// 32 bits sort value and 16 bits depth
+static const int SORT_RADIX_BITS		= 8;
+static const int SORT_RADIX_SIZE		= 1 << SORT_RADIX_BITS;
+static const int SORT_RADIX_PASSES		= SORT_KEY_BITS / SORT_RADIX_BITS;
+static const int SORT_MIN_SURFS_PER_JOB	= 1024;
+static const int SORT_MAX_JOBS			= 16;
+
+struct drawSurfSortKeysParms_t {
+	drawSurf_t **	drawSurfs;
+	uint64 *		keys;
+	int				firstDrawSurf;
+	int				numDrawSurfs;
+	int				histogram[SORT_RADIX_PASSES][SORT_RADIX_SIZE];
+};
+
 /*
 =================
-R_SortDrawSurfs
+R_DrawSurfSortKeys
+
+Builds the sort keys for a range of draw surfs and counts the radix digits of
+the keys. The keys are inverted so an ascending sort orders the draw surfs on:
+1. sort value (largest first)
+2. depth (largest first)
 =================
 */
-static void R_SortDrawSurfs( drawSurf_t ** drawSurfs, const int numDrawSurfs ) {
-#if 1
+static void R_DrawSurfSortKeys( drawSurfSortKeysParms_t * parms ) {
+	memset( parms->histogram, 0, sizeof( parms->histogram ) );
 
-	uint64 * indices = (uint64 *) _alloca16( numDrawSurfs * sizeof( indices[0] ) );
+	drawSurf_t ** drawSurfs = parms->drawSurfs;
+	const int first = parms->firstDrawSurf;
+	const int last = parms->firstDrawSurf + parms->numDrawSurfs;
 
-	// sort the draw surfs based on:
-	// 1. sort value (largest first)
-	// 2. depth (smallest first)
-	// 3. index (largest first)
-	assert( numDrawSurfs <= 0xFFFF );
-	for ( int i = 0; i < numDrawSurfs; i++ ) {
+	for ( int i = first; i < last; i++ ) {
 		float sort = SS_POST_PROCESS - drawSurfs[i]->sort;
 		assert( sort >= 0.0f );
 
@@ -253,61 +458,109 @@ static void R_SortDrawSurfs( drawSurf_t ** drawSurfs, const int numDrawSurfs ) {
 			idRenderMatrix::DepthBoundsForBounds( min, max, drawSurfs[i]->space->mvp, drawSurfs[i]->frontEndGeo->bounds );
 			dist = idMath::Ftoui16( min * 0xFFFF );
 		}
-		
-		indices[i] = ( ( numDrawSurfs - i ) & 0xFFFF ) | ( dist << 16 ) | ( (uint64) ( *(uint32 *)&sort ) << 32 );
-	}
-
-	const int64 MAX_LEVELS = 128;
-	int64 lo[MAX_LEVELS];
-	int64 hi[MAX_LEVELS];
-
-	// Keep the top of the stack in registers to avoid load-hit-stores.
-	register int64 st_lo = 0;
-	register int64 st_hi = numDrawSurfs - 1;
-	register int64 level = 0;
-
-	for ( ; ; ) {
-		register int64 i = st_lo;
-		register int64 j = st_hi;
-		if ( j - i >= 4 && level < MAX_LEVELS - 1 ) {
-			register uint64 pivot = indices[( i + j ) / 2];
-			do {
-				while ( indices[i] > pivot ) i++;
-				while ( indices[j] < pivot ) j--;
-				if ( i > j ) break;
-				uint64 h = indices[i]; indices[i] = indices[j]; indices[j] = h;
-			} while ( ++i <= --j );
-
-			// No need for these iterations because we are always sorting unique values.
-			//while ( indices[j] == pivot && st_lo < j ) j--;
-			//while ( indices[i] == pivot && i < st_hi ) i++;
-
-			assert( level < MAX_LEVELS - 1 );
-			lo[level] = i;
-			hi[level] = st_hi;
-			st_hi = j;
-			level++;
-		} else {
-			for( ; i < j; j-- ) {
-				register int64 m = i;
-				for ( int64 k = i + 1; k <= j; k++ ) {
-					if ( indices[k] < indices[m] ) {
-						m = k;
-					}
-				}
-				uint64 h = indices[m]; indices[m] = indices[j]; indices[j] = h;
+
+		const uint64 key = ~( dist | ( (uint64) ( *(uint32 *)&sort ) << 16 ) ) & ( ( (uint64)1 << SORT_KEY_BITS ) - 1 );
+		parms->keys[i] = key;
+
+		for ( int pass = 0; pass < SORT_RADIX_PASSES; pass++ ) {
+			parms->histogram[pass][( key >> ( pass * SORT_RADIX_BITS ) ) & ( SORT_RADIX_SIZE - 1 )]++;
+		}
+	}
+}
+
+REGISTER_PARALLEL_JOB( R_DrawSurfSortKeys, "R_DrawSurfSortKeys" );
+
+/*
+=================
+R_SortDrawSurfs
+
+LSD radix sort on the draw surf sort keys. The radix sort is stable, so draw
+surfs with equal keys stay in the order they were added.
+=================
+*/
+static void R_SortDrawSurfs( drawSurf_t ** drawSurfs, const int numDrawSurfs ) {
+#if 1
+
+	if ( numDrawSurfs < 2 ) {
+		return;
+	}
+
+	int numJobs = 1;
+	if ( r_useParallelSortDrawSurfs.GetBool() && numDrawSurfs >= 2 * SORT_MIN_SURFS_PER_JOB ) {
+		numJobs = Min( numDrawSurfs / SORT_MIN_SURFS_PER_JOB, SORT_MAX_JOBS );
+	}
+
+	drawSurfSortKeysParms_t * parms = (drawSurfSortKeysParms_t *) _alloca16( numJobs * sizeof( parms[0] ) );
+
+	// double buffered keys and draw surf indices, large lists don't fit on the stack
+	const int scratchBytes = numDrawSurfs * 2 * ( sizeof( uint64 ) + sizeof( int ) );
+	byte * scratch = ( scratchBytes <= 256 * 1024 ) ? (byte *) _alloca16( scratchBytes ) : (byte *) R_FrameAlloc( scratchBytes, FRAME_ALLOC_DRAW_SURFACE_POINTER );
+	uint64 * keys[2] = { (uint64 *) scratch, (uint64 *) scratch + numDrawSurfs };
+	int * surfs[2] = { (int *)( keys[1] + numDrawSurfs ), (int *)( keys[1] + numDrawSurfs ) + numDrawSurfs };
+
+	for ( int i = 0; i < numJobs; i++ ) {
+		parms[i].drawSurfs = drawSurfs;
+		parms[i].keys = keys[0];
+		parms[i].firstDrawSurf = ( numDrawSurfs * i ) / numJobs;
+		parms[i].numDrawSurfs = ( numDrawSurfs * ( i + 1 ) ) / numJobs - parms[i].firstDrawSurf;
+	}
+
+	if ( numJobs > 1 ) {
+		for ( int i = 0; i < numJobs; i++ ) {
+			tr.frontEndJobList->AddJob( (jobRun_t)R_DrawSurfSortKeys, &parms[i] );
+		}
+		tr.frontEndJobList->Submit();
+		tr.frontEndJobList->Wait();
+	} else {
+		R_DrawSurfSortKeys( &parms[0] );
+	}
+
+	for ( int i = 0; i < numDrawSurfs; i++ ) {
+		surfs[0][i] = i;
+	}
+
+	int current = 0;
+	for ( int pass = 0; pass < SORT_RADIX_PASSES; pass++ ) {
+
+		// turn the digit counts into offsets
+		int offsets[SORT_RADIX_SIZE];
+		int total = 0;
+		bool skipPass = false;
+		for ( int digit = 0; digit < SORT_RADIX_SIZE; digit++ ) {
+			int count = 0;
+			for ( int i = 0; i < numJobs; i++ ) {
+				count += parms[i].histogram[pass][digit];
 			}
-			if ( --level < 0 ) {
+			if ( count == numDrawSurfs ) {
+				// all keys have the same digit so this pass would not change the order
+				skipPass = true;
 				break;
 			}
-			st_lo = lo[level];
-			st_hi = hi[level];
+			offsets[digit] = total;
+			total += count;
+		}
+		if ( skipPass ) {
+			continue;
+		}
+
+		const uint64 * srcKeys = keys[current];
+		const int * srcSurfs = surfs[current];
+		uint64 * dstKeys = keys[current ^ 1];
+		int * dstSurfs = surfs[current ^ 1];
+		const int shift = pass * SORT_RADIX_BITS;
+
+		for ( int i = 0; i < numDrawSurfs; i++ ) {
+			const uint64 key = srcKeys[i];
+			const int dst = offsets[( key >> shift ) & ( SORT_RADIX_SIZE - 1 )]++;
+			dstKeys[dst] = key;
+			dstSurfs[dst] = srcSurfs[i];
 		}
+		current ^= 1;
 	}
 
-	drawSurf_t ** newDrawSurfs = (drawSurf_t **) indices;
+	drawSurf_t ** newDrawSurfs = (drawSurf_t **) keys[current ^ 1];
 	for ( int i = 0; i < numDrawSurfs; i++ ) {
-		newDrawSurfs[i] = drawSurfs[numDrawSurfs - ( indices[i] & 0xFFFF )];
+		newDrawSurfs[i] = drawSurfs[surfs[current][i]];
 	}
 	memcpy( drawSurfs, newDrawSurfs, numDrawSurfs * sizeof( drawSurfs[0] ) );
 
@@ -533,10 +533,16 @@ public:
 	idSysInterlockedInteger	frameMemoryAllocated;
 	idSysInterlockedInteger	frameMemoryUsed;
 	byte *					frameMemory;
+	int						frameMemorySize;
 
 	int						highWaterAllocated;	// max used on any frame
 	int						highWaterUsed;
 
+	// heap blocks handed out once frameMemory is exhausted, freed when this frame data is reused
+	idSysMutex				overflowMutex;
+	idList<byte *, TAG_RENDER>	overflowBlocks;
+	int						overflowBytes;
+
 	// the currently building command list commands can be inserted
 	// at the front if needed, as required for dynamically generated textures
 	emptyCommand_t *		cmdHead;	// may be of other command type based on commandId
@@ -551,6 +557,7 @@ void R_AddDrawViewCmd( viewDef_t *parms, bool guiOnly );
 void R_AddDrawPostProcess( viewDef_t *parms );
 
 void R_ReloadGuis_f( const idCmdArgs &args );
+void R_ListFrameAllocs_f( const idCmdArgs &args );
 void R_ListGuis_f( const idCmdArgs &args );
 
 void *R_GetCommandBuffer( int bytes );
@@ -975,6 +982,7 @@ void R_InitOpenGL();
 void R_SetColorMappings();
 
 void R_ScreenShot_f( const idCmdArgs &args );
+void R_TestDXT_f( const idCmdArgs &args );
 void R_StencilShot();
 
 /*
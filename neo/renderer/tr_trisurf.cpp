@@ -914,84 +914,7 @@ void R_DeriveNormalsAndTangents( srfTriangles_t *tri ) {
 	vertexTangents.Zero();
 	vertexBitangents.Zero();
 
-	for ( int i = 0; i < tri->numIndexes; i += 3 ) {
-		const int v0 = tri->indexes[i + 0];
-		const int v1 = tri->indexes[i + 1];
-		const int v2 = tri->indexes[i + 2];
-
-		const idDrawVert * a = tri->verts + v0;
-		const idDrawVert * b = tri->verts + v1;
-		const idDrawVert * c = tri->verts + v2;
-
-		const idVec2 aST = a->GetTexCoord();
-		const idVec2 bST = b->GetTexCoord();
-		const idVec2 cST = c->GetTexCoord();
-
-		float d0[5];
-		d0[0] = b->xyz[0] - a->xyz[0];
-		d0[1] = b->xyz[1] - a->xyz[1];
-		d0[2] = b->xyz[2] - a->xyz[2];
-		d0[3] = bST[0] - aST[0];
-		d0[4] = bST[1] - aST[1];
-
-		float d1[5];
-		d1[0] = c->xyz[0] - a->xyz[0];
-		d1[1] = c->xyz[1] - a->xyz[1];
-		d1[2] = c->xyz[2] - a->xyz[2];
-		d1[3] = cST[0] - aST[0];
-		d1[4] = cST[1] - aST[1];
-
-		idVec3 normal;
-		normal[0] = d1[1] * d0[2] - d1[2] * d0[1];
-		normal[1] = d1[2] * d0[0] - d1[0] * d0[2];
-		normal[2] = d1[0] * d0[1] - d1[1] * d0[0];
-
-		const float f0 = idMath::InvSqrt( normal.x * normal.x + normal.y * normal.y + normal.z * normal.z );
-
-		normal.x *= f0;
-		normal.y *= f0;
-		normal.z *= f0;
-
-		// area sign bit
-		const float area = d0[3] * d1[4] - d0[4] * d1[3];
-		unsigned int signBit = ( *(unsigned int *)&area ) & ( 1 << 31 );
-
-		idVec3 tangent;
-		tangent[0] = d0[0] * d1[4] - d0[4] * d1[0];
-		tangent[1] = d0[1] * d1[4] - d0[4] * d1[1];
-		tangent[2] = d0[2] * d1[4] - d0[4] * d1[2];
-
-		const float f1 = idMath::InvSqrt( tangent.x * tangent.x + tangent.y * tangent.y + tangent.z * tangent.z );
-		*(unsigned int *)&f1 ^= signBit;
-
-		tangent.x *= f1;
-		tangent.y *= f1;
-		tangent.z *= f1;
-
-		idVec3 bitangent;
-		bitangent[0] = d0[3] * d1[0] - d0[0] * d1[3];
-		bitangent[1] = d0[3] * d1[1] - d0[1] * d1[3];
-		bitangent[2] = d0[3] * d1[2] - d0[2] * d1[3];
-
-		const float f2 = idMath::InvSqrt( bitangent.x * bitangent.x + bitangent.y * bitangent.y + bitangent.z * bitangent.z );
-		*(unsigned int *)&f2 ^= signBit;
-
-		bitangent.x *= f2;
-		bitangent.y *= f2;
-		bitangent.z *= f2;
-
-		vertexNormals[v0] += normal;
-		vertexTangents[v0] += tangent;
-		vertexBitangents[v0] += bitangent;
-
-		vertexNormals[v1] += normal;
-		vertexTangents[v1] += tangent;
-		vertexBitangents[v1] += bitangent;
-
-		vertexNormals[v2] += normal;
-		vertexTangents[v2] += tangent;
-		vertexBitangents[v2] += bitangent;
-	}
+	SIMDProcessor->DeriveTriangleTangents( vertexNormals.Ptr(), vertexTangents.Ptr(), vertexBitangents.Ptr(), tri->verts, tri->indexes, tri->numIndexes );
 
 	// add the normal of a duplicated vertex to the normal of the first vertex with the same XYZ
 	for ( int i = 0; i < tri->numDupVerts; i++ ) {
@@ -1006,25 +929,7 @@ void R_DeriveNormalsAndTangents( srfTriangles_t *tri ) {
 	// Project the summed vectors onto the normal plane and normalize.
 	// The tangent vectors will not necessarily be orthogonal to each
 	// other, but they will be orthogonal to the surface normal.
-	for ( int i = 0; i < tri->numVerts; i++ ) {
-		const float normalScale = idMath::InvSqrt( vertexNormals[i].x * vertexNormals[i].x + vertexNormals[i].y * vertexNormals[i].y + vertexNormals[i].z * vertexNormals[i].z );
-		vertexNormals[i].x *= normalScale;
-		vertexNormals[i].y *= normalScale;
-		vertexNormals[i].z *= normalScale;
-
-		vertexTangents[i] -= ( vertexTangents[i] * vertexNormals[i] ) * vertexNormals[i];
-		vertexBitangents[i] -= ( vertexBitangents[i] * vertexNormals[i] ) * vertexNormals[i];
-
-		const float tangentScale = idMath::InvSqrt( vertexTangents[i].x * vertexTangents[i].x + vertexTangents[i].y * vertexTangents[i].y + vertexTangents[i].z * vertexTangents[i].z );
-		vertexTangents[i].x *= tangentScale;
-		vertexTangents[i].y *= tangentScale;
-		vertexTangents[i].z *= tangentScale;
-
-		const float bitangentScale = idMath::InvSqrt( vertexBitangents[i].x * vertexBitangents[i].x + vertexBitangents[i].y * vertexBitangents[i].y + vertexBitangents[i].z * vertexBitangents[i].z );
-		vertexBitangents[i].x *= bitangentScale;
-		vertexBitangents[i].y *= bitangentScale;
-		vertexBitangents[i].z *= bitangentScale;
-	}
+	SIMDProcessor->NormalizeTangents( vertexNormals.Ptr(), vertexTangents.Ptr(), vertexBitangents.Ptr(), tri->numVerts );
 
 	// compress the normals and tangents
 	for ( int i = 0; i < tri->numVerts; i++ ) {
@@ -1040,6 +945,9 @@ R_DeriveUnsmoothedNormalsAndTangents
 ============
 */
 void R_DeriveUnsmoothedNormalsAndTangents( srfTriangles_t * tri ) {
+#ifndef DERIVE_UNSMOOTHED_BITANGENT
+	SIMDProcessor->DeriveUnsmoothedTangents( tri->verts, tri->dominantTris, tri->numVerts );
+#else
 	for ( int i = 0; i < tri->numVerts; i++ ) {
 		float d0, d1, d2, d3, d4;
 		float d5, d6, d7, d8, d9;
@@ -1082,20 +990,15 @@ void R_DeriveUnsmoothedNormalsAndTangents( srfTriangles_t * tri ) {
 		t1 = s0 * ( d1 * d9 - d4 * d6 );
 		t2 = s0 * ( d2 * d9 - d4 * d7 );
 
-#ifndef DERIVE_UNSMOOTHED_BITANGENT
-		t3 = s1 * ( d3 * d5 - d0 * d8 );
-		t4 = s1 * ( d3 * d6 - d1 * d8 );
-		t5 = s1 * ( d3 * d7 - d2 * d8 );
-#else
 		t3 = s1 * ( n2 * t1 - n1 * t2 );
 		t4 = s1 * ( n0 * t2 - n2 * t0 );
 		t5 = s1 * ( n1 * t0 - n0 * t1 );
-#endif
 
 		a->SetNormal( n0, n1, n2 );
 		a->SetTangent( t0, t1, t2 );
 		a->SetBiTangent( t3, t4, t5 );
 	}
+#endif
 }
 
 /*
@@ -1115,21 +1018,7 @@ void R_CreateVertexNormals( srfTriangles_t *tri ) {
 	vertexNormals.Zero();
 
 	assert( tri->silIndexes != NULL );
-	for ( int i = 0; i < tri->numIndexes; i += 3 ) {
-		const int i0 = tri->silIndexes[i + 0];
-		const int i1 = tri->silIndexes[i + 1];
-		const int i2 = tri->silIndexes[i + 2];
-
-		const idDrawVert & v0 = tri->verts[i0];
-		const idDrawVert & v1 = tri->verts[i1];
-		const idDrawVert & v2 = tri->verts[i2];
-
-		const idPlane plane( v0.xyz, v1.xyz, v2.xyz );
-
-		vertexNormals[i0] += plane.Normal();
-		vertexNormals[i1] += plane.Normal();
-		vertexNormals[i2] += plane.Normal();
-	}
+	SIMDProcessor->DeriveTriangleNormals( vertexNormals.Ptr(), tri->verts, tri->silIndexes, tri->numIndexes );
 
 	// replicate from silIndexes to all indexes
 	for ( int i = 0; i < tri->numIndexes; i++ ) {
@@ -488,6 +488,7 @@ void idSoundSystemLocal::Preload( idPreloadManifest & manifest ) {
 
 	idList< preloadSort_t > preloadSort;
 	preloadSort.Resize( manifest.NumResources() );
+	idStrList preloadFiles;
 	for ( int i = 0; i < manifest.NumResources(); i++ ) {
 		const preloadEntry_s & p = manifest.GetPreloadByIndex( i );
 		idResourceCacheEntry rc;
@@ -504,12 +505,15 @@ void idSoundSystemLocal::Preload( idPreloadManifest & manifest ) {
 				ps.idx = i;
 				ps.ofs = rc.offset;
 				preloadSort.Append( ps );
+				preloadFiles.Append( filename.c_str() );
 			}
 		}
 	}
 
 	preloadSort.SortWithTemplate( idSort_Preload() );
 
+	fileSystem->StartPreload( preloadFiles );
+
 	for ( int i = 0; i < preloadSort.Num(); i++ ) {
 		const preloadSort_t & ps = preloadSort[ i ];
 		const preloadEntry_s & p = manifest.GetPreloadByIndex( ps.idx );
@@ -522,6 +526,7 @@ void idSoundSystemLocal::Preload( idPreloadManifest & manifest ) {
 			sample->SetLevelLoadReferenced();
 		}
 	}
+	fileSystem->StopPreload();
 
 	int	end = Sys_Milliseconds();
 	common->Printf( "%05d sounds preloaded in %5.1f seconds\n", numLoaded, ( end - start ) * 0.001 );
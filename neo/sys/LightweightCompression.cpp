@@ -471,6 +471,115 @@ void idZeroRunLengthCompressor::WriteBytes( uint8 * src, int count ) {
 	}
 }
 
+/*
+========================
+idZeroRunLengthCompressor::WriteZeros
+Same output as writing count zero bytes one at a time
+========================
+*/
+bool idZeroRunLengthCompressor::WriteZeros( int count ) {
+	while ( count > 0 ) {
+		if ( zeroCount >= 255 ) {
+			if ( !WriteRun() ) {
+				maxSize = -1;
+				return false;
+			}
+		}
+		int run = Min( count, 255 - zeroCount );
+		zeroCount += run;
+		count -= run;
+	}
+	return true;
+}
+
+/*
+========================
+idZeroRunLengthCompressor::WriteDeltaBytes
+Writes the byte wise difference newData - oldData (or newData itself when oldData is NULL),
+16 bytes at a time so unchanged spans are added to the zero run without touching every byte.
+The output is identical to calling WriteByte for each delta.
+========================
+*/
+void idZeroRunLengthCompressor::WriteDeltaBytes( const uint8 * newData, const uint8 * oldData, int count ) {
+	int i = 0;
+
+#if defined( ID_WIN_X86_SSE2_INTRIN )
+	const __m128i vzero = _mm_setzero_si128();
+	ALIGN16( uint8 delta[16] );
+
+	for ( ; i + 16 <= count && maxSize != -1; i += 16 ) {
+		__m128i d = _mm_loadu_si128( (const __m128i *)( newData + i ) );
+		if ( oldData != NULL ) {
+			d = _mm_sub_epi8( d, _mm_loadu_si128( (const __m128i *)( oldData + i ) ) );
+		}
+		int zeroMask = _mm_movemask_epi8( _mm_cmpeq_epi8( d, vzero ) );
+		if ( zeroMask == 0xFFFF ) {
+			WriteZeros( 16 );
+			continue;
+		}
+		_mm_store_si128( (__m128i *)delta, d );
+		for ( int j = 0; j < 16; j++ ) {
+			WriteByte( delta[j] );
+		}
+	}
+#endif
+
+	for ( ; i < count; i++ ) {
+		WriteByte( oldData != NULL ? (uint8)( newData[i] - oldData[i] ) : newData[i] );
+	}
+}
+
+/*
+========================
+idZeroRunLengthCompressor::ReadDeltaBytes
+Reads count bytes written with WriteDeltaBytes and adds them to base (when not NULL).
+Zero runs are copied from base as a whole instead of byte by byte. Every byte of dest
+is written, even when the stream ends early.
+========================
+*/
+void idZeroRunLengthCompressor::ReadDeltaBytes( uint8 * dest, const uint8 * base, int count ) {
+	int i = 0;
+	while ( i < count ) {
+		if ( zeroCount > 0 ) {
+			int run = Min( zeroCount, count - i );
+			if ( base != NULL ) {
+				memcpy( dest + i, base + i, run );
+			} else {
+				memset( dest + i, 0, run );
+			}
+			zeroCount -= run;
+			i += run;
+			continue;
+		}
+		int value = ReadInternal();
+		if ( value != 0 ) {
+			if ( value == -1 ) {
+				assert( 0 );
+				break;
+			}
+			dest[i] = ( base != NULL ) ? (uint8)( base[i] + value ) : (uint8)value;
+			i++;
+			continue;
+		}
+		// Read the number of zeroes
+		zeroCount = ReadInternal();
+		if ( zeroCount <= 0 ) {
+			assert( 0 );
+			zeroCount = 0;
+			break;
+		}
+	}
+
+	// a truncated or corrupt stream leaves the rest unchanged from base
+	if ( i < count ) {
+		if ( base != NULL ) {
+			memcpy( dest + i, base + i, count - i );
+		} else {
+			memset( dest + i, 0, count - i );
+		}
+	}
+}
+
 int idZeroRunLengthCompressor::End() {
 	WriteRun();
 	if ( maxSize == -1 ) {
@@ -191,6 +191,9 @@ public:
 	byte ReadByte();
 	void ReadBytes( byte * dest, int count );
 	void WriteBytes( uint8 * src, int count );
+	bool WriteZeros( int count );
+	void WriteDeltaBytes( const uint8 * newData, const uint8 * oldData, int count );
+	void ReadDeltaBytes( uint8 * dest, const uint8 * base, int count );
 	int End();
 
 	int CompressedSize() const { return compressed; }
@@ -36,6 +36,16 @@ idCVar net_ssTemplateDebug( "net_ssTemplateDebug", "0", CVAR_BOOL, "Debug snapsh
 idCVar net_ssTemplateDebug_len( "net_ssTemplateDebug_len", "32", CVAR_INTEGER, "Offset to start template state debugging" );
 idCVar net_ssTemplateDebug_start( "net_ssTemplateDebug_start", "0", CVAR_INTEGER, "length of template state to print in debugging" );
 
+idCVar net_ssDeltaSIMD( "net_ssDeltaSIMD", "1", CVAR_BOOL, "Use the vectorized delta + zero-rle encoder for snapshot object states" );
+idCVar net_ssDeltaRecord( "net_ssDeltaRecord", "0", CVAR_INTEGER, "Number of snapshot object states to record for snapDeltaBenchmark" );
+
+// object states recorded while writing snapshots, used by snapDeltaBenchmark
+struct snapDeltaRecord_t {
+	idList< byte >	newData;
+	idList< byte >	oldData;
+};
+static idList< snapDeltaRecord_t > snapDeltaRecords;
+
 /*
 ========================
 InDebugRange
@@ -351,17 +361,21 @@ bool idSnapShot::ReadDeltaForJob( const char * deltaMem, int deltaSize, int visI
 			objectBuffer_t newbuffer( newsize );
 			rleCompressor.Start( NULL, &lzwCompressor, newsize );
 			objectSize_t compareSize = Min( state.buffer.Size(), newsize );
-			for ( objectSize_t i = 0; i < compareSize; i++ ) {
-				byte b = rleCompressor.ReadByte();
-				newbuffer[i] = state.buffer[i] + b;
+			if ( debug ) {
+				for ( objectSize_t i = 0; i < compareSize; i++ ) {
+					byte b = rleCompressor.ReadByte();
+					newbuffer[i] = state.buffer[i] + b;
 
-				if ( debug && InDebugRange( i ) ) {
-					idLib::Printf( "%02X", b );
+					if ( InDebugRange( i ) ) {
+						idLib::Printf( "%02X", b );
+					}
 				}
+			} else if ( compareSize > 0 ) {
+				rleCompressor.ReadDeltaBytes( newbuffer.Ptr(), state.buffer.Ptr(), compareSize );
 			}
 			// Catch leftover
 			if ( newsize > compareSize ) {
-				rleCompressor.ReadBytes( newbuffer.Ptr() + compareSize, newsize - compareSize );
+				rleCompressor.ReadDeltaBytes( newbuffer.Ptr() + compareSize, NULL, newsize - compareSize );
 
 				if ( debug ) {
 					for ( objectSize_t i = compareSize; i < newsize; i++ ) {
@@ -469,6 +483,16 @@ void idSnapShot::SubmitObjectJob(	const submitDeltaJobsInfo_t &	submitDeltaJobsI
 	assert_16_byte_aligned( curObjParm );
 	assert_16_byte_aligned( curObjParm->newState.data );
 	assert_16_byte_aligned( curObjParm->oldState.data );
+
+	if ( newState != NULL && snapDeltaRecords.Num() < net_ssDeltaRecord.GetInteger() ) {
+		snapDeltaRecord_t & record = snapDeltaRecords.Alloc();
+		record.newData.SetNum( newState->buffer.Size() );
+		memcpy( record.newData.Ptr(), newState->buffer.Ptr(), newState->buffer.Size() );
+		if ( oldState != NULL ) {
+			record.oldData.SetNum( oldState->buffer.Size() );
+			memcpy( record.oldData.Ptr(), oldState->buffer.Ptr(), oldState->buffer.Size() );
+		}
+	}
 	
 	SnapshotObjectJob( curObjParm );
 
@@ -1234,6 +1258,103 @@ void idSnapShot::ApplyToExistingState( int objId, idBitMsg & msg ) {
 	}
 }
 
+/*
+========================
+snapDeltaBenchmark
+Times the generic and the vectorized snapshot object encoders over the object states recorded
+with net_ssDeltaRecord, or over generated states when nothing has been recorded.
+========================
+*/
+CONSOLE_COMMAND( snapDeltaBenchmark, "times snapshot object delta + zero-rle encoding, usage: snapDeltaBenchmark [iterations|clear]", 0 ) {
+	if ( args.Argc() > 1 && idStr::Icmp( args.Argv( 1 ), "clear" ) == 0 ) {
+		snapDeltaRecords.Clear();
+		idLib::Printf( "cleared recorded snapshot states\n" );
+		return;
+	}
+
+	int iterations = ( args.Argc() > 1 ) ? Max( atoi( args.Argv( 1 ) ), 1 ) : 100;
+
+	idList< snapDeltaRecord_t > generated;
+	const idList< snapDeltaRecord_t > * records = &snapDeltaRecords;
+	if ( snapDeltaRecords.Num() == 0 ) {
+		idLib::Printf( "no recorded snapshot states (set net_ssDeltaRecord on a server), using generated states\n" );
+		// mostly unchanged states with a few changed bytes, like entities that moved a little
+		idRandom random( 0x51a9 );
+		generated.SetNum( 512 );
+		for ( int i = 0; i < generated.Num(); i++ ) {
+			int size = 16 + random.RandomInt( 497 );
+			generated[i].newData.SetNum( size );
+			generated[i].oldData.SetNum( size - random.RandomInt( 8 ) );
+			for ( int b = 0; b < generated[i].oldData.Num(); b++ ) {
+				generated[i].oldData[b] = ( random.RandomInt( 4 ) == 0 ) ? (byte)random.RandomInt( 256 ) : 0;
+			}
+			for ( int b = 0; b < size; b++ ) {
+				byte old = ( b < generated[i].oldData.Num() ) ? generated[i].oldData[b] : 0;
+				generated[i].newData[b] = ( random.RandomInt( 20 ) == 0 ) ? (byte)random.RandomInt( 256 ) : old;
+			}
+		}
+		records = &generated;
+	}
+
+	int maxSize = 0;
+	int totalBytes = 0;
+	for ( int i = 0; i < records->Num(); i++ ) {
+		maxSize = Max( maxSize, (*records)[i].newData.Num() );
+		totalBytes += (*records)[i].newData.Num();
+	}
+	maxSize = OBJ_DEST_SIZE_ALIGN16( maxSize );
+
+	idList< byte > genericDest, simdDest, decoded;
+	genericDest.SetNum( maxSize );
+	simdDest.SetNum( maxSize );
+	decoded.SetNum( maxSize );
+
+	// check the vectorized encoder produces the same stream and that it decodes
+	int compressedBytes = 0;
+	int mismatches = 0;
+	for ( int i = 0; i < records->Num(); i++ ) {
+		const snapDeltaRecord_t & record = (*records)[i];
+		int genericSize = SnapObjWriteDelta( genericDest.Ptr(), maxSize, record.newData.Ptr(), record.newData.Num(), record.oldData.Ptr(), record.oldData.Num(), false );
+		int simdSize = SnapObjWriteDelta( simdDest.Ptr(), maxSize, record.newData.Ptr(), record.newData.Num(), record.oldData.Ptr(), record.oldData.Num(), true );
+		if ( genericSize != simdSize || ( simdSize > 0 && memcmp( genericDest.Ptr(), simdDest.Ptr(), simdSize ) != 0 ) ) {
+			mismatches++;
+			continue;
+		}
+		if ( simdSize == -1 ) {
+			continue;
+		}
+		compressedBytes += simdSize;
+
+		int compareSize = Min( record.newData.Num(), record.oldData.Num() );
+		idZeroRunLengthCompressor rleCompressor;
+		rleCompressor.Start( simdDest.Ptr(), NULL, simdSize );
+		rleCompressor.ReadDeltaBytes( decoded.Ptr(), record.oldData.Ptr(), compareSize );
+		rleCompressor.ReadDeltaBytes( decoded.Ptr() + compareSize, NULL, record.newData.Num() - compareSize );
+		if ( memcmp( decoded.Ptr(), record.newData.Ptr(), record.newData.Num() ) != 0 ) {
+			mismatches++;
+		}
+	}
+
+	uint64 encodeTime[2];
+	for ( int simd = 0; simd < 2; simd++ ) {
+		byte * dest = simd ? simdDest.Ptr() : genericDest.Ptr();
+		uint64 start = Sys_Microseconds();
+		for ( int n = 0; n < iterations; n++ ) {
+			for ( int i = 0; i < records->Num(); i++ ) {
+				const snapDeltaRecord_t & record = (*records)[i];
+				SnapObjWriteDelta( dest, maxSize, record.newData.Ptr(), record.newData.Num(), record.oldData.Ptr(), record.oldData.Num(), simd != 0 );
+			}
+		}
+		encodeTime[simd] = Sys_Microseconds() - start;
+	}
+
+	const float mb = (float)totalBytes * iterations / ( 1024.0f * 1024.0f );
+	idLib::Printf( "%d object states, %d bytes, %d bytes zero-rle compressed, %d iterations\n", records->Num(), totalBytes, compressedBytes, iterations );
+	idLib::Printf( "generic encode: %6d usec (%.1f MB/s)\n", (int)encodeTime[0], mb / Max( encodeTime[0] * 1e-6f, 1e-6f ) );
+	idLib::Printf( "simd encode:    %6d usec (%.1f MB/s)\n", (int)encodeTime[1], mb / Max( encodeTime[1] * 1e-6f, 1e-6f ) );
+	idLib::Printf( "%s%d mismatches\n", mismatches > 0 ? S_COLOR_RED : "", mismatches );
+}
+
 #if 0
 CONSOLE_COMMAND( serializeQTest, "Serialization Sanity Test", 0 ) {
 
@@ -30,6 +30,8 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "Snapshot_Jobs.h"
 
+extern idCVar net_ssDeltaSIMD;
+
 uint32 SnapObjChecksum( const uint8 * data, int length ) {
 	extern unsigned long CRC32_BlockChecksum( const void *data, int length );
 	return CRC32_BlockChecksum( data, length );
@@ -62,6 +64,37 @@ ID_INLINE bool ObjectsSame( objJobState_t & newState, objJobState_t & oldState )
 	return false;			// Not the same
 }
 
+/*
+========================
+SnapObjWriteDelta
+Zero-rle encodes the delta from oldData to newData followed by the part of newData past oldSize.
+The generic path writes the deltas byte by byte and is kept as the reference for WriteDeltaBytes.
+========================
+*/
+int SnapObjWriteDelta( uint8 * dest, int maxSize, const uint8 * newData, int newSize, const uint8 * oldData, int oldSize, bool simd ) {
+	idZeroRunLengthCompressor rleCompressor;
+	rleCompressor.Start( dest, NULL, maxSize );
+
+	int compareSize = Min( newSize, oldSize );
+	if ( simd ) {
+		rleCompressor.WriteDeltaBytes( newData, oldData, compareSize );
+		rleCompressor.WriteDeltaBytes( newData + compareSize, NULL, newSize - compareSize );
+	} else {
+		for ( int b = 0; b < compareSize; b++ ) {
+			byte delta = newData[b] - oldData[b];
+			rleCompressor.WriteByte( ( 0xFF + 1 + delta ) & 0xFF );
+		}
+		// Get leftover
+		int leftOver = newSize - compareSize;
+
+		if ( leftOver > 0 ) {
+			rleCompressor.WriteBytes( (uint8 *)newData + compareSize, leftOver );
+		}
+	}
+
+	return rleCompressor.End();
+}
+
 /*
 ========================
 SnapshotObjectJob
@@ -93,7 +126,7 @@ void SnapshotObjectJob( objParms_t * parms ) {
 	header->checksum = 0;
 #endif
 
-	idZeroRunLengthCompressor rleCompressor;
+	const bool simd = net_ssDeltaSIMD.GetBool();
 
 	bool visChange		= false; // visibility changes will be signified with a 0xffff state size
 	bool visSendState	= false; // the state is sent when an entity is no longer stale
@@ -149,9 +182,7 @@ void SnapshotObjectJob( objParms_t * parms ) {
 		// New object, write out full state
 		assert( newState.valid );
 		// delta against an empty snap
-		rleCompressor.Start( dataStart, NULL, OBJ_DEST_SIZE_ALIGN16( newState.size ) );
-		rleCompressor.WriteBytes( newState.data, newState.size );
-		header->csize = rleCompressor.End();
+		header->csize = SnapObjWriteDelta( dataStart, OBJ_DEST_SIZE_ALIGN16( newState.size ), newState.data, newState.size, NULL, 0, simd );
 		header->flags |= OBJ_NEW;
 		if ( header->csize == -1 ) {
 			// Not enough space, don't compress, have lzw job do zrle compression instead
@@ -169,19 +200,7 @@ void SnapshotObjectJob( objParms_t * parms ) {
 	
 		if ( !visChange || visSendState ) {			
 			int compareSize = Min( newState.size, oldState.size );
-			rleCompressor.Start( dataStart, NULL, OBJ_DEST_SIZE_ALIGN16( newState.size ) );
-			for ( int b = 0; b < compareSize; b++ ) {
-				byte delta = newState.data[b] - oldState.data[b];
-				rleCompressor.WriteByte( ( 0xFF + 1 + delta ) & 0xFF );
-			}
-			// Get leftover
-			int leftOver = newState.size - compareSize;
-			
-			if ( leftOver > 0 ) {
-				rleCompressor.WriteBytes( newState.data + compareSize, leftOver );
-			}
-			
-			header->csize = rleCompressor.End();			
+			header->csize = SnapObjWriteDelta( dataStart, OBJ_DEST_SIZE_ALIGN16( newState.size ), newState.data, newState.size, oldState.data, oldState.size, simd );
 
 			if ( header->csize == -1 ) {
 				// Not enough space, don't compress, have lzw job do zrle compression instead
@@ -121,6 +121,7 @@ struct ALIGNTYPE16 lzwParm_t {
 	lzwInOutData_t *		ioData;					// In/Out
 };
 
+extern int SnapObjWriteDelta( uint8 * dest, int maxSize, const uint8 * newData, int newSize, const uint8 * oldData, int oldSize, bool simd );
 extern void SnapshotObjectJob( objParms_t * parms );
 extern void LZWJob( lzwParm_t * parm );
 
@@ -535,6 +535,12 @@ typedef HANDLE idFileHandle;
 
 
 ID_TIME_T		Sys_FileTimeStamp( idFileHandle fp );
+
+// read only memory mapping of a whole open file, returns NULL if the file can't be mapped
+const void *	Sys_MapFile( idFileHandle fp, int64 & length );
+void			Sys_UnmapFile( const void * ptr );
+// asks the OS to start paging in a range of a mapped file in the background
+void			Sys_PrefetchMappedMemory( const void * ptr, size_t length );
 // NOTE: do we need to guarantee the same output on all platforms?
 const char *	Sys_TimeStampToStr( ID_TIME_T timeStamp );
 const char *	Sys_SecToStr( int sec );
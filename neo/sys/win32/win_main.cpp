@@ -450,6 +450,73 @@ ID_TIME_T Sys_FileTimeStamp( idFileHandle fp ) {
 	return itime.QuadPart;
 }
 
+/*
+=================
+Sys_MapFile
+=================
+*/
+const void * Sys_MapFile( idFileHandle fp, int64 & length ) {
+	LARGE_INTEGER size;
+	if ( !GetFileSizeEx( fp, &size ) || size.QuadPart == 0 || (uint64)size.QuadPart > (uint64)SIZE_MAX ) {
+		return NULL;
+	}
+	HANDLE mapping = CreateFileMapping( fp, NULL, PAGE_READONLY, 0, 0, NULL );
+	if ( mapping == NULL ) {
+		return NULL;
+	}
+	const void * ptr = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+	// the view keeps the mapping alive
+	CloseHandle( mapping );
+	if ( ptr == NULL ) {
+		return NULL;
+	}
+	length = size.QuadPart;
+	return ptr;
+}
+
+/*
+=================
+Sys_UnmapFile
+=================
+*/
+void Sys_UnmapFile( const void * ptr ) {
+	if ( ptr != NULL ) {
+		UnmapViewOfFile( ptr );
+	}
+}
+
+/*
+=================
+Sys_PrefetchMappedMemory
+
+PrefetchVirtualMemory is only available on Windows 8 and up
+=================
+*/
+struct prefetchMemoryRange_t {
+	void *		virtualAddress;
+	SIZE_T		numberOfBytes;
+};
+typedef BOOL ( WINAPI * PrefetchVirtualMemoryFunc_t )( HANDLE process, ULONG_PTR numEntries, prefetchMemoryRange_t * ranges, ULONG flags );
+
+void Sys_PrefetchMappedMemory( const void * ptr, size_t length ) {
+	static PrefetchVirtualMemoryFunc_t prefetchVirtualMemory = NULL;
+	static bool initialized = false;
+	if ( !initialized ) {
+		HMODULE kernel32 = GetModuleHandle( "kernel32.dll" );
+		if ( kernel32 != NULL ) {
+			prefetchVirtualMemory = (PrefetchVirtualMemoryFunc_t)GetProcAddress( kernel32, "PrefetchVirtualMemory" );
+		}
+		initialized = true;
+	}
+	if ( prefetchVirtualMemory == NULL || ptr == NULL || length == 0 ) {
+		return;
+	}
+	prefetchMemoryRange_t range;
+	range.virtualAddress = const_cast< void * >( ptr );
+	range.numberOfBytes = length;
+	prefetchVirtualMemory( GetCurrentProcess(), 1, &range, 0 );
+}
+
 /*
 ========================
 Sys_Rmdir